@@ -114,6 +114,19 @@ namespace quda
       */
       void destroy();
 
+      /**
+         @brief Whether stridedBatchGEMM maps the input arrays in place
+         and computes the batches in parallel (the default), or copies
+         each batch through dense temporaries on a single thread
+      */
+      bool use_zero_copy_gemm();
+
+      /**
+         @brief Select the stridedBatchGEMM implementation
+         @param[in] zero_copy Whether to use the zero-copy implementation
+      */
+      void set_zero_copy_gemm(bool zero_copy);
+
       /**
          @brief Batch inversion the matrix field using an LU decomposition method.
          @param[out] Ainv Matrix field containing the inverse matrices
@@ -23,6 +23,7 @@ namespace quda
 {
 
   typedef struct MsgHandle_s MsgHandle;
+  typedef struct ReduceHandle_s ReduceHandle;
   typedef struct Topology_s Topology;
 
   char *comm_hostname(void);
@@ -203,6 +204,13 @@ namespace quda
   */
   bool comm_deterministic_reduce();
 
+  /**
+     @brief Set whether multi-process reductions are deterministic,
+     overriding QUDA_DETERMINISTIC_REDUCE
+     @param[in] deterministic Whether reductions are deterministic
+  */
+  void comm_set_deterministic_reduce(bool deterministic);
+
   /**
      @brief Gather all hostnames
      @param[out] hostname_recv_buf char array of length
@@ -398,6 +406,43 @@ namespace quda
   void comm_allreduce_int(int &data);
   void comm_allreduce_xor(uint64_t &data);
 
+  /**
+     @brief Start a non-blocking sum reduction of an array over all
+     processes.  The reduction is completed with comm_iallreduce_wait,
+     and the array must not be accessed until then.  If deterministic
+     reductions are enabled, the result is bitwise identical to that of
+     comm_allreduce_sum.
+     @param[in,out] data The array to be reduced, which holds the result on completion
+     @param[in] size The length of the array
+     @return Handle to the reduction
+  */
+  ReduceHandle *comm_iallreduce_sum_array(double *data, size_t size);
+
+  /**
+     @brief Start a non-blocking max reduction of an array over all
+     processes, see comm_iallreduce_sum_array
+  */
+  ReduceHandle *comm_iallreduce_max_array(double *data, size_t size);
+
+  /**
+     @brief Start a non-blocking min reduction of an array over all
+     processes, see comm_iallreduce_sum_array
+  */
+  ReduceHandle *comm_iallreduce_min_array(double *data, size_t size);
+
+  /**
+     @return Whether the non-blocking reduction has completed
+     @param[in] rh The handle to the reduction
+  */
+  int comm_iallreduce_query(ReduceHandle *rh);
+
+  /**
+     @brief Wait for a non-blocking reduction to complete, leaving the
+     result in the array it was started on, and free its handle
+     @param[in,out] rh The handle to the reduction, which is set to nullptr
+  */
+  void comm_iallreduce_wait(ReduceHandle *&rh);
+
   /**
      @brief Broadcast from the root rank
      @param[in,out] data The data to be read from on the root rank, and
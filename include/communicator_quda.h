@@ -14,6 +14,7 @@
 #include <field_cache.h>
 #include <comm_key.h>
 #include <float_vector.h>
+#include <reproducible_sum.h>
 
 #if defined(MPI_COMMS) || defined(QMP_COMMS)
 #include <mpi.h>
@@ -624,6 +625,8 @@ namespace quda
 
   bool comm_deterministic_reduce() { return use_deterministic_reduce; }
 
+  void comm_set_deterministic_reduce(bool deterministic) { use_deterministic_reduce = deterministic; }
+
   std::stack<bool> globalReduce;
   bool asyncReduce = false;
 
@@ -733,12 +736,6 @@ namespace quda
 
   int comm_query(MsgHandle *mh);
 
-  template <typename T> T deterministic_reduce(T *array, int n)
-  {
-    std::sort(array, array + n); // sort reduction into ascending order for deterministic reduction
-    return std::accumulate(array, array + n, 0.0);
-  }
-
   void comm_allreduce_sum_array(double *data, size_t size);
 
   void comm_allreduce_sum(size_t &a);
@@ -753,6 +750,16 @@ namespace quda
 
   void comm_allreduce_xor(uint64_t &data);
 
+  ReduceHandle *comm_iallreduce_sum_array(double *data, size_t size);
+
+  ReduceHandle *comm_iallreduce_max_array(double *data, size_t size);
+
+  ReduceHandle *comm_iallreduce_min_array(double *data, size_t size);
+
+  int comm_iallreduce_query(ReduceHandle *rh);
+
+  void comm_iallreduce_wait(ReduceHandle *&rh);
+
   /**
      @brief Broadcast from the root rank
      @param[in,out] data The data to be read from on the root rank, and
@@ -15,3 +15,27 @@
 #include <Eigen/LU>
 
 using namespace Eigen;
+
+#include <thread_pool.h>
+
+namespace quda
+{
+
+  /**
+     @brief Evaluate the dense product dst = lhs * rhs on the host in
+     parallel, with the columns of dst split across the host thread
+     pool.  If Eigen is itself multi-threaded (OpenMP) the product is
+     left to Eigen.  dst must not alias lhs or rhs.
+  */
+  template <typename Dst, typename Lhs, typename Rhs> void parallel_product(Dst &&dst, const Lhs &lhs, const Rhs &rhs)
+  {
+#ifdef _OPENMP
+    dst.noalias() = lhs * rhs;
+#else
+    thread_pool::parallel_for(dst.cols(), 0, [&](size_t begin, size_t end) {
+      dst.middleCols(begin, end - begin).noalias() = lhs * rhs.middleCols(begin, end - begin);
+    });
+#endif
+  }
+
+} // namespace quda
@@ -340,6 +340,25 @@ namespace quda
     void sortArrays(QudaEigSpectrumType spec_type, int n, std::vector<Complex> &x, std::vector<int> &y);
   };
 
+  /**
+     @brief Eigensolve the symmetric arrow matrix of the thick
+     restarted Lanczos method by divide and conquer.  The matrix has
+     diagonal a, its first arrow_pos rows are coupled to row
+     arrow_pos, and the remaining rows are tridiagonal.  By default
+     TRLM uses this solver, while setting QUDA_EIG_DENSE_ARROW selects
+     the dense Eigen solver, e.g., for validation.
+     @param[in] a The diagonal, of length n
+     @param[in] b The off-diagonal elements, of length n - 1, where
+     b[i] couples row i to row arrow_pos for i < arrow_pos, and to row
+     i + 1 otherwise
+     @param[in] n The dimension of the matrix
+     @param[in] arrow_pos The position of the arrow
+     @param[out] evals The eigenvalues, in ascending order
+     @param[out] evecs The eigenvectors, stored as the columns of a
+     column-major n x n matrix
+  */
+  void arrowEigensolve(const double *a, const double *b, int n, int arrow_pos, double *evals, double *evecs);
+
   /**
      @brief Thick Restarted Lanczos Method.
   */
@@ -353,6 +372,9 @@ namespace quda
     std::vector<double> alpha = {};
     std::vector<double> beta = {};
 
+    // Whether to eigensolve the arrow matrix with a dense solver, rather than by divide and conquer
+    bool dense_arrow = false;
+
   public:
     /**
        @brief Constructor for Thick Restarted Eigensolver class
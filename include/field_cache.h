@@ -2,7 +2,6 @@
 
 #include <string>
 #include <map>
-#include <stack>
 #include <vector>
 #include <reference_wrapper_helper.h>
 
@@ -38,17 +37,62 @@ namespace quda {
       }
       return false;
     }
+
+    /**
+       @brief Equality operator
+     */
+    bool operator==(const FieldKey<T> &other) const { return volume == other.volume && aux == other.aux; }
+  };
+
+  /**
+     FieldCacheStats holds the counters associated with a field cache.
+     The counters are cumulative over the lifetime of the library, and
+     are not reset by FieldTmp<T>::destroy().
+   */
+  struct FieldCacheStats {
+    size_t hits = 0;            /** requests satisfied by a cached field with a matching key */
+    size_t larger_hits = 0;     /** requests satisfied by aliasing a larger compatible cached field */
+    size_t misses = 0;          /** requests that required a new allocation */
+    size_t evictions = 0;       /** cached fields freed to keep the cache within its budget */
+    size_t fields_held = 0;     /** number of fields presently held by the cache */
+    size_t bytes_held = 0;      /** bytes presently held by the cache */
+    size_t peak_bytes_held = 0; /** maximum bytes held by the cache */
   };
 
   /**
      FieldTmp is a wrapper for a cached field.
+
+     Fields that are returned to the cache are retained for reuse,
+     subject to a memory budget: when returning a field would take the
+     bytes held by the cache beyond the budget, the least recently used
+     cached fields are freed until it fits.  The budget defaults to
+     unlimited, and can be set with the environment variable
+     QUDA_FIELD_CACHE_BUDGET (in MiB) or with set_budget().
+
+     Optionally, a request that has no matching cached field can be
+     satisfied by aliasing a larger compatible cached field (same
+     location and memory type, and no lower precision), provided it is
+     no more than a given factor larger than the field requested.  This
+     is disabled by default, and can be enabled with the environment
+     variable QUDA_FIELD_CACHE_REUSE_LARGER=factor or with
+     set_reuse_larger().
+
+     The cache is safe for concurrent use from multiple host threads.
+     Each thread has a small front cache of recently released fields,
+     which is accessed without contention, backed by a shared cache
+     that is protected by a mutex.  A thread only falls through to the
+     shared cache when its front cache cannot satisfy a request.
      @tparam T The field type
    */
   template <typename T>
   class FieldTmp {
-    static std::map<FieldKey<T>, std::stack<T>> cache; /** Field Cache */
-    T tmp;                                             /** The temporary field instance */
-    FieldKey<T> key;                                   /** Key associated with this instance */
+    struct Cache;          /** Field cache, defined in field_cache.cpp */
+    static Cache &cache(); /** Return the field cache */
+
+    T tmp;                   /** The temporary field instance */
+    FieldKey<T> key;         /** Key associated with this instance */
+    T backing;               /** Larger cached field that tmp aliases, if any */
+    FieldKey<T> backing_key; /** Key associated with the backing field */
 
   public:
     /**
@@ -97,6 +141,30 @@ namespace quda {
 
     /** @brief Flush the cache and frees all temporary allocations */
     static void destroy();
+
+    /**
+       @brief Set the memory budget of the cache, evicting cached
+       fields as needed to satisfy it
+       @param[in] bytes The budget in bytes
+    */
+    static void set_budget(size_t bytes);
+
+    /** @return The memory budget of the cache in bytes */
+    static size_t get_budget();
+
+    /**
+       @brief Set the factor by which a cached field may be larger than
+       a request for it to be aliased to satisfy the request
+       @param[in] factor The maximum size ratio, where a value <= 1
+       disables aliasing larger fields
+    */
+    static void set_reuse_larger(double factor);
+
+    /** @return The counters associated with the cache */
+    static FieldCacheStats get_stats();
+
+    /** @brief Print the counters associated with the cache */
+    static void print_stats();
   };
 
   /**
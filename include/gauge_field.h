@@ -692,6 +692,22 @@ namespace quda {
   void copyGenericGauge(GaugeField &out, const GaugeField &in, QudaFieldLocation location, void *Out = 0, void *In = 0,
                         void **ghostOut = 0, void **ghostIn = 0, int type = 0);
 
+  /**
+     @brief Reorder the body of a host gauge field into another host
+     gauge field using the dedicated host reorder engine.  This
+     supports Nc = 3, non-reconstructed, vector-geometry fields in
+     double or single precision between the QDP, MILC, MILC_SITE,
+     BQCD and TIFR(_PADDED) orders.  The ghost zone is not copied.
+     The engine can be disabled by setting
+     QUDA_ENABLE_HOST_GAUGE_REORDER=0.  Defined in
+     gauge_reorder_host.cpp.
+     @param out The output field to which we are copying
+     @param in The input field from which we are copying
+     @return Whether the copy was performed; if false, the caller
+     should fall back to copyGenericGauge
+  */
+  bool reorderGaugeHost(GaugeField &out, const GaugeField &in);
+
   /**
     @brief This function is used for copying from a source gauge field to a destination gauge field
       with an offset.
@@ -779,6 +795,74 @@ namespace quda {
   */
   uint64_t Checksum(const GaugeField &u, bool mini=false);
 
+  /**
+     @brief Checksums of a gauge field computed separately for each
+     sub-block of the local lattice.  The block checksums are
+     computed in parallel and combined hierarchically (block, rank,
+     global), and since the XOR is order independent the global
+     checksum equals Checksum(u).  Comparing the block checksums of
+     two fields localizes any difference between them to the
+     differing blocks.
+  */
+  struct GaugeChecksum {
+    lat_dim_t X = {};               /** local lattice dimensions */
+    lat_dim_t block = {};           /** sub-block dimensions, where the last block in each dimension may be truncated */
+    lat_dim_t n_block = {};         /** number of sub-blocks in each dimension */
+    std::vector<uint64_t> checksum; /** per sub-block checksum, with the x block index running fastest */
+
+    GaugeChecksum() = default;
+
+    /**
+       @brief Create a set of zeroed block checksums
+       @param[in] X The local lattice dimensions
+       @param[in] block The sub-block dimensions.  A zero extent is
+       replaced with the largest divisor of X that is no more than 8.
+    */
+    GaugeChecksum(const lat_dim_t &X, const lat_dim_t &block);
+
+    /**
+       @return The local lattice coordinates of the origin of block i
+    */
+    lat_dim_t origin(size_t i) const;
+
+    /**
+       @return The checksum of the local lattice, the XOR of all block checksums
+    */
+    uint64_t local() const;
+
+    /**
+       @return The checksum of the global lattice (a collective call)
+    */
+    uint64_t global() const;
+
+    /**
+       @brief Return the indices of the blocks whose checksums differ
+       between this and another set of block checksums, which must
+       have the same blocking
+    */
+    std::vector<size_t> diff(const GaugeChecksum &other) const;
+  };
+
+  /**
+     @brief Compute the checksums of each sub-block of a host gauge
+     field, in any of the orders supported by Checksum
+     @param[in] u The gauge field
+     @param[in] block The sub-block dimensions (see GaugeChecksum)
+     @return The block checksums
+  */
+  GaugeChecksum BlockChecksum(const GaugeField &u, const lat_dim_t &block = {});
+
+  /**
+     @brief Compare the block checksums of two gauge fields, printing
+     the global coordinates of each block that differs.  Every rank
+     prints its own differing blocks, prefixed by its rank, while the
+     total number of differing blocks is reported by rank 0.
+     @param[in] a Block checksums of the first field
+     @param[in] b Block checksums of the second field
+     @return The number of differing blocks on this rank
+  */
+  size_t printChecksumDiff(const GaugeChecksum &a, const GaugeChecksum &b);
+
   /**
      @brief Helper function for determining if the reconstruct of the fields is the same.
      @param[in] a Input field
@@ -931,6 +931,47 @@ namespace quda {
     virtual QudaInverterType getInverterType() const final { return QUDA_CG3NR_INVERTER; }
   };
 
+  /**
+     @brief Pipelined CG, which overlaps the global reduction of each
+     iteration with its matrix-vector product
+   */
+  class PipeCG : public Solver
+  {
+
+  private:
+    ColorSpinorField r;
+    ColorSpinorField y;
+    ColorSpinorField rS;
+    ColorSpinorField xS;
+    ColorSpinorField wS;
+    ColorSpinorField qS;
+    ColorSpinorField zS;
+    ColorSpinorField sS;
+    ColorSpinorField pS;
+    bool init = false;
+
+    /**
+       @brief Initiate the fields needed by the solver
+       @param[in] x Solution vector
+       @param[in] b Source vector
+    */
+    void create(ColorSpinorField &x, const ColorSpinorField &b);
+
+  public:
+    PipeCG(const DiracMatrix &mat, const DiracMatrix &matSloppy, const DiracMatrix &matPrecon, SolverParam &param);
+
+    void operator()(ColorSpinorField &out, ColorSpinorField &in) override;
+
+    /**
+       @return Return the residual vector from the prior solve
+    */
+    ColorSpinorField &get_residual() override;
+
+    virtual bool hermitian() const override { return true; } /** CG is only for Hermitian systems */
+
+    virtual QudaInverterType getInverterType() const override { return QUDA_PIPE_CG_INVERTER; }
+  };
+
   class PreconCG : public Solver {
     private:
     std::shared_ptr<Solver> K;
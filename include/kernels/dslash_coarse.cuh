@@ -357,6 +357,9 @@ namespace quda {
       int s = sM / (Arg::nColor/Mc);
       int color_block = (sM % (Arg::nColor/Mc)) * Mc;
 
+      // on the host both directions are computed by the dir = 0 thread
+      if (target::is_host() && dir) return;
+
       array<complex <typename Arg::real>, Mc> out{ };
 
       if (Arg::dslash) {
@@ -14,14 +14,17 @@ namespace quda {
     int X_global[QUDA_MAX_DIM];
     RNGState *state;
     unsigned long long seed;
-    rngArg(RNGState *state, unsigned long long seed, const LatticeField &meta) :
-      kernel_param(dim3(meta.LocalVolumeCB(), meta.SiteSubset(), 1)),
+    unsigned long long offset;
+    rngArg(RNGState *state, unsigned long long seed, unsigned long long offset, const lat_dim_t &X, size_t volume_cb,
+           int site_subset) :
+      kernel_param(dim3(volume_cb, site_subset, 1)),
       state(state),
-      seed(seed)
+      seed(seed),
+      offset(offset)
     {
       for (int i=0; i<4; i++) {
         commCoord[i] = comm_coord(i);
-        X[i] = meta.LocalX()[i];
+        this->X[i] = X[i];
         X_global[i] = X[i] * comm_dim(i);
       }
     }
@@ -31,7 +34,7 @@ namespace quda {
      @brief functor to initialize the RNG states
      @param state RNG state array
      @param seed initial seed for RNG
-     @param size size of the RNG state array
+     @param offset number of draws to skip in each subsequence
      @param arg Metadata needed for computing multi-gpu offsets
   */
   template <typename Arg>
@@ -42,12 +45,12 @@ namespace quda {
 
     __device__ inline void operator()(int id, int parity)
     {
-      // Each thread gets same seed, a different sequence number, no offset
+      // Each thread gets same seed, a different sequence number, and the same offset
       int x[4];
       getCoords(x, id, arg.X, parity);
       for (int i = 0; i < 4; i++) x[i] += arg.commCoord[i] * arg.X[i];
       int idd = (((x[3] * arg.X_global[2] + x[2]) * arg.X_global[1]) + x[1]) * arg.X_global[0] + x[0];
-      random_init(arg.seed, idd, 0, arg.state[parity * arg.threads.x + id]);
+      random_init(arg.seed, idd, arg.offset, arg.state[parity * arg.threads.x + id]);
     }
   };
 
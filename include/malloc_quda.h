@@ -164,6 +164,11 @@ namespace quda {
     */
     void flush_pinned();
 
+    /**
+       @brief Free all cached pageable host-memory allocations.
+    */
+    void flush_host();
+
   } // namespace pool
 
 }
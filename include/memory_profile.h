@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/**
+   @file memory_profile.h
+
+   @section Description
+
+   Allocation profiling of the tracked memory allocations.  When
+   enabled, with the QUDA_ENABLE_MEMORY_PROFILE environment variable,
+   the live bytes of every allocation type (device, host, pinned,
+   etc.) are aggregated per call site (function, file and line),
+   together with the peak live bytes and the number and total size of
+   the allocations of each site.  A timeline of the total bytes of
+   each type is sampled at an interval set by
+   QUDA_MEMORY_PROFILE_INTERVAL (in seconds, default 0.01); when the
+   timeline is full, every other sample is dropped and the interval
+   doubled.  At each new peak of a type, the call sites of that type
+   with the most live bytes are snapshotted; the snapshot is updated
+   with every new peak, and a new one is started whenever the peak
+   has grown by 10% since the last was started, so the history of the
+   growth of each type is retained.  Allocations served by the device
+   and pinned memory pools are attributed to the site that requested
+   them from the pool, rather than to the site whose request first
+   allocated the block, and the blocks cached by a pool are attributed
+   to a "(pool cached)" pseudo-site of their type.  At endQuda, or when a device
+   allocation fails, each rank writes its profile to
+   memory_profile_rank<N>.json in QUDA_RESOURCE_PATH.
+ */
+
+namespace quda
+{
+
+  namespace memory_profile
+  {
+
+    /**
+       @return Whether allocation profiling is enabled
+    */
+    bool enabled();
+
+    /**
+       @brief Return the id of a call site, registering it if needed
+       @param[in] type Name of the allocation type
+       @param[in] func Function of the call site
+       @param[in] file File of the call site
+       @param[in] line Line of the call site
+       @return The site id
+    */
+    int site(const char *type, const std::string &func, const std::string &file, int line);
+
+    /**
+       @brief Record an allocation
+       @param[in] site The id of the call site
+       @param[in] bytes The size of the allocation
+    */
+    void allocate(int site, size_t bytes);
+
+    /**
+       @brief Record the release of an allocation
+       @param[in] site The id of the call site that made the allocation
+       @param[in] bytes The size of the allocation
+    */
+    void free(int site, size_t bytes);
+
+    /**
+       @brief Record an allocation served by a memory pool.  If the
+       block was cached by the pool, it is moved from the cached
+       pseudo-site of the type to the requesting site.
+       @param[in] type Name of the allocation type
+       @param[in] func Function of the requesting call site
+       @param[in] file File of the requesting call site
+       @param[in] line Line of the requesting call site
+       @param[in] ptr The block
+       @param[in] bytes The size of the block, if newly allocated
+    */
+    void pool_allocate(const char *type, const char *func, const char *file, int line, const void *ptr, size_t bytes);
+
+    /**
+       @brief Record the return of a block to its memory pool, moving
+       it from the requesting site to the cached pseudo-site
+       @param[in] ptr The block
+    */
+    void pool_free(const void *ptr);
+
+    /**
+       @brief Record the release of a cached block by its memory pool
+       @param[in] ptr The block
+    */
+    void pool_trim(const void *ptr);
+
+    /**
+       @brief Write the profile to file.  This is a no-op if profiling
+       is disabled.
+    */
+    void dump();
+
+  } // namespace memory_profile
+
+} // namespace quda
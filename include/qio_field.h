@@ -1,5 +1,8 @@
 #pragma once
 
+#include <functional>
+#include <vector>
+
 #ifdef HAVE_QIO
 void read_gauge_field(const char *filename, void *gauge[], QudaPrecision prec, const int *X,
 		      int argc, char *argv[]);
@@ -9,6 +12,28 @@ void read_spinor_field(const char *filename, void *V[], QudaPrecision precision,
 void write_spinor_field(const char *filename, const void *V[], QudaPrecision precision, const int *X,
                         QudaSiteSubset subset, QudaParity parity, int nColor, int nSpin, int Nvec, int argc,
                         char *argv[], bool partfile = false);
+
+/**
+   @brief Read a set of Nvec vector fields that may be stored as a
+   sequence of records, e.g., as written by the chunked
+   write_spinor_field.  For each record, get_chunk(begin, count)
+   returns the fields to read fields [begin, begin + count) into, and
+   once read chunk_done(begin, count) is called.
+*/
+void read_spinor_field(const char *filename, QudaPrecision precision, const int *X, QudaSiteSubset subset,
+                       QudaParity parity, int nColor, int nSpin, int Nvec,
+                       const std::function<std::vector<void *>(int, int)> &get_chunk,
+                       const std::function<void(int, int)> &chunk_done);
+
+/**
+   @brief Write a set of Nvec vector fields as a sequence of records
+   of at most chunk_size fields each.  For each record,
+   get_chunk(begin, count) returns the fields [begin, begin + count)
+   to be written.
+*/
+void write_spinor_field(const char *filename, QudaPrecision precision, const int *X, QudaSiteSubset subset,
+                        QudaParity parity, int nColor, int nSpin, int Nvec, int chunk_size,
+                        const std::function<std::vector<const void *>(int, int)> &get_chunk, bool partfile = false);
 #else
 inline void read_gauge_field(const char *, void *[], QudaPrecision, const int *, int, char *[])
 {
@@ -32,5 +57,18 @@ inline void write_spinor_field(const char *, const void *[], QudaPrecision, cons
   printf("QIO support has not been enabled\n");
   exit(-1);
 }
+inline void read_spinor_field(const char *, QudaPrecision, const int *, QudaSiteSubset, QudaParity, int, int, int,
+                              const std::function<std::vector<void *>(int, int)> &,
+                              const std::function<void(int, int)> &)
+{
+  printf("QIO support has not been enabled\n");
+  exit(-1);
+}
+inline void write_spinor_field(const char *, QudaPrecision, const int *, QudaSiteSubset, QudaParity, int, int, int,
+                               int, const std::function<std::vector<const void *>(int, int)> &, bool = false)
+{
+  printf("QIO support has not been enabled\n");
+  exit(-1);
+}
 
 #endif
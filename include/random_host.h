@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <enum_quda.h>
+#include <complex_quda.h>
+#include <target_device.h>
+#include <math_helper.cuh>
+#include <mrg32k3a.h>
+
+/**
+   @file random_host.h
+
+   @section Description
+
+   Host regeneration of the RNG streams.  The device state of each
+   site is the subsequence of the MRG32k3a stream given by the global
+   index of the site, advanced by the number of draws consumed so far.
+   The host recreates the state of any site directly from the seed
+   with skip-ahead, so sites can be filled independently across host
+   threads, and the uniform draws are bit-identical to those the
+   device would make.
+ */
+
+namespace quda
+{
+
+  /**
+     @brief Whether noise on host fields should be generated on the
+     host, rather than on the device.  This can be disabled by setting
+     QUDA_ENABLE_HOST_NOISE=0.
+   */
+  inline bool hostNoiseEnabled()
+  {
+#ifdef XORWOW
+    return false; // the host only implements MRG32k3a
+#else
+    static const bool enabled = [] {
+      char *enable_env = getenv("QUDA_ENABLE_HOST_NOISE");
+      return !(enable_env && strcmp(enable_env, "0") == 0);
+    }();
+    return enabled;
+#endif
+  }
+
+  /**
+     Host copy of the RNG state of a single site
+   */
+  struct HostRNGState {
+    target::rng::MRG32k3a state;
+
+    /**
+       @brief Create the state of a given site
+       @param[in] seed The RNG seed
+       @param[in] subsequence The subsequence of the site (RNG::Subsequence)
+       @param[in] offset The number of draws the state has consumed (RNG::HostOffset)
+     */
+    HostRNGState(unsigned long long seed, unsigned long long subsequence, unsigned long long offset)
+    {
+      target::rng::seed(state, seed, subsequence);
+      target::rng::skip(state, offset);
+    }
+
+    /**
+       @brief Return a uniform deviate in (0, 1], with the same
+       rounding as the device uniform<real>::rand
+     */
+    template <typename real> real uniform() { return static_cast<real>(target::rng::uniform(state)); }
+  };
+
+  /**
+     @brief Number of draws consumed by each noise element
+   */
+  constexpr int noise_draws = 2;
+
+  /**
+     @brief Return a complex noise element, consuming the draws in the
+     same order as the genGauss and genUniform device helpers
+     @param[in,out] state The site state
+     @param[in] type The noise type
+   */
+  template <typename real> inline complex<real> hostNoise(HostRNGState &state, QudaNoiseType type)
+  {
+    if (type == QUDA_NOISE_GAUSS) {
+      real phi = 2.0 * state.uniform<real>();
+      real radius = state.uniform<real>();
+      radius = std::sqrt(-std::log(radius));
+      real phi_sin, phi_cos;
+      quda::sincospi(phi, &phi_sin, &phi_cos);
+      return radius * complex<real>(phi_cos, phi_sin);
+    } else {
+      real x = state.uniform<real>();
+      real y = state.uniform<real>();
+      return complex<real>(x, y);
+    }
+  }
+
+} // namespace quda
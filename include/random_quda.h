@@ -10,7 +10,14 @@ namespace quda {
   struct RNGState;
 
   /**
-     @brief Class declaration to initialize and hold RNG states
+     @brief Class declaration to initialize and hold RNG states.  The
+     state of site i is the subsequence Subsequence(i) of the stream
+     defined by the seed.  The device states are only allocated and
+     initialized when they are first needed, so that host fields can
+     be filled without touching the device: while the states have not
+     been handed to a device kernel, every state has consumed the
+     same number of draws, and the host can regenerate any of them
+     with skip-ahead.
   */
   class RNG
   {
@@ -20,10 +27,24 @@ namespace quda {
     RNGState *backup_state;          /*! array for backup of current curand rng state */
     unsigned long long seed;         /*! initial rng seed */
 
+    lat_dim_t X;                      /*! local lattice dimensions of the states */
+    lat_dim_t X_global;               /*! global lattice dimensions of the states */
+    lat_dim_t comm_offset;            /*! global coordinates of the local origin */
+    size_t volume_cb;                 /*! number of states per parity */
+    int site_subset;                  /*! number of parities */
+    bool device_init = false;         /*! whether the device states have been initialized */
+    unsigned long long device_offset; /*! offset at which the device states were initialized */
+    unsigned long long offset = 0;    /*! number of draws consumed by every state, if known */
+    bool offset_known = true;         /*! whether offset is known */
+
+    /*! @brief Allocate and (re)initialize the device states at the current offset */
+    void initDevice();
+
   public:
     /**
        @brief Allocate and initialize RNG states.  Constructor that
-       takes its metadata from pre-existing field
+       takes its metadata from pre-existing field.  The device states
+       are only initialized here if meta is a device field.
        @param[in] meta The field whose data we use
        @param[in] seed Seed to initialize the RNG
     */
@@ -37,7 +58,37 @@ namespace quda {
     /*! @brief Backup rng array states initialization */
     void backup();
 
-    /*! @brief Get pointer to RNGState */
-    RNGState *State() { return state.get(); };
+    /**
+       @brief Get pointer to the device RNGState array.  Since device
+       kernels may consume a varying number of draws per state, the
+       host offset is no longer known after this is called.
+    */
+    RNGState *State();
+
+    /*! @brief Return the number of states */
+    size_t Size() const { return size; }
+
+    /**
+       @brief Return the subsequence of state i, which is the global
+       lexicographic index of its site
+       @param[in] i The state index, parity * volume_cb + x_cb
+    */
+    unsigned long long Subsequence(size_t i) const;
+
+    /**
+       @brief Return the number of draws that every state has consumed
+       @param[out] offset The number of draws
+       @return Whether this is known, i.e., whether the states can be
+       regenerated on the host
+    */
+    bool HostOffset(unsigned long long &offset) const;
+
+    /**
+       @brief Record that every state has consumed a further n draws
+       on the host.  Only valid if HostOffset() returns true, and if
+       all Size() states were drawn from.
+       @param[in] n The number of draws consumed
+    */
+    void Advance(unsigned long long n);
   };
 }
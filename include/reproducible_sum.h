@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+/**
+   @file reproducible_sum.h
+
+   @section Description
+
+   Exact summation of doubles into a fixed-point superaccumulator,
+   used for reproducible multi-process reductions.  Every finite
+   double is an integer multiple of 2^-1074 no larger than 2^1024, so
+   it can be represented exactly by an array of 32-bit digits spanning
+   this range.  Each digit is held in a signed 64-bit limb, so that
+   accumulators can be added limb by limb without propagating carries:
+   since integer addition is associative and commutative, the sum of a
+   set of accumulators is independent of the order in which they are
+   combined, and can be computed with a plain integer MPI_SUM.  Up to
+   2^31 accumulators can be added before a limb could overflow.  The
+   accumulated value is rounded to the nearest double only when it is
+   read back.
+ */
+
+namespace quda
+{
+
+  namespace reproducible
+  {
+
+    constexpr int digit_bits = 32;
+    constexpr int n_digit = 67;     /** 2098 bits for the range of double, plus one digit for carries */
+    constexpr int nan_limb = n_digit;      /** number of NaN values accumulated */
+    constexpr int pos_inf_limb = n_digit + 1; /** number of +infinite values accumulated */
+    constexpr int neg_inf_limb = n_digit + 2; /** number of -infinite values accumulated */
+    constexpr int n_limb = n_digit + 3;
+
+    /**
+       @brief Add a double to an accumulator
+       @param[in,out] acc The accumulator, an array of n_limb limbs
+       @param[in] x The value to be added
+     */
+    inline void accumulate(int64_t *acc, double x)
+    {
+      if (std::isnan(x)) {
+        acc[nan_limb]++;
+        return;
+      }
+      if (std::isinf(x)) {
+        acc[x > 0 ? pos_inf_limb : neg_inf_limb]++;
+        return;
+      }
+
+      uint64_t bits;
+      memcpy(&bits, &x, sizeof(double));
+      const bool negative = bits >> 63;
+      const int exponent = (bits >> 52) & 0x7ff;
+      uint64_t mantissa = bits & ((1ull << 52) - 1);
+      if (exponent) mantissa |= 1ull << 52;
+      if (!mantissa) return;
+
+      // x = mantissa * 2^(offset - 1074), so the mantissa starts at bit offset of the accumulator
+      const int offset = exponent ? exponent - 1 : 0;
+      const int digit = offset / digit_bits;
+      const int shift = offset % digit_bits;
+
+      // the 53-bit mantissa spans at most three digits
+      const uint64_t lo = mantissa << shift;
+      const uint64_t hi = shift ? mantissa >> (64 - shift) : 0;
+      const int64_t d[3] = {static_cast<int64_t>(lo & 0xffffffff), static_cast<int64_t>(lo >> 32),
+                            static_cast<int64_t>(hi)};
+      for (int i = 0; i < 3; i++) acc[digit + i] += negative ? -d[i] : d[i];
+    }
+
+    /**
+       @brief Propagate the carries of an accumulator, so that each
+       digit lies in [0, 2^32)
+       @param[out] digit The normalized digits
+       @param[in] acc The accumulator
+       @param[in] negate Whether to normalize the negation of the accumulator
+       @return The carry out of the top digit, which is negative if the
+       accumulated value is negative
+     */
+    inline int64_t normalize(uint64_t *digit, const int64_t *acc, bool negate)
+    {
+      int64_t carry = 0;
+      for (int i = 0; i < n_digit; i++) {
+        // each limb is bounded by 2^31 * 2^32 in magnitude, so this cannot overflow
+        const int64_t v = (negate ? -acc[i] : acc[i]) + carry;
+        carry = v >> digit_bits; // arithmetic shift, so this rounds towards -infinity
+        digit[i] = static_cast<uint64_t>(v - carry * (int64_t(1) << digit_bits));
+      }
+      return carry;
+    }
+
+    /**
+       @brief Return the value of an accumulator, rounded to the nearest
+       double (ties to even)
+       @param[in] acc The accumulator, an array of n_limb limbs
+       @return The rounded sum
+     */
+    inline double round(const int64_t *acc)
+    {
+      if (acc[nan_limb] || (acc[pos_inf_limb] && acc[neg_inf_limb])) return std::numeric_limits<double>::quiet_NaN();
+      if (acc[pos_inf_limb]) return std::numeric_limits<double>::infinity();
+      if (acc[neg_inf_limb]) return -std::numeric_limits<double>::infinity();
+
+      uint64_t digit[n_digit];
+      bool negative = normalize(digit, acc, false) < 0;
+      if (negative) normalize(digit, acc, true);
+
+      int top = n_digit - 1;
+      while (top >= 0 && !digit[top]) top--;
+      if (top < 0) return 0.0;
+
+      // gather the leading 64 bits of the magnitude, with its leading bit at bit 63
+      auto get = [&](int i) { return i >= 0 ? digit[i] : 0; };
+      const int shift = __builtin_clzll((digit[top] << 32) | get(top - 1));
+      uint64_t mantissa = ((digit[top] << 32) | get(top - 1)) << shift;
+      if (shift) mantissa |= get(top - 2) >> (digit_bits - shift);
+
+      // any bits below these are folded into a sticky bit, so that the conversion rounds correctly
+      bool sticky = shift ? (get(top - 2) << (64 - digit_bits + shift)) != 0 : get(top - 2) != 0;
+      for (int i = top - 3; i >= 0 && !sticky; i--) sticky = digit[i] != 0;
+      mantissa |= sticky;
+
+      const double value = std::ldexp(static_cast<double>(mantissa), digit_bits * (top - 1) - shift - 1074);
+      return negative ? -value : value;
+    }
+
+  } // namespace reproducible
+
+} // namespace quda
@@ -0,0 +1,273 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+   @file size_class_pool.h
+
+   @section Description
+
+   A target-agnostic cache of host allocations, used by both the
+   pageable host-memory pool (safe_malloc) and the page-locked
+   host-memory pool (pool_pinned_malloc).  Requests are rounded up to
+   a size class, so that a freed block can be reused by any later
+   request of the same class.  Each octave of sizes is split into a
+   power-of-two number of sub-classes: the pageable pool uses one
+   class per octave, since pages are only faulted in when first
+   touched and so its padding is virtual unless written to, while
+   the pinned pool uses four, since every byte of a page-locked block
+   is resident.  Cached blocks are held in one arena per NUMA node,
+   given by the node of the thread that made the original allocation
+   (which with first-touch placement is where its pages reside), and
+   requests are preferentially served from the arena of the node of
+   the calling thread.
+ */
+
+namespace quda
+{
+
+  /**
+     @brief Return the NUMA node of the CPU the calling thread is
+     running on, or 0 if this cannot be determined
+  */
+  int numa_node();
+
+  /**
+     @brief Allocate page-aligned pageable host memory.  If
+     QUDA_ENABLE_HOST_HUGE_PAGES=1, allocations of at least a huge
+     page are aligned to the huge-page size and advised to be backed
+     by transparent huge pages.
+     @param[in] bytes Size of the allocation
+     @return Pointer to the allocation, or nullptr on failure
+  */
+  void *host_pages_malloc(size_t bytes);
+
+  /**
+     @brief Cache of host allocations binned by size class, with one
+     arena per NUMA node.  The backing memory is obtained from the
+     allocator passed to allocate, and returned to the backing free
+     function given at construction when blocks are trimmed.  The
+     cache is bounded by a budget, beyond which the largest cached
+     blocks are trimmed when a block is released.  Cached blocks are
+     not released on destruction: the owner must call trim before the
+     backing allocator is torn down.
+  */
+  class SizeClassPool
+  {
+  public:
+    /**
+       Statistics of the pool, with the cumulative quantities counted
+       over the lifetime of the pool
+    */
+    struct Stats {
+      size_t cached_bytes = 0;      /** bytes of the blocks presently cached */
+      size_t cached_blocks = 0;     /** number of blocks presently cached */
+      size_t peak_cached_bytes = 0; /** peak bytes of the cached blocks */
+      size_t active_bytes = 0;      /** size-class bytes of the active allocations */
+      size_t requested_bytes = 0;   /** requested bytes of the active allocations */
+      size_t total_class_bytes = 0; /** cumulative size-class bytes allocated */
+      size_t total_requested_bytes = 0; /** cumulative requested bytes allocated */
+      size_t hits = 0;          /** allocations served from the arena of the calling node */
+      size_t remote_hits = 0;   /** allocations served from the arena of another node */
+      size_t larger_hits = 0;   /** hits served from the next larger size class */
+      size_t misses = 0;        /** allocations that required a new block */
+      size_t trims = 0;         /** cached blocks returned to the backing allocator */
+      size_t trimmed_bytes = 0; /** bytes returned to the backing allocator */
+    };
+
+    using alloc_t = std::function<void *(size_t)>;
+    using free_t = std::function<void(void *)>;
+
+  private:
+    /** Active block metadata */
+    struct Block {
+      int size_class;
+      int node;
+      size_t requested;
+    };
+
+    const std::string name;
+    const int log2_sub;
+    const int n_class;
+    const int min_class;
+    const free_t backing_free;
+    size_t budget = std::numeric_limits<size_t>::max();
+
+    mutable std::mutex mutex;
+
+    /** arena[node][size_class] holds the cached blocks of a given class */
+    std::vector<std::vector<std::vector<void *>>> arena;
+
+    /** active (allocated but not released) blocks */
+    std::unordered_map<void *, Block> active;
+
+    Stats stats_;
+
+    /**
+       @brief Return the smallest size class that holds bytes,
+       irrespective of the smallest class of the pool
+    */
+    int class_of(size_t bytes) const;
+
+    /**
+       @brief Return the size of a size class
+    */
+    size_t class_size(int size_class) const;
+
+    /**
+       @brief Return the size class of a request
+    */
+    int size_class(size_t bytes) const;
+
+    /**
+       @brief Return a cached block of a given class from an arena, or
+       nullptr if there is none
+    */
+    void *take(int node, int size_class);
+
+    /**
+       @brief Return a cached block of a given class, preferring the
+       arena of the given node, or nullptr if there is none
+       @param[in,out] node The preferred node, set to the node of the
+       block returned
+    */
+    void *take_nearest(int &node, int size_class);
+
+    /**
+       @brief Return a cached block to the backing allocator
+    */
+    void free_cached(int node, int size_class);
+
+    /**
+       @brief Trim the cache, with the mutex held
+    */
+    size_t trim_locked(size_t bytes);
+
+  public:
+    /**
+       @brief Create a pool
+       @param[in] name Name of the pool used when printing statistics
+       @param[in] min_bytes Smallest size class (rounded up to a size class)
+       @param[in] sub_classes Number of size classes per octave (a power of two)
+       @param[in] backing_free Function used to release blocks when trimmed
+    */
+    SizeClassPool(const std::string &name, size_t min_bytes, int sub_classes, free_t backing_free);
+
+    SizeClassPool(const SizeClassPool &) = delete;
+    SizeClassPool(SizeClassPool &&) = delete;
+    SizeClassPool &operator=(const SizeClassPool &) = delete;
+    SizeClassPool &operator=(SizeClassPool &&) = delete;
+
+    /**
+       @brief Return the number of bytes a request will occupy
+       @param[in] bytes Size of the request
+       @return Size of the size class of the request
+    */
+    size_t class_bytes(size_t bytes) const { return class_size(size_class(bytes)); }
+
+    /**
+       @brief Set the largest number of bytes the pool may cache,
+       trimming the cache immediately if it holds more
+       @param[in] bytes The budget
+    */
+    void set_budget(size_t bytes);
+
+    /**
+       @return The largest number of bytes the pool may cache
+    */
+    size_t get_budget() const;
+
+    /**
+       @brief Allocate a block.  A cached block of the same size class
+       is reused if present, preferring the arena of the calling node,
+       and otherwise one of the next larger class.  Failing that, a new
+       block is allocated, and if the backing allocation fails the
+       cache is trimmed and the allocation retried.
+       @param[in] bytes Size of the request
+       @param[in] backing_alloc Function used to allocate a new block
+       @return Pointer to the block, or nullptr if the backing
+       allocation failed
+    */
+    void *allocate(size_t bytes, const alloc_t &backing_alloc);
+
+    /**
+       @brief Return a block to the cache.  If the cache then exceeds
+       the budget, the largest cached blocks are trimmed.
+       @param[in] ptr Pointer to the block
+       @return Whether the pointer was allocated from this pool
+    */
+    bool release(void *ptr);
+
+    /**
+       @brief Return cached blocks to the backing allocator, largest first
+       @param[in] bytes The number of bytes to release (default all)
+       @return The number of bytes released
+    */
+    size_t trim(size_t bytes = std::numeric_limits<size_t>::max());
+
+    /**
+       @return The statistics of the pool
+    */
+    Stats stats() const;
+
+    /**
+       @brief Print the statistics of the pool, if it has been used
+    */
+    void print() const;
+  };
+
+  /**
+     @brief Return whether a safe_malloc request is served from the
+     pageable host-memory pool.  The pool is used unless
+     QUDA_ENABLE_HOST_MEMORY_POOL=0, for requests of at least the
+     default mmap threshold of glibc: smaller allocations are recycled
+     by malloc itself, while larger ones are returned to the kernel on
+     free, and so page fault again on every reallocation.
+     @param[in] bytes Size of the request
+  */
+  bool use_host_pool(size_t bytes);
+
+  /**
+     @return The pool of pageable host memory, used by safe_malloc.
+     Its budget in MiB is set with QUDA_HOST_MEMORY_POOL_BUDGET.
+  */
+  SizeClassPool &host_pool();
+
+  /**
+     @return Whether pool_pinned_malloc is served from the pinned pool,
+     disabled with QUDA_ENABLE_PINNED_MEMORY_POOL=0
+  */
+  bool use_pinned_pool();
+
+  /**
+     @return The pool of page-locked host memory, used by
+     pool_pinned_malloc.  Its budget in MiB is set with
+     QUDA_PINNED_MEMORY_POOL_BUDGET.
+  */
+  SizeClassPool &pinned_pool();
+
+  /**
+     @brief Page-lock a block of the pinned pool and track it as a
+     pinned allocation.  Unlike pinned_malloc, a failure is returned
+     rather than raised, so that the pool can trim its cache and
+     retry.  This is implemented by each target.
+     @param[in] ptr Page-aligned block
+     @param[in] bytes Size of the block, a multiple of the page size
+     @return Whether the block was page-locked
+  */
+  bool register_pinned_block_(const char *func, const char *file, int line, void *ptr, size_t bytes);
+
+  /**
+     @brief Stop tracking and unlock a block page-locked with
+     register_pinned_block_.  This is implemented by each target.
+     @param[in] ptr The block
+  */
+  void unregister_pinned_block_(void *ptr);
+
+} // namespace quda
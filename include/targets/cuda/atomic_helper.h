@@ -36,11 +36,20 @@ static inline __device__ double atomicAdd(double *address, double val)
 namespace quda
 {
 
+  /**
+     @brief Host implementation of atomic addition.  This uses a
+     compare-and-swap loop, so it is safe for host kernels executed
+     on the host thread pool, regardless of whether OpenMP is enabled.
+  */
   template <bool is_device> struct atomic_fetch_add_impl {
     template <typename T> inline void operator()(T *addr, T val)
     {
-#pragma omp atomic update
-      *addr += val;
+      T expected;
+      T desired;
+      __atomic_load(addr, &expected, __ATOMIC_RELAXED);
+      do {
+        desired = expected + val;
+      } while (!__atomic_compare_exchange(addr, &expected, &desired, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
     }
   };
 
@@ -78,11 +87,18 @@ namespace quda
     atomic_fetch_add(reinterpret_cast<int *>(addr) + 3, val.w);
   }
 
+  /**
+     @brief Host implementation of atomic max using a compare-and-swap
+     loop (see atomic_fetch_add_impl)
+  */
   template <bool is_device> struct atomic_fetch_abs_max_impl {
     template <typename T> inline void operator()(T *addr, T val)
     {
-#pragma omp atomic update
-      *addr = std::max(*addr, val);
+      T expected;
+      __atomic_load(addr, &expected, __ATOMIC_RELAXED);
+      while (val > expected) {
+        if (__atomic_compare_exchange(addr, &expected, &val, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) break;
+      }
     }
   };
 
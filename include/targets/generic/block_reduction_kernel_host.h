@@ -1,13 +1,35 @@
+#pragma once
+
+#include <thread_pool.h>
+
 namespace quda
 {
 
+  /**
+     @brief Host launcher for block kernels.  Each block of the (x, y,
+     z) grid is executed by a single thread, which performs the work
+     of all of the block's threads, so blocks are independent and are
+     distributed over the host thread pool (see thread_pool.h).  The
+     blocks are enumerated with x the fastest running index, so each
+     thread works on consecutive blocks, and since each block is
+     computed identically regardless of the number of threads, the
+     result is identical to that of serial execution.  As per device
+     execution, blocks whose first y or z thread lies beyond
+     arg.threads are skipped.
+  */
   template <template <typename> class Functor, typename Arg> void BlockKernel2D_host(const Arg &arg)
   {
-    Functor<Arg> t(arg);
-    dim3 block(0, 0, 0);
-    for (block.y = 0; block.y < arg.grid_dim.y; block.y++) {
-      for (block.x = 0; block.x < arg.grid_dim.x; block.x++) { t(block, dim3(0, 0, 0)); }
-    }
+    const size_t nx = arg.grid_dim.x;
+    const size_t ny = arg.grid_dim.y;
+    const size_t nz = arg.grid_dim.z;
+    thread_pool::parallel_for(nx * ny * nz, 1, [&](size_t begin, size_t end) {
+      Functor<Arg> t(arg);
+      for (size_t idx = begin; idx < end; idx++) {
+        dim3 block(idx % nx, (idx / nx) % ny, idx / (nx * ny));
+        if (arg.block_dim.y * block.y >= arg.threads.y || arg.block_dim.z * block.z >= arg.threads.z) continue;
+        t(block, dim3(0, 0, 0));
+      }
+    });
   }
 
 } // namespace quda
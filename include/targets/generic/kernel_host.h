@@ -1,30 +1,55 @@
 #pragma once
 
+#include <thread_pool.h>
+
 namespace quda
 {
 
+  /**
+     @brief Host launcher for 1-d kernels.  The iteration space is
+     split across the host thread pool (see thread_pool.h).  Each
+     index is computed independently, so for kernels that do not
+     accumulate with atomics the result is identical to that of
+     serial execution.
+  */
   template <template <typename> class Functor, typename Arg> void Kernel1D_host(const Arg &arg)
   {
-    Functor<Arg> f(const_cast<Arg &>(arg));
-    for (int i = 0; i < static_cast<int>(arg.threads.x); i++) { f(i); }
+    thread_pool::parallel_for(arg.threads.x, 0, [&](size_t begin, size_t end) {
+      Functor<Arg> f(const_cast<Arg &>(arg));
+      for (int i = begin; i < static_cast<int>(end); i++) { f(i); }
+    });
   }
 
+  /**
+     @brief Host launcher for 2-d kernels.  The flattened (x, y)
+     iteration space is split across the host thread pool, with y the
+     fastest running index as per serial execution.
+  */
   template <template <typename> class Functor, typename Arg> void Kernel2D_host(const Arg &arg)
   {
-    Functor<Arg> f(const_cast<Arg &>(arg));
-    for (int i = 0; i < static_cast<int>(arg.threads.x); i++) {
-      for (int j = 0; j < static_cast<int>(arg.threads.y); j++) { f(i, j); }
-    }
+    const size_t ny = arg.threads.y;
+    thread_pool::parallel_for(arg.threads.x * ny, 0, [&](size_t begin, size_t end) {
+      Functor<Arg> f(const_cast<Arg &>(arg));
+      for (size_t idx = begin; idx < end; idx++) { f(static_cast<int>(idx / ny), static_cast<int>(idx % ny)); }
+    });
   }
 
+  /**
+     @brief Host launcher for 3-d kernels.  The flattened (x, y, z)
+     iteration space is split across the host thread pool, with z the
+     fastest running index as per serial execution.
+  */
   template <template <typename> class Functor, typename Arg> void Kernel3D_host(const Arg &arg)
   {
-    Functor<Arg> f(const_cast<Arg &>(arg));
-    for (int i = 0; i < static_cast<int>(arg.threads.x); i++) {
-      for (int j = 0; j < static_cast<int>(arg.threads.y); j++) {
-        for (int k = 0; k < static_cast<int>(arg.threads.z); k++) { f(i, j, k); }
+    const size_t ny = arg.threads.y;
+    const size_t nz = arg.threads.z;
+    thread_pool::parallel_for(arg.threads.x * ny * nz, 0, [&](size_t begin, size_t end) {
+      Functor<Arg> f(const_cast<Arg &>(arg));
+      for (size_t idx = begin; idx < end; idx++) {
+        size_t yz = idx % (ny * nz);
+        f(static_cast<int>(idx / (ny * nz)), static_cast<int>(yz / nz), static_cast<int>(yz % nz));
       }
-    }
+    });
   }
 
 } // namespace quda
@@ -1,36 +1,105 @@
 #pragma once
 
+#include <algorithm>
 #include <vector>
+#include <thread_pool.h>
 
 namespace quda
 {
 
+  /**
+     @brief The number of x indices over which each partial sum of a
+     host reduction is computed.  The partitioning into partials,
+     and so the shape of the reduction tree, is independent of the
+     number of threads, so the host reductions are reproducible
+     regardless of the size of the thread pool.
+   */
+  constexpr size_t host_reduce_block_size = 4096;
+
+  /**
+     @brief Combine a set of partials using a fixed-shape pairwise
+     tree.  The result is left in partial[0].
+     @param[in,out] partial The partials to be reduced
+     @param[in] r The reducer used to combine two partials
+     @param[in] offset Offset into the partial array
+     @param[in] n The number of partials to combine
+  */
+  template <typename T, typename Reducer>
+  T tree_reduce_host(std::vector<T> &partial, const Reducer &r, size_t offset, size_t n)
+  {
+    for (size_t stride = 1; stride < n; stride *= 2) {
+      for (size_t i = 0; i + stride < n; i += 2 * stride) {
+        partial[offset + i] = r(partial[offset + i], partial[offset + i + stride]);
+      }
+    }
+    return partial[offset];
+  }
+
+  /**
+     @brief Host implementation of the 2-d reduction kernel.  The x
+     dimension is split into blocks of host_reduce_block_size, each
+     block is reduced serially by a thread from the host thread pool
+     to a partial, and the partials are then combined with a
+     fixed-shape tree.  Each block is computed with a private copy of
+     the kernel argument, as per device execution where each thread
+     has its own copy.
+   */
   template <template <typename> class Functor, typename Arg> auto Reduction2D_host(const Arg &arg)
   {
     using reduce_t = typename Functor<Arg>::reduce_t;
     Functor<Arg> t(arg);
 
-    reduce_t value = t.init();
+    const size_t n_block = std::max((arg.threads.x + host_reduce_block_size - 1) / host_reduce_block_size, size_t(1));
+    std::vector<reduce_t> partial(n_block, t.init());
 
-    for (int j = 0; j < static_cast<int>(arg.threads.y); j++) {
-      for (int i = 0; i < static_cast<int>(arg.threads.x); i++) { value = t(value, i, j); }
-    }
+    thread_pool::parallel_for(n_block, 1, [&](size_t begin, size_t) {
+      Arg arg_(arg);
+      Functor<Arg> t(arg_);
+      const int x_begin = begin * host_reduce_block_size;
+      const int x_end = std::min((begin + 1) * host_reduce_block_size, static_cast<size_t>(arg.threads.x));
 
-    return value;
+      reduce_t value = t.init();
+      for (int j = 0; j < static_cast<int>(arg.threads.y); j++) {
+        for (int i = x_begin; i < x_end; i++) { value = t(value, i, j); }
+      }
+      partial[begin] = value;
+    });
+
+    return tree_reduce_host(partial, t, 0, n_block);
   }
 
+  /**
+     @brief Host implementation of the multi-reduction kernel.  Each of
+     the threads.z reductions is partitioned and reduced as per
+     Reduction2D_host, with all (z, block) pairs distributed over the
+     host thread pool.
+   */
   template <template <typename> class Functor, typename Arg> auto MultiReduction_host(const Arg &arg)
   {
     using reduce_t = typename Functor<Arg>::reduce_t;
     Functor<Arg> t(arg);
 
-    std::vector<reduce_t> value(arg.threads.z);
-    for (int k = 0; k < static_cast<int>(arg.threads.z); k++) {
-      value[k] = t.init();
+    const size_t n_block = std::max((arg.threads.x + host_reduce_block_size - 1) / host_reduce_block_size, size_t(1));
+    std::vector<reduce_t> partial(arg.threads.z * n_block, t.init());
 
+    thread_pool::parallel_for(arg.threads.z * n_block, 1, [&](size_t begin, size_t) {
+      Arg arg_(arg);
+      Functor<Arg> t(arg_);
+      const int k = begin / n_block;
+      const size_t block = begin % n_block;
+      const int x_begin = block * host_reduce_block_size;
+      const int x_end = std::min((block + 1) * host_reduce_block_size, static_cast<size_t>(arg.threads.x));
+
+      reduce_t value = t.init();
       for (int j = 0; j < static_cast<int>(arg.threads.y); j++) {
-        for (int i = 0; i < static_cast<int>(arg.threads.x); i++) { value[j] = t(value[j], i, j, k); }
+        for (int i = x_begin; i < x_end; i++) { value = t(value, i, j, k); }
       }
+      partial[begin] = value;
+    });
+
+    std::vector<reduce_t> value(arg.threads.z);
+    for (int k = 0; k < static_cast<int>(arg.threads.z); k++) {
+      value[k] = tree_reduce_host(partial, t, k * n_block, n_block);
     }
 
     return value;
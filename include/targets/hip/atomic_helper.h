@@ -11,11 +11,20 @@
 namespace quda
 {
 
+  /**
+     @brief Host implementation of atomic addition.  This uses a
+     compare-and-swap loop, so it is safe for host kernels executed
+     on the host thread pool, regardless of whether OpenMP is enabled.
+  */
   template <bool is_device> struct atomic_fetch_add_impl {
     template <typename T> inline void operator()(T *addr, T val)
     {
-#pragma omp atomic update
-      *addr += val;
+      T expected;
+      T desired;
+      __atomic_load(addr, &expected, __ATOMIC_RELAXED);
+      do {
+        desired = expected + val;
+      } while (!__atomic_compare_exchange(addr, &expected, &desired, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
     }
   };
 
@@ -45,11 +54,18 @@ namespace quda
     for (int i = 0; i < n; i++) atomic_fetch_add(&(*addr)[i], val[i]);
   }
 
+  /**
+     @brief Host implementation of atomic max using a compare-and-swap
+     loop (see atomic_fetch_add_impl)
+  */
   template <bool is_device> struct atomic_fetch_abs_max_impl {
     template <typename T> inline void operator()(T *addr, T val)
     {
-#pragma omp atomic update
-      *addr = std::max(*addr, val);
+      T expected;
+      __atomic_load(addr, &expected, __ATOMIC_RELAXED);
+      while (val > expected) {
+        if (__atomic_compare_exchange(addr, &expected, &val, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) break;
+      }
     }
   };
 
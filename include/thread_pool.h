@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+/**
+   @file thread_pool.h
+
+   @section Description
+
+   A persistent pool of host worker threads that is used to execute
+   host-location kernels (Kernel1D_host, Reduction2D_host, etc.).  The
+   number of threads is set at runtime with the QUDA_HOST_THREADS
+   environment variable: if unset, or set to 1, all host kernels run
+   serially on the calling thread; if set to a value <= 0, the number
+   of hardware threads is used.
+ */
+
+namespace quda
+{
+
+  namespace thread_pool
+  {
+
+    /**
+       @brief Return the number of threads used by the host thread
+       pool, including the calling thread.  A value of 1 implies
+       serial execution.
+    */
+    int get_num_threads();
+
+    /**
+       @brief Set the number of threads used by the host thread pool.
+       Any existing worker threads are joined and a new set spawned.
+       @param[in] n_threads Number of threads (including the calling
+       thread).  If n_threads <= 0 then the number of hardware threads
+       is used.
+    */
+    void set_num_threads(int n_threads);
+
+    /**
+       @brief Return whether we are presently executing within a
+       parallel region of the thread pool.  Nested calls to
+       parallel_for execute serially on the calling thread.
+    */
+    bool in_parallel();
+
+    /**
+       @brief Execute f over the iteration space [0, n), with the
+       space split into contiguous chunks that are dynamically
+       distributed over the thread pool.  The calling thread takes
+       part in the execution and the call returns once all chunks have
+       completed.
+       @param[in] n The size of the iteration space
+       @param[in] grain The chunk size.  If non-zero, every chunk
+       apart from the last one is exactly grain in size and begins at
+       an integer multiple of grain, independent of the number of
+       threads.  If zero the chunk size is chosen automatically.
+       @param[in] f The function to execute, with signature
+       f(size_t begin, size_t end)
+    */
+    void parallel_for(size_t n, size_t grain, const std::function<void(size_t, size_t)> &f);
+
+  } // namespace thread_pool
+
+} // namespace quda
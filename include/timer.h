@@ -5,6 +5,7 @@
 #include <quda_internal.h>
 #include <util_quda.h>
 #include <device.h>
+#include <trace_profile.h>
 
 namespace quda {
 
@@ -203,6 +204,22 @@ namespace quda {
 
     std::stack<QudaProfileType> pt_stack; /**< A stack used for recursive profiling */
 
+    array<int, QUDA_PROFILE_COUNT> trace_id = {};         /**< Interned trace span name of each timer (zero if unset) */
+    array<uint64_t, QUDA_PROFILE_COUNT> trace_start = {}; /**< Trace start time of each running timer */
+
+    /**
+       @brief Start the timer of type idx, recording the start of a
+       trace span if the timer was not already running
+    */
+    void StartTimer(const char *func, const char *file, int line, QudaProfileType idx);
+
+    /**
+       @brief Stop the timer of type idx, recording a trace span if the
+       timer is no longer running
+       @return Whether the timer was successfully stopped
+    */
+    bool StopTimer(const char *func, const char *file, int line, QudaProfileType idx);
+
     static void StopGlobal(const char *func, const char *file, int line, QudaProfileType idx);
     static void StartGlobal(const char *func, const char *file, int line, QudaProfileType idx);
 
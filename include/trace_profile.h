@@ -0,0 +1,172 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/**
+   @file trace_profile.h
+
+   @section Description
+
+   Low-overhead tracing of the spans timed by TimeProfile.  When
+   enabled, with the QUDA_ENABLE_PROFILE_TRACE environment variable,
+   every interval during which a TimeProfile timer runs is recorded
+   into a per-thread ring buffer, using a monotonic nanosecond clock,
+   and accumulated into a per-span latency histogram.  At endQuda each
+   rank writes its timeline in Chrome trace-event JSON format
+   (trace_rank<N>.json, viewable with Perfetto or chrome://tracing)
+   and its histograms (trace_hist_rank<N>.tsv) to QUDA_RESOURCE_PATH.
+   The size of each ring buffer (in events) can be set with
+   QUDA_PROFILE_TRACE_BUFFER; when full, the oldest events are
+   overwritten, though the histograms remain complete.
+
+   The timestamps of every rank are relative to a common epoch, taken
+   on each rank on leaving a barrier when the communicators are
+   initialized, so the traces of all ranks can be loaded together
+   with their spans aligned.  Since the monotonic clocks of different
+   nodes are unrelated, the wall-clock time of the epoch is also
+   written (as otherData.epoch_wall_ns) for cross-checking against
+   other tools.
+ */
+
+namespace quda
+{
+
+  /**
+     @brief Histogram with logarithmically spaced buckets, where each
+     power of two is split into sub_buckets linear buckets.  Percentiles
+     are thus accurate to within a relative error of 1 / sub_buckets.
+  */
+  class log_histogram
+  {
+    static constexpr int sub_bits = 2;
+    static constexpr int sub_buckets = 1 << sub_bits;
+    static constexpr int n_bucket = 64 * sub_buckets;
+
+    std::array<uint64_t, n_bucket> bucket = {};
+    uint64_t n = 0;
+    uint64_t total = 0;
+    uint64_t max_value = 0;
+
+    static int index(uint64_t value)
+    {
+      if (value < sub_buckets) return value;
+      int log2 = 63 - __builtin_clzll(value);
+      return (log2 - sub_bits + 1) * sub_buckets + ((value >> (log2 - sub_bits)) & (sub_buckets - 1));
+    }
+
+    static uint64_t lower_bound(int i)
+    {
+      if (i < sub_buckets) return i;
+      int log2 = i / sub_buckets + sub_bits - 1;
+      return (uint64_t(sub_buckets + i % sub_buckets)) << (log2 - sub_bits);
+    }
+
+  public:
+    /**
+       @brief Add a value to the histogram
+    */
+    void add(uint64_t value)
+    {
+      bucket[index(value)]++;
+      n++;
+      total += value;
+      if (value > max_value) max_value = value;
+    }
+
+    /**
+       @brief Accumulate another histogram into this one
+    */
+    void merge(const log_histogram &other)
+    {
+      for (int i = 0; i < n_bucket; i++) bucket[i] += other.bucket[i];
+      n += other.n;
+      total += other.total;
+      if (other.max_value > max_value) max_value = other.max_value;
+    }
+
+    uint64_t count() const { return n; }
+    uint64_t sum() const { return total; }
+    uint64_t max() const { return max_value; }
+
+    /**
+       @brief Return the given percentile of the values, taken as the
+       midpoint of the bucket in which it falls
+       @param[in] p Percentile in the range [0, 100]
+    */
+    uint64_t percentile(double p) const
+    {
+      if (n == 0) return 0;
+      uint64_t rank = static_cast<uint64_t>(p / 100.0 * (n - 1)) + 1;
+      uint64_t cumulative = 0;
+      for (int i = 0; i < n_bucket; i++) {
+        cumulative += bucket[i];
+        if (cumulative >= rank) {
+          uint64_t lower = lower_bound(i);
+          uint64_t upper = i + 1 < n_bucket ? lower_bound(i + 1) : max_value + 1;
+          uint64_t mid = lower + (upper - lower) / 2;
+          return mid < max_value ? mid : max_value;
+        }
+      }
+      return max_value;
+    }
+  };
+
+  namespace trace
+  {
+
+    /**
+       @brief Synchronize the trace epoch across all ranks.  This is
+       collective, and is called once the communicators are
+       initialized.
+    */
+    void init();
+
+    /**
+       @brief Return whether tracing is enabled
+    */
+    bool enabled();
+
+    /**
+       @brief Enable or disable tracing, overriding the environment
+    */
+    void set_enabled(bool enable);
+
+    /**
+       @brief Return the present time in nanoseconds from the monotonic clock
+    */
+    inline uint64_t now()
+    {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+    }
+
+    /**
+       @brief Intern a span name, returning an identifier that is used
+       to record spans of that name.  Identifiers are strictly
+       positive.
+    */
+    int intern(const std::string &name);
+
+    /**
+       @brief Record a span into the ring buffer of the calling thread,
+       and accumulate its duration into the histogram for its name
+       @param[in] id The identifier of the span name
+       @param[in] start The start time of the span in nanoseconds
+       @param[in] end The end time of the span in nanoseconds
+    */
+    void record(int id, uint64_t start, uint64_t end);
+
+    /**
+       @brief Write the trace and histograms of this rank to
+       QUDA_RESOURCE_PATH (or the working directory if unset), and
+       reset the trace
+    */
+    void dump();
+
+  } // namespace trace
+
+} // namespace quda
@@ -11,11 +11,15 @@
  */
 
 #include <color_spinor_field.h>
+#include <memory>
 #include <vector>
 #include <reference_wrapper_helper.h>
 
 namespace quda {
 
+  /** Host fine-to-coarse and coarse-to-fine maps, shared between transfer operators with the same geometry */
+  struct GeoMap;
+
   /**
      The transfer class defines the inter-grid operators that connect
      fine and coarse grids.  This implements both restriction and
@@ -61,6 +65,9 @@ namespace quda {
     /** The geometrical coase grid blocking */
     int *geo_bs = nullptr;
 
+    /** The host geometry maps, which may be shared with other transfer operators */
+    std::shared_ptr<const GeoMap> geo_map;
+
     /** The mapping onto coarse sites from fine sites.  This has
 	length equal to the fine-grid volume, and is sorted into
 	lexicographical fine-grid order, with each value corresponding
@@ -134,7 +141,9 @@ namespace quda {
     void createTmp(std::vector<ColorSpinorField> &tmp, QudaFieldLocation new_location, ColorSpinorField &a) const;
 
     /**
-     * @brief Creates the map between fine and coarse grids
+     * @brief Creates the map between fine and coarse grids.  The maps
+     * depend only on the geometry, so are cached and reused by
+     * subsequent transfer operators with the same geometry.
      * @param geo_bs An array storing the block size in each geometric dimension
      */
     void createGeoMap(int *geo_bs);
@@ -265,6 +274,27 @@ namespace quda {
     void setSiteSubset(QudaSiteSubset site_subset, QudaParity parity);
   };
 
+  /**
+     @brief Release every cached geometry map.  Maps still in use by a
+     transfer operator are freed when that operator is destroyed, so
+     the cache holds no pinned allocation past endQuda.
+   */
+  void flushGeoMapCache();
+
+  /**
+     @brief Compute the fine-to-coarse and coarse-to-fine site maps
+     with the host thread pool.  The sites of each aggregate in the
+     coarse-to-fine map are in increasing fine-site order, as from a
+     sort of the (coarse, fine) index pairs.
+     @param[out] fine_to_coarse The coarse site of each fine site
+     @param[out] coarse_to_fine The fine sites ordered by aggregate
+     @param[in] fine Field with the fine geometry
+     @param[in] coarse Field with the coarse geometry
+     @param[in] geo_bs The geometric block size
+   */
+  void computeGeoMap(int *fine_to_coarse, int *coarse_to_fine, const ColorSpinorField &fine,
+                     const ColorSpinorField &coarse, const int *geo_bs);
+
   /**
      @brief Block orthogonnalize the matrix field, where the blocks are
      defined by lookup tables that map the fine grid points to the
@@ -122,7 +122,8 @@ namespace quda
       if (location == QUDA_CUDA_FIELD_LOCATION) {
         launch_device<Functor, Block>(tp, stream, arg);
       } else if constexpr (enable_host) {
-        launch_host<Functor, Block>(tp, arg);
+        LaunchTimer timer(*this);
+        launch_host<Functor, Block>(tp, stream, arg);
       } else {
         errorQuda("CPU not supported yet");
       }
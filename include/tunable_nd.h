@@ -49,6 +49,7 @@ namespace quda
     template <template <typename> class Functor, typename Arg>
     void launch_host(const TuneParam &, const qudaStream_t &, const Arg &arg)
     {
+      LaunchTimer timer(*this);
       Kernel1D_host<Functor, Arg>(arg);
     }
 
@@ -198,6 +199,7 @@ namespace quda
     void launch_host(const TuneParam &, const qudaStream_t &, const Arg &arg)
     {
       const_cast<Arg &>(arg).threads.y = vector_length_y;
+      LaunchTimer timer(*this);
       Kernel2D_host<Functor, Arg>(arg);
     }
 
@@ -441,6 +443,7 @@ namespace quda
     {
       const_cast<Arg &>(arg).threads.y = vector_length_y;
       const_cast<Arg &>(arg).threads.z = vector_length_z;
+      LaunchTimer timer(*this);
       Kernel3D_host<Functor, Arg>(arg);
     }
 
@@ -101,7 +101,10 @@ namespace quda
       if (arg.threads.y != block_size_y)
         errorQuda("Unexected y threads: received %d, expected %d", arg.threads.y, block_size_y);
       std::vector<T> result_(1);
-      result_[0] = Reduction2D_host<Functor, Arg>(arg);
+      {
+        LaunchTimer timer(*this);
+        result_[0] = Reduction2D_host<Functor, Arg>(arg);
+      }
       if (!activeTuning() && commGlobalReduction()) Functor<Arg>::comm_reduce(result_);
       result = result_[0];
     }
@@ -250,7 +253,11 @@ namespace quda
       if (n_batch_block_max > Arg::max_n_batch_block)
         errorQuda("n_batch_block_max = %u greater than maximum supported %u", n_batch_block_max, Arg::max_n_batch_block);
 
-      auto value = MultiReduction_host<Functor, Arg>(arg);
+      std::vector<typename Functor<Arg>::reduce_t> value;
+      {
+        LaunchTimer timer(*this);
+        value = MultiReduction_host<Functor, Arg>(arg);
+      }
       for (int j = 0; j < (int)arg.threads.z; j++) result[j] = value[j];
       if (!activeTuning() && commGlobalReduction()) Functor<Arg>::comm_reduce(result);
     }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <cstring>
 #include <ostream>
 
@@ -41,6 +42,33 @@ namespace quda {
       return false;
     }
 
+    bool operator==(const TuneKey &other) const
+    {
+      return std::strcmp(volume, other.volume) == 0 && std::strcmp(name, other.name) == 0
+        && std::strcmp(aux, other.aux) == 0;
+    }
+
+    /**
+       @brief Return a 64-bit FNV-1a hash of the key, used for the
+       hashed lookup of the tunecache
+    */
+    uint64_t hash() const
+    {
+      uint64_t h = 14695981039346656037ull;
+      auto fnv = [&h](const char *s) {
+        for (; *s; s++) {
+          h ^= static_cast<unsigned char>(*s);
+          h *= 1099511628211ull;
+        }
+        h ^= 0xff; // separator, so that moving characters between fields changes the hash
+        h *= 1099511628211ull;
+      };
+      fnv(volume);
+      fnv(name);
+      fnv(aux);
+      return h;
+    }
+
     friend std::ostream &operator<<(std::ostream &output, const TuneKey &key)
     {
       output << "volume = " << key.volume << ", ";
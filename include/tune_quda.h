@@ -49,6 +49,10 @@ namespace quda {
     static inline uint64_t _flops_global = 0;
     static inline uint64_t _bytes_global = 0;
 
+    friend class LaunchTimer;
+    /** Tunecache entry of the present launch, set by tuneLaunch if launch timing is enabled */
+    std::pair<const TuneKey, TuneParam> *launch_entry = nullptr;
+
   protected:
     virtual long long flops() const { return 0; }
     virtual long long bytes() const { return 0; }
@@ -381,6 +385,17 @@ namespace quda {
   void loadTuneCache();
   void saveTuneCache(bool error = false);
 
+  /**
+   * @brief Convert a tunecache file between the text and binary
+   * formats, preserving the version fields of the header.  The format
+   * of each file is deduced from its extension: ".bin" denotes the
+   * binary format, anything else the text format.  No version check
+   * is applied to the input file.
+   * @param[in] in_path The tunecache file to read
+   * @param[in] out_path The tunecache file to write (overwritten if it exists)
+   */
+  void convertTuneCache(const std::string &in_path, const std::string &out_path);
+
   /**
    * @brief Save profile to disk.
    */
@@ -404,6 +419,64 @@ namespace quda {
    */
   TuneParam tuneLaunch(Tunable &tunable, QudaTune enabled = getTuning(), QudaVerbosity verbosity = getVerbosity());
 
+  /**
+   * @brief Query whether launch timing is enabled, which is set with
+   * the QUDA_ENABLE_LAUNCH_TIMING environment variable.  When enabled,
+   * the measured duration of every launch of a tuned kernel or policy
+   * is accumulated into a log-bucketed histogram for its TuneKey, and
+   * the number of timed launches, their total wall time and their
+   * p50/p90/p99 durations are added to the profile written by
+   * saveProfile.
+   */
+  bool launchTimingEnabled();
+
+  /**
+   * @brief Resolve any pending device launch timings and destroy the
+   * events used to time device launches
+   */
+  void destroyLaunchEvents();
+
+  /**
+     @brief Scoped timer that measures the duration of a launch of a
+     tunable, for which tuneLaunch must have been called, and adds it
+     to the launch histogram of the corresponding TuneKey.  Host
+     launches are timed with the host clock.  Device launches are
+     timed with a pair of events recorded on the launch stream, which
+     are resolved later without synchronizing.  Launches made while
+     tuning are not timed.
+   */
+  class LaunchTimer
+  {
+    std::pair<const TuneKey, TuneParam> *entry = nullptr;
+    bool device = false;
+    qudaStream_t stream = {};
+    uint64_t start = 0;
+    qudaEvent_t start_event = {};
+    qudaEvent_t stop_event = {};
+
+  public:
+    /**
+       @brief Start timing a host launch
+       @param[in] tunable The tunable being launched
+    */
+    LaunchTimer(const Tunable &tunable);
+
+    /**
+       @brief Start timing a device launch
+       @param[in] tunable The tunable being launched
+       @param[in] stream The stream the launch is made on
+    */
+    LaunchTimer(const Tunable &tunable, const qudaStream_t &stream);
+
+    /**
+       @brief Stop timing the launch
+    */
+    ~LaunchTimer();
+
+    LaunchTimer(const LaunchTimer &) = delete;
+    LaunchTimer &operator=(const LaunchTimer &) = delete;
+  };
+
   /**
    * @brief Post an event in the trace, recording where it was posted
    */
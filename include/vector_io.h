@@ -10,12 +10,34 @@ namespace quda
   /**
      @brief VectorIO is a simple wrapper class for loading and saving
      sets of vector fields using QIO.
+
+     If the environment variable QUDA_VECTOR_IO_CHUNK is set to a
+     positive value n, vectors are saved as a sequence of records of
+     at most n vectors, and only two chunks of host staging fields are
+     held at a time.  The download and conversion of each chunk is
+     overlapped with the writing of the previous one, and on load the
+     conversion and upload of each chunk with the reading of the next.
+     Files with any number of records can be loaded regardless of this
+     setting, though a chunked file cannot be read by older versions.
    */
   class VectorIO
   {
     const std::string filename;
     bool parity_inflate;
     bool partfile;
+    int chunk_size; /** number of vectors per record in streaming mode, or zero if disabled */
+
+    /**
+       @brief Load vectors from a file of one or more records, streaming
+       each record through a pair of staging buffers
+    */
+    void load_chunked(cvector_ref<ColorSpinorField> &vecs, QudaPrecision load_prec, bool create_tmp);
+
+    /**
+       @brief Save vectors as a sequence of records of chunk_size
+       vectors, streaming them through a pair of staging buffers
+    */
+    void save_chunked(cvector_ref<const ColorSpinorField> &vecs, int Nvec, QudaPrecision save_prec, bool create_tmp);
 
   public:
     /**
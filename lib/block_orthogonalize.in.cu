@@ -3,12 +3,15 @@
 #include <vector>
 #include <assert.h>
 #include <utility>
+#include <memory>
+#include <cstring>
 
 #include <power_of_two_array.h>
 #include <kernels/block_orthogonalize.cuh>
 #include <tunable_block_reduction.h>
 #include <instantiate.h>
 #include <multigrid.h>
+#include <thread_pool.h>
 
 namespace quda {
 
@@ -115,8 +118,25 @@ namespace quda {
     template <typename Rotator, typename Vector>
     void launch_host_(const TuneParam &tp, const qudaStream_t &stream)
     {
+      // at debug verbosity we check the threaded launch against serial execution, which must agree exactly
+      const int n_threads = thread_pool::get_num_threads();
+      const bool check = getVerbosity() >= QUDA_DEBUG_VERBOSE && n_threads > 1 && !activeTuning();
+      std::unique_ptr<ColorSpinorField> V_in = check ? std::make_unique<ColorSpinorField>(V) : nullptr;
+
       Arg<false, Rotator, Vector> arg(V, B, fine_to_coarse, coarse_to_fine, QUDA_INVALID_PARITY, geo_bs, n_block_ortho, V);
       launch_host<BlockOrtho_, OrthoAggregates>(tp, stream, arg);
+
+      if (check) {
+        ColorSpinorField V_threaded(V);
+        V.copy(*V_in);
+        thread_pool::set_num_threads(1);
+        launch_host<BlockOrtho_, OrthoAggregates>(tp, stream, arg);
+        thread_pool::set_num_threads(n_threads);
+        if (memcmp(V.data(), V_threaded.data(), V.Bytes()))
+          errorQuda("Threaded host block orthogonalization (%d threads) does not match serial execution", n_threads);
+        logQuda(QUDA_DEBUG_VERBOSE, "Threaded host block orthogonalization matches serial execution\n");
+      }
+
       if (two_pass && iter == 0 && V.Precision() < QUDA_SINGLE_PRECISION && !activeTuning()) max = Rotator(V).abs_max(V);
     }
 
@@ -1,4 +1,6 @@
+#include <algorithm>
 #include <gauge_field_order.h>
+#include <thread_pool.h>
 
 namespace quda {
 
@@ -29,54 +31,159 @@ namespace quda {
     return checksum_;
   }
 
-  template <typename T, int Nc>
-  uint64_t Checksum(const GaugeField &u, bool mini)
+  /**
+     Compute the checksum of each sub-block, with the blocks
+     distributed over the host thread pool.  Each block is traversed
+     in lexicographical order, so the accessor strides through memory
+     within each x row.
+   */
+  template <typename Arg>
+  void BlockChecksumCPU(const Arg &arg, GaugeChecksum &sum)
+  {
+    const auto &X = sum.X;
+    thread_pool::parallel_for(sum.checksum.size(), 0, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; i++) {
+        const lat_dim_t o = sum.origin(i);
+        lat_dim_t e;
+        for (int d = 0; d < 4; d++) e[d] = std::min(o[d] + sum.block[d], X[d]);
+
+        uint64_t checksum_ = 0;
+        for (int x3 = o[3]; x3 < e[3]; x3++)
+          for (int x2 = o[2]; x2 < e[2]; x2++)
+            for (int x1 = o[1]; x1 < e[1]; x1++)
+              for (int x0 = o[0]; x0 < e[0]; x0++) {
+                const int idx = ((x3 * X[2] + x2) * X[1] + x1) * X[0] + x0;
+                const int parity = (x0 + x1 + x2 + x3) & 1;
+                for (int d = 0; d < arg.U.geometry; d++) checksum_ ^= siteChecksum(arg, d, parity, idx / 2);
+              }
+        sum.checksum[i] = checksum_;
+      }
+    });
+  }
+
+  /**
+     Instantiate the checksum for the gauge order of u.  The order is
+     passed to f as the ChecksumArg it should operate on.
+   */
+  template <typename T, int Nc, typename F>
+  void instantiateChecksum(const GaugeField &u, bool mini, F &&f)
   {
-    uint64_t checksum = 0;
     if (u.Order() == QUDA_QDP_GAUGE_ORDER) {
-      ChecksumArg<T,QUDA_QDP_GAUGE_ORDER,Nc> arg(u,mini);
-      checksum = ChecksumCPU(arg);
+      f(ChecksumArg<T,QUDA_QDP_GAUGE_ORDER,Nc>(u,mini));
     } else if (u.Order() == QUDA_QDPJIT_GAUGE_ORDER) {
-      ChecksumArg<T,QUDA_QDPJIT_GAUGE_ORDER,Nc> arg(u,mini);
-      checksum = ChecksumCPU(arg);
+      f(ChecksumArg<T,QUDA_QDPJIT_GAUGE_ORDER,Nc>(u,mini));
     } else if (u.Order() == QUDA_MILC_GAUGE_ORDER) {
-      ChecksumArg<T,QUDA_MILC_GAUGE_ORDER,Nc> arg(u,mini);
-      checksum = ChecksumCPU(arg);
+      f(ChecksumArg<T,QUDA_MILC_GAUGE_ORDER,Nc>(u,mini));
     } else if (u.Order() == QUDA_BQCD_GAUGE_ORDER) {
-      ChecksumArg<T,QUDA_BQCD_GAUGE_ORDER,Nc> arg(u,mini);
-      checksum = ChecksumCPU(arg);
+      f(ChecksumArg<T,QUDA_BQCD_GAUGE_ORDER,Nc>(u,mini));
     } else if (u.Order() == QUDA_TIFR_GAUGE_ORDER) {
-      ChecksumArg<T,QUDA_TIFR_GAUGE_ORDER,Nc> arg(u,mini);
-      checksum = ChecksumCPU(arg);
+      f(ChecksumArg<T,QUDA_TIFR_GAUGE_ORDER,Nc>(u,mini));
     } else if (u.Order() == QUDA_TIFR_PADDED_GAUGE_ORDER) {
-      ChecksumArg<T,QUDA_TIFR_PADDED_GAUGE_ORDER,Nc> arg(u,mini);
-      checksum = ChecksumCPU(arg);
+      f(ChecksumArg<T,QUDA_TIFR_PADDED_GAUGE_ORDER,Nc>(u,mini));
     } else {
       errorQuda("Checksum not implemented");
-    }    
+    }
+  }
 
-    return checksum;
+  template <typename F>
+  void instantiateChecksum(const GaugeField &u, bool mini, F &&f)
+  {
+    if (u.Ncolor() != 3) errorQuda("Unsupported nColor = %d", u.Ncolor());
+    switch (u.Precision()) {
+    case QUDA_DOUBLE_PRECISION: instantiateChecksum<double, 3>(u, mini, f); break;
+    case QUDA_SINGLE_PRECISION: instantiateChecksum<float, 3>(u, mini, f); break;
+    default: errorQuda("Unsupported precision = %d", u.Precision());
+    }
   }
 
-  template <typename T>
-  uint64_t Checksum(const GaugeField &u, bool mini)
+  GaugeChecksum::GaugeChecksum(const lat_dim_t &X, const lat_dim_t &block_) : X(X), block(block_)
   {
-    uint64_t checksum = 0;
-    switch (u.Ncolor()) {
-    case 3: checksum = Checksum<T,3>(u,mini); break;
-    default: errorQuda("Unsupported nColor = %d", u.Ncolor());
+    size_t n = 1;
+    for (int d = 0; d < 4; d++) {
+      if (block[d] <= 0) {
+        block[d] = 1;
+        for (int b = std::min(X[d], 8); b > 1; b--)
+          if (X[d] % b == 0) {
+            block[d] = b;
+            break;
+          }
+      }
+      n_block[d] = (X[d] + block[d] - 1) / block[d];
+      n *= n_block[d];
     }
-    return checksum;
+    checksum.resize(n, 0);
+  }
+
+  lat_dim_t GaugeChecksum::origin(size_t i) const
+  {
+    lat_dim_t o = {};
+    for (int d = 0; d < 4; d++) {
+      o[d] = (i % n_block[d]) * block[d];
+      i /= n_block[d];
+    }
+    return o;
+  }
+
+  uint64_t GaugeChecksum::local() const
+  {
+    uint64_t checksum_ = 0;
+    for (auto c : checksum) checksum_ ^= c;
+    return checksum_;
+  }
+
+  uint64_t GaugeChecksum::global() const
+  {
+    uint64_t checksum_ = local();
+    comm_allreduce_xor(checksum_);
+    return checksum_;
+  }
+
+  std::vector<size_t> GaugeChecksum::diff(const GaugeChecksum &other) const
+  {
+    for (int d = 0; d < 4; d++)
+      if (X[d] != other.X[d] || block[d] != other.block[d])
+        errorQuda("Mismatched blocking: X = %d %d, block = %d %d in dimension %d", X[d], other.X[d], block[d],
+                  other.block[d], d);
+
+    std::vector<size_t> blocks;
+    for (size_t i = 0; i < checksum.size(); i++)
+      if (checksum[i] != other.checksum[i]) blocks.push_back(i);
+    return blocks;
+  }
+
+  GaugeChecksum BlockChecksum(const GaugeField &u, const lat_dim_t &block)
+  {
+    if (u.Location() != QUDA_CPU_FIELD_LOCATION) errorQuda("Block checksum requires a host field");
+    GaugeChecksum sum(u.X(), block);
+    instantiateChecksum(u, false, [&](const auto &arg) { BlockChecksumCPU(arg, sum); });
+    return sum;
+  }
+
+  size_t printChecksumDiff(const GaugeChecksum &a, const GaugeChecksum &b)
+  {
+    auto blocks = a.diff(b);
+    for (auto i : blocks) {
+      lat_dim_t o = a.origin(i);
+      for (int d = 0; d < 4; d++) o[d] += comm_coord(d) * a.X[d];
+      // printed unconditionally since the mismatches are generally only present on a subset of ranks
+      printf("Rank %d: checksum mismatch in block %lu with origin (%d, %d, %d, %d) and size (%d, %d, %d, %d)\n",
+             comm_rank(), i, o[0], o[1], o[2], o[3], a.block[0], a.block[1], a.block[2], a.block[3]);
+    }
+    if (blocks.size() > 0) fflush(stdout);
+
+    size_t n = blocks.size();
+    comm_allreduce_sum(n);
+    if (n > 0) warningQuda("Checksums differ in %lu blocks", n);
+    return blocks.size();
   }
 
   uint64_t Checksum(const GaugeField &u, bool mini)
   {
+    // the full checksum is combined from the block checksums, computed in parallel
+    if (!mini) return BlockChecksum(u).global();
+
     uint64_t checksum = 0;
-    switch (u.Precision()) {
-    case QUDA_DOUBLE_PRECISION: checksum = Checksum<double>(u,mini); break;
-    case QUDA_SINGLE_PRECISION: checksum = Checksum<float>(u,mini); break;
-    default: errorQuda("Unsupported precision = %d", u.Precision());
-    }
+    instantiateChecksum(u, mini, [&](const auto &arg) { checksum = ChecksumCPU(arg); });
 
     comm_allreduce_xor(checksum);
 
@@ -278,16 +278,12 @@ namespace quda
       MPI_CHECK(MPI_Allreduce(data, recvbuf.data(), size, MPI_DOUBLE, MPI_SUM, MPI_COMM_HANDLE));
       memcpy(data, recvbuf.data(), size * sizeof(double));
     } else {
-      size_t n = comm_size();
-      std::vector<double> recv_buf(size * n);
-      MPI_CHECK(MPI_Allgather(data, size, MPI_DOUBLE, recv_buf.data(), size, MPI_DOUBLE, MPI_COMM_HANDLE));
-
-      std::vector<double> recv_trans(size * n);
-      for (size_t i = 0; i < n; i++) {
-        for (size_t j = 0; j < size; j++) { recv_trans[j * n + i] = recv_buf[i * size + j]; }
-      }
-
-      for (size_t i = 0; i < size; i++) { data[i] = deterministic_reduce(recv_trans.data() + i * n, n); }
+      // each rank accumulates its partials exactly in fixed point, so that the sum is independent of the reduction order
+      std::vector<int64_t> acc(size * reproducible::n_limb, 0);
+      std::vector<int64_t> recv_buf(size * reproducible::n_limb);
+      for (size_t i = 0; i < size; i++) reproducible::accumulate(acc.data() + i * reproducible::n_limb, data[i]);
+      MPI_CHECK(MPI_Allreduce(acc.data(), recv_buf.data(), acc.size(), MPI_INT64_T, MPI_SUM, MPI_COMM_HANDLE));
+      for (size_t i = 0; i < size; i++) data[i] = reproducible::round(recv_buf.data() + i * reproducible::n_limb);
     }
   }
 
@@ -347,6 +343,63 @@ namespace quda
     data = recvbuf;
   }
 
+  struct ReduceHandle_s {
+    MPI_Request request;
+    double *data;             /** the array that the result is returned in */
+    std::vector<int64_t> acc; /** the superaccumulators of a deterministic sum reduction */
+  };
+
+  /**
+     @brief Start a non-blocking reduction in place on an array of doubles
+   */
+  static ReduceHandle *iallreduce(double *data, size_t size, MPI_Op op, MPI_Comm comm)
+  {
+    auto rh = new ReduceHandle;
+    rh->data = data;
+    MPI_CHECK(MPI_Iallreduce(MPI_IN_PLACE, data, size, MPI_DOUBLE, op, comm, &rh->request));
+    return rh;
+  }
+
+  ReduceHandle *Communicator::comm_iallreduce_sum_array(double *data, size_t size)
+  {
+    if (!comm_deterministic_reduce()) return iallreduce(data, size, MPI_SUM, MPI_COMM_HANDLE);
+
+    // as comm_allreduce_sum_array, with the result rounded when the reduction is completed
+    auto rh = new ReduceHandle;
+    rh->data = data;
+    rh->acc.resize(size * reproducible::n_limb, 0);
+    for (size_t i = 0; i < size; i++) reproducible::accumulate(rh->acc.data() + i * reproducible::n_limb, data[i]);
+    MPI_CHECK(MPI_Iallreduce(MPI_IN_PLACE, rh->acc.data(), rh->acc.size(), MPI_INT64_T, MPI_SUM, MPI_COMM_HANDLE,
+                             &rh->request));
+    return rh;
+  }
+
+  ReduceHandle *Communicator::comm_iallreduce_max_array(double *data, size_t size)
+  {
+    return iallreduce(data, size, MPI_MAX, MPI_COMM_HANDLE);
+  }
+
+  ReduceHandle *Communicator::comm_iallreduce_min_array(double *data, size_t size)
+  {
+    return iallreduce(data, size, MPI_MIN, MPI_COMM_HANDLE);
+  }
+
+  int Communicator::comm_iallreduce_query(ReduceHandle *rh)
+  {
+    int query;
+    MPI_CHECK(MPI_Test(&rh->request, &query, MPI_STATUS_IGNORE));
+    return query;
+  }
+
+  void Communicator::comm_iallreduce_wait(ReduceHandle *&rh)
+  {
+    MPI_CHECK(MPI_Wait(&rh->request, MPI_STATUS_IGNORE));
+    const size_t size = rh->acc.size() / reproducible::n_limb;
+    for (size_t i = 0; i < size; i++) rh->data[i] = reproducible::round(rh->acc.data() + i * reproducible::n_limb);
+    delete rh;
+    rh = nullptr;
+  }
+
   /**  broadcast from rank 0 */
   void Communicator::comm_broadcast(void *data, size_t nbytes, int root)
   {
@@ -305,16 +305,12 @@ void Communicator::comm_allreduce_sum_array(double *data, size_t size)
     QMP_CHECK(QMP_comm_sum_double_array(QMP_COMM_HANDLE, data, size));
   } else {
     // we need to break out of QMP for the deterministic floating point reductions
-    size_t n = comm_size();
-    std::vector<double> recv_buf(size * n);
-    MPI_CHECK(MPI_Allgather(data, size, MPI_DOUBLE, recv_buf.data(), size, MPI_DOUBLE, MPI_COMM_HANDLE));
-
-    std::vector<double> recv_trans(size * n);
-    for (size_t i = 0; i < n; i++) {
-      for (size_t j = 0; j < size; j++) { recv_trans[j * n + i] = recv_buf[i * size + j]; }
-    }
-
-    for (size_t i = 0; i < size; i++) { data[i] = deterministic_reduce(recv_trans.data() + i * n, n); }
+    // each rank accumulates its partials exactly in fixed point, so that the sum is independent of the reduction order
+    std::vector<int64_t> acc(size * reproducible::n_limb, 0);
+    std::vector<int64_t> recv_buf(size * reproducible::n_limb);
+    for (size_t i = 0; i < size; i++) reproducible::accumulate(acc.data() + i * reproducible::n_limb, data[i]);
+    MPI_CHECK(MPI_Allreduce(acc.data(), recv_buf.data(), acc.size(), MPI_INT64_T, MPI_SUM, MPI_COMM_HANDLE));
+    for (size_t i = 0; i < size; i++) data[i] = reproducible::round(recv_buf.data() + i * reproducible::n_limb);
   }
 }
 
@@ -361,6 +357,39 @@ void Communicator::comm_allreduce_xor(uint64_t &data)
   QMP_CHECK(QMP_comm_xor_ulong(QMP_COMM_HANDLE, reinterpret_cast<unsigned long *>(&data)));
 }
 
+/**
+   QMP has no non-blocking reductions, so these are emulated by
+   completing the reduction when it is started
+*/
+struct ReduceHandle_s {
+};
+
+ReduceHandle *Communicator::comm_iallreduce_sum_array(double *data, size_t size)
+{
+  comm_allreduce_sum_array(data, size);
+  return new ReduceHandle;
+}
+
+ReduceHandle *Communicator::comm_iallreduce_max_array(double *data, size_t size)
+{
+  comm_allreduce_max_array(data, size);
+  return new ReduceHandle;
+}
+
+ReduceHandle *Communicator::comm_iallreduce_min_array(double *data, size_t size)
+{
+  comm_allreduce_min_array(data, size);
+  return new ReduceHandle;
+}
+
+int Communicator::comm_iallreduce_query(ReduceHandle *) { return 1; }
+
+void Communicator::comm_iallreduce_wait(ReduceHandle *&rh)
+{
+  delete rh;
+  rh = nullptr;
+}
+
 void Communicator::comm_broadcast(void *data, size_t nbytes, int root)
 {
   // break out of QMP since it can only broadcast from rank 0
@@ -104,6 +104,11 @@ namespace quda
 
   bool comm_deterministic_reduce() { return get_current_communicator().comm_deterministic_reduce(); }
 
+  void comm_set_deterministic_reduce(bool deterministic)
+  {
+    get_current_communicator().comm_set_deterministic_reduce(deterministic);
+  }
+
   void comm_gather_hostname(char *hostname_recv_buf)
   {
     get_current_communicator().comm_gather_hostname(hostname_recv_buf);
@@ -296,6 +301,29 @@ namespace quda
 
   void comm_allreduce_xor(uint64_t &data) { get_current_communicator().comm_allreduce_xor(data); }
 
+  ReduceHandle *comm_iallreduce_sum_array(double *data, size_t size)
+  {
+    return get_current_communicator().comm_iallreduce_sum_array(data, size);
+  }
+
+  ReduceHandle *comm_iallreduce_max_array(double *data, size_t size)
+  {
+    return get_current_communicator().comm_iallreduce_max_array(data, size);
+  }
+
+  ReduceHandle *comm_iallreduce_min_array(double *data, size_t size)
+  {
+    return get_current_communicator().comm_iallreduce_min_array(data, size);
+  }
+
+#define CHECK_RH(rh) { if (rh == nullptr) errorQuda("null reduction handle"); }
+
+  int comm_iallreduce_query(ReduceHandle *rh) { CHECK_RH(rh); return get_current_communicator().comm_iallreduce_query(rh); }
+
+  void comm_iallreduce_wait(ReduceHandle *&rh) { CHECK_RH(rh); get_current_communicator().comm_iallreduce_wait(rh); }
+
+#undef CHECK_RH
+
   void comm_broadcast(void *data, size_t nbytes, int root)
   {
     get_current_communicator().comm_broadcast(data, nbytes, root);
@@ -343,7 +343,9 @@ namespace quda {
       createY(false);
       createYhat(false);
       Y_h->copy(*Y_d);
+      Y_h->exchangeGhost(QUDA_LINK_BIDIRECTIONAL);
       Yhat_h->copy(*Yhat_d);
+      Yhat_h->exchangeGhost(QUDA_LINK_BIDIRECTIONAL);
       X_h->copy(*X_d);
       Xinv_h->copy(*Xinv_d);
       enable_cpu = true;
@@ -204,11 +204,28 @@ namespace quda {
       color_col_stride = tp.aux.x;
       dim_threads = tp.aux.y;
       resizeVector(vector_length_y, 2 * dim_threads * 2 * (Nc / colors_per_thread(Nc, dim_threads)));
-      if (!checkParam(tp)) errorQuda("Invalid launch param");
 
       if (out[0].Location() == QUDA_CPU_FIELD_LOCATION) {
-        errorQuda("Not enabled");
+        // on the host each thread computes both directions of all dimensions for a given site and color block
+        if (dim_threads != 1 || color_col_stride != 1)
+          errorQuda("Invalid host launch param dim_threads=%d color_col_stride=%d", dim_threads, color_col_stride);
+        if constexpr (std::is_same_v<Float, yFloat> && std::is_same_v<Float, ghostFloat>) {
+          for (auto i = 0u; i < out.size(); i++) {
+            if (out[i].FieldOrder() != QUDA_SPACE_SPIN_COLOR_FIELD_ORDER
+                || inA[i].FieldOrder() != QUDA_SPACE_SPIN_COLOR_FIELD_ORDER
+                || inB[i].FieldOrder() != QUDA_SPACE_SPIN_COLOR_FIELD_ORDER)
+              errorQuda("Unsupported host field order out = %d, inA = %d, inB = %d", out[i].FieldOrder(),
+                        inA[i].FieldOrder(), inB[i].FieldOrder());
+          }
+          if (Y.FieldOrder() != QUDA_QDP_GAUGE_ORDER || X.FieldOrder() != QUDA_QDP_GAUGE_ORDER)
+            errorQuda("Unsupported host gauge order Y = %d, X = %d", Y.FieldOrder(), X.FieldOrder());
+          launch_host<CoarseDslash>(tp, stream, Arg<1, 1, false>(out, inA, inB, Y, X, (Float)kappa, parity, halo));
+        } else {
+          errorQuda("Host coarse dslash requires uniform precision (field %lu, link %lu, halo %lu)", sizeof(Float),
+                    sizeof(yFloat), sizeof(ghostFloat));
+        }
       } else {
+        if (!checkParam(tp)) errorQuda("Invalid launch param");
         checkNative(out[0], inA[0], inB[0], Y, X);
 
         switch (tp.aux.y) { // dimension gather parallelisation
@@ -409,7 +426,10 @@ namespace quda {
       dslash(dslash),
       clover(clover),
       commDim(commDim),
-      halo_precision(halo_precision == QUDA_INVALID_PRECISION ? Y.Precision() : halo_precision)
+      // host halos are always exchanged at the precision of the field
+      halo_precision(halo_precision == QUDA_INVALID_PRECISION || Y.Location() == QUDA_CPU_FIELD_LOCATION ?
+                       Y.Precision() :
+                       halo_precision)
     {
     }
 
@@ -779,6 +799,12 @@ namespace quda {
 
    inline void apply(const qudaStream_t &)
    {
+     // the communication policies only apply to device fields
+     if (dslash.out[0].Location() == QUDA_CPU_FIELD_LOCATION) {
+       dslash(DslashCoarsePolicy::DSLASH_COARSE_BASIC);
+       return;
+     }
+
      TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
 
      if (tp.aux.x >= (int)policies.size()) errorQuda("Requested policy that is outside of range");
@@ -1983,7 +1983,10 @@ namespace quda
      dslashParam.remote_write = (p2p_policies[tp.aux.y] == QudaP2PPolicy::QUDA_P2P_REMOTE_WRITE ? 1 : 0); // set whether we are using remote packing writes or copy engines
 
      auto dslashImp = DslashFactory<Dslash>::create(static_cast<QudaDslashPolicy>(tp.aux.x));
-     (*dslashImp)(dslash, in, volume, ghostFace, profile);
+     {
+       LaunchTimer timer(*this); // policies are asynchronous so we time the host wall clock of the dispatch
+       (*dslashImp)(dslash, in, volume, ghostFace, profile);
+     }
 
      // restore p2p state
      comm_enable_peer2peer(p2p_enabled);
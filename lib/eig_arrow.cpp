@@ -0,0 +1,338 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include <util_quda.h>
+#include <thread_pool.h>
+#include <eigensolve_quda.h>
+#include <eigen_helper.h>
+
+/**
+   Divide-and-conquer eigensolver for the symmetric arrow matrices
+   that arise in the thick restart of the Lanczos method.  Removing
+   the arrow row splits the matrix into a diagonal block and a
+   tridiagonal block.  The tridiagonal block is solved recursively (by
+   removing its middle row), and each split is merged by solving the
+   arrowhead eigenproblem of the removed row in the eigenbasis of the
+   two blocks, following Gu and Eisenstat, SIAM J. Matrix Anal. Appl.
+   16 (1995) 172.  The eigenvalues of each arrowhead are the roots of
+   a secular equation, found in O(n^2) operations, and the arrowhead
+   eigenvectors are computed from a recomputed arrow, which keeps
+   them numerically orthogonal.  Components of the arrow that are
+   negligible, or that couple nearly equal diagonal elements, are
+   deflated first.  This is frequently most of them in TRLM, since the
+   arrow elements of converged Ritz pairs are their residua.
+ */
+
+namespace quda
+{
+
+  namespace
+  {
+
+    using matrix_ref = Ref<MatrixXd>;
+
+    /** Below this size, tridiagonal blocks are solved directly with QR iteration */
+    constexpr int arrow_leaf_size = 32;
+
+    /**
+       @brief A root of the secular equation, stored relative to the
+       pole at which it was found, so that the distances to the poles
+       are computed to full relative accuracy
+    */
+    struct secular_root {
+      int origin;
+      double tau;
+    };
+
+    /**
+       @brief Find the j-th root of the secular equation
+       f(lambda) = alpha - lambda - sum_i z_i^2 / (d_i - lambda)
+       of an arrowhead with ascending, distinct diagonal d, nonzero
+       arrow z and tip alpha.  The roots interlace the poles, with the
+       j-th lying in (d_{j-1}, d_j).  Each iteration models the nearest
+       pole exactly and the remainder linearly, safeguarded by
+       bisection.
+    */
+    secular_root secular_solve(int j, const std::vector<double> &d, const std::vector<double> &z, double alpha,
+                               double z_norm)
+    {
+      const int m = d.size();
+      const double eps = std::numeric_limits<double>::epsilon();
+
+      // choose the origin and the bracket of the root relative to the origin
+      int o;
+      double lo, hi;
+      if (j == 0) {
+        o = 0;
+        lo = std::min(d[0], alpha) - z_norm - d[0];
+        hi = 0.0;
+      } else if (j == m) {
+        o = m - 1;
+        lo = 0.0;
+        hi = std::max(d[m - 1], alpha) + z_norm - d[m - 1];
+      } else {
+        const double width = d[j] - d[j - 1];
+        double f = alpha - d[j - 1] - 0.5 * width;
+        for (int i = 0; i < m; i++) f -= z[i] * z[i] / ((d[i] - d[j - 1]) - 0.5 * width);
+        if (f >= 0.0) { // the root lies in the upper half, nearer d_j
+          o = j;
+          lo = -0.5 * width;
+          hi = 0.0;
+        } else {
+          o = j - 1;
+          lo = 0.0;
+          hi = 0.5 * width;
+        }
+      }
+
+      std::vector<double> delta(m);
+      for (int i = 0; i < m; i++) delta[i] = d[i] - d[o];
+      const double shift = alpha - d[o];
+      const double zo2 = z[o] * z[o];
+
+      double tau = 0.5 * (lo + hi);
+      for (int iter = 0; iter < 256; iter++) {
+        // evaluate f and the derivative of its part excluding the origin pole
+        double r = shift - tau, dr = -1.0, scale = std::abs(shift) + std::abs(tau);
+        for (int i = 0; i < m; i++) {
+          if (i == o) continue;
+          const double t = z[i] / (delta[i] - tau);
+          r -= z[i] * t;
+          dr -= t * t;
+          scale += std::abs(z[i] * t);
+        }
+        const double f = r + zo2 / tau;
+        scale += zo2 / std::abs(tau);
+
+        if (std::abs(f) <= 4.0 * (m + 1) * eps * scale) break;
+        if (f > 0.0)
+          lo = tau;
+        else
+          hi = tau;
+        if (hi - lo <= 2.0 * eps * std::max(std::abs(lo), std::abs(hi))) break;
+
+        // solve zo2 / t + r + dr * (t - tau) = 0, taking the root on the side of the bracket
+        const double a = dr, b = r - dr * tau, c = zo2;
+        const double q = -0.5 * (b + std::copysign(std::sqrt(b * b - 4.0 * a * c), b));
+        const double t0 = q / a, t1 = c / q;
+        const double t = (t0 > lo && t0 < hi) ? t0 : t1;
+        tau = (t > lo && t < hi) ? t : 0.5 * (lo + hi);
+      }
+
+      return {o, tau};
+    }
+
+    /**
+       @brief Eigensolve the matrix formed by two diagonalized blocks
+       coupled by row k.  Block 0 occupies rows [0, k) and block 1 rows
+       [k + 1, n).  Each block has eigenvalues lambda, eigenvectors Q
+       and coupling z to row k (in its eigenbasis), and row k has
+       diagonal alpha.
+       @param[out] evals The eigenvalues, in ascending order
+       @param[out] V The eigenvectors, stored as columns
+    */
+    void arrow_merge(int n, int k, double alpha, const VectorXd &lambda0, const MatrixXd &Q0, const VectorXd &z0,
+                     const VectorXd &lambda1, const MatrixXd &Q1, const VectorXd &z1, double *evals, matrix_ref V)
+    {
+      const int n0 = k, n1 = n - k - 1, m = n - 1;
+      enum { upper = 1, lower = 2 };
+
+      // The arrowhead coordinates: diagonal, arrow, and the corresponding vector in the full space
+      std::vector<double> d(m), z(m);
+      std::vector<int> block(m);
+      MatrixXd W = MatrixXd::Zero(n, m);
+      for (int i = 0; i < n0; i++) {
+        d[i] = lambda0[i];
+        z[i] = z0[i];
+        block[i] = upper;
+      }
+      for (int i = 0; i < n1; i++) {
+        d[n0 + i] = lambda1[i];
+        z[n0 + i] = z1[i];
+        block[n0 + i] = lower;
+      }
+      W.block(0, 0, n0, n0) = Q0;
+      W.block(k + 1, n0, n1, n1) = Q1;
+
+      std::vector<int> order(m);
+      std::iota(order.begin(), order.end(), 0);
+      std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return d[a] < d[b]; });
+
+      double norm = std::abs(alpha), z_norm = 0.0;
+      for (int i = 0; i < m; i++) {
+        norm = std::max(norm, std::abs(d[i]));
+        z_norm += z[i] * z[i];
+      }
+      z_norm = std::sqrt(z_norm);
+      const double tol = 8.0 * std::numeric_limits<double>::epsilon() * std::max(norm, z_norm);
+
+      // Deflation: negligible arrow components decouple, and nearly equal
+      // diagonal elements are rotated such that one of them decouples
+      std::vector<int> kept, deflated;
+      int prev = -1;
+      for (int c : order) {
+        if (std::abs(z[c]) <= tol) {
+          deflated.push_back(c);
+          continue;
+        }
+        if (prev >= 0) {
+          const double r = std::hypot(z[prev], z[c]);
+          const double cs = z[c] / r, sn = z[prev] / r;
+          if (std::abs(cs * sn * (d[prev] - d[c])) <= tol) {
+            const double d_prev = cs * cs * d[prev] + sn * sn * d[c];
+            d[c] = sn * sn * d[prev] + cs * cs * d[c];
+            d[prev] = d_prev;
+            z[prev] = 0.0;
+            z[c] = r;
+            VectorXd w = W.col(prev);
+            W.col(prev) = cs * w - sn * W.col(c);
+            W.col(c) = sn * w + cs * W.col(c);
+            block[c] |= block[prev];
+            deflated.push_back(prev);
+            prev = c;
+            continue;
+          }
+          kept.push_back(prev);
+        }
+        prev = c;
+      }
+      if (prev >= 0) kept.push_back(prev);
+
+      // Solve the secular equation of the remaining arrowhead
+      const int p = kept.size();
+      std::vector<double> dk(p), zk(p);
+      for (int i = 0; i < p; i++) {
+        dk[i] = d[kept[i]];
+        zk[i] = z[kept[i]];
+      }
+      std::vector<secular_root> root(p + 1);
+      if (p == 0) {
+        root[0] = {-1, alpha};
+      } else {
+        thread_pool::parallel_for(p + 1, 1, [&](size_t begin, size_t end) {
+          for (size_t j = begin; j < end; j++) root[j] = secular_solve(j, dk, zk, alpha, z_norm);
+        });
+      }
+      // lambda_j - d_i, computed relative to the origin of root j
+      auto gap = [&](int j, int i) { return root[j].tau - (dk[i] - dk[root[j].origin]); };
+
+      // Recompute the arrow from the computed roots, such that they are
+      // the exact eigenvalues of a nearby arrowhead (Lowner's theorem)
+      std::vector<double> zh(p);
+      thread_pool::parallel_for(p, 0, [&](size_t begin, size_t end) {
+        for (size_t i_ = begin; i_ < end; i_++) {
+          const int i = i_;
+          double zi2 = -gap(i, i) * gap(i + 1, i);
+          for (int j = 0; j < i; j++) zi2 *= gap(j, i) / (dk[j] - dk[i]);
+          for (int j = i + 1; j < p; j++) zi2 *= gap(j + 1, i) / (dk[j] - dk[i]);
+          zh[i] = std::copysign(std::sqrt(std::abs(zi2)), zk[i]);
+        }
+      });
+
+      // Arrowhead eigenvectors, with the tip component last
+      MatrixXd U(p + 1, p + 1);
+      thread_pool::parallel_for(p + 1, 0, [&](size_t begin, size_t end) {
+        for (size_t j = begin; j < end; j++) {
+          for (int i = 0; i < p; i++) U(i, j) = zh[i] / gap(j, i);
+          U(p, j) = 1.0;
+          U.col(j).normalize();
+        }
+      });
+
+      // Order all eigenvalues ascending
+      std::vector<std::pair<double, int>> eig; // (value, source), where source < p + 1 is a root, else deflated
+      for (int j = 0; j <= p; j++) eig.push_back({root[j].origin < 0 ? alpha : dk[root[j].origin] + root[j].tau, j});
+      for (size_t i = 0; i < deflated.size(); i++) eig.push_back({d[deflated[i]], p + 1 + i});
+      std::stable_sort(eig.begin(), eig.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+
+      // Back transform the arrowhead eigenvectors, where each block of rows
+      // only involves the coordinates that have support in that block
+      auto transform = [&](int row, int rows, int mask) {
+        std::vector<int> cols, idx;
+        for (int i = 0; i < p; i++)
+          if (block[kept[i]] & mask) {
+            cols.push_back(kept[i]);
+            idx.push_back(i);
+          }
+        MatrixXd Wb(rows, cols.size()), Ub(cols.size(), p + 1);
+        for (size_t c = 0; c < cols.size(); c++) {
+          Wb.col(c) = W.col(cols[c]).segment(row, rows);
+          Ub.row(c) = U.row(idx[c]);
+        }
+        return MatrixXd(Wb * Ub);
+      };
+      MatrixXd R0 = transform(0, n0, upper);
+      MatrixXd R1 = transform(k + 1, n1, lower);
+
+      for (int pos = 0; pos < n; pos++) {
+        evals[pos] = eig[pos].first;
+        const int j = eig[pos].second;
+        if (j <= p) {
+          V.col(pos).segment(0, n0) = R0.col(j);
+          V(k, pos) = U(p, j);
+          V.col(pos).segment(k + 1, n1) = R1.col(j);
+        } else {
+          V.col(pos) = W.col(deflated[j - p - 1]);
+        }
+      }
+    }
+
+    /**
+       @brief Eigensolve the symmetric tridiagonal matrix with diagonal
+       a and off diagonal e
+       @param[out] evals The eigenvalues, in ascending order
+       @param[out] V The eigenvectors, stored as columns
+    */
+    void tridiagonal_eigensolve(const double *a, const double *e, int n, double *evals, matrix_ref V)
+    {
+      if (n <= arrow_leaf_size) {
+        VectorXd diag = Map<const VectorXd>(a, n);
+        VectorXd sub = n > 1 ? VectorXd(Map<const VectorXd>(e, n - 1)) : VectorXd(1);
+        SelfAdjointEigenSolver<MatrixXd> eigensolver;
+        eigensolver.computeFromTridiagonal(diag, sub.head(std::max(n - 1, 0)), ComputeEigenvectors);
+        Map<VectorXd>(evals, n) = eigensolver.eigenvalues();
+        V = eigensolver.eigenvectors();
+        return;
+      }
+
+      const int k = n / 2, n0 = k, n1 = n - k - 1;
+      VectorXd lambda0(n0), lambda1(n1);
+      MatrixXd Q0(n0, n0), Q1(n1, n1);
+      tridiagonal_eigensolve(a, e, n0, lambda0.data(), Q0);
+      tridiagonal_eigensolve(a + k + 1, e + k + 1, n1, lambda1.data(), Q1);
+
+      VectorXd z0 = e[k - 1] * Q0.row(n0 - 1).transpose();
+      VectorXd z1 = e[k] * Q1.row(0).transpose();
+      arrow_merge(n, k, a[k], lambda0, Q0, z0, lambda1, Q1, z1, evals, V);
+    }
+
+  } // namespace
+
+  void arrowEigensolve(const double *a, const double *b, int n, int arrow_pos, double *evals, double *evecs)
+  {
+    Map<MatrixXd> V(evecs, n, n);
+    if (arrow_pos == 0) {
+      tridiagonal_eigensolve(a, b, n, evals, V);
+      return;
+    }
+
+    // the leading block is already diagonal
+    const int k = arrow_pos, n0 = k, n1 = n - k - 1;
+    VectorXd lambda0 = Map<const VectorXd>(a, n0);
+    MatrixXd Q0 = MatrixXd::Identity(n0, n0);
+    VectorXd z0 = Map<const VectorXd>(b, n0);
+
+    VectorXd lambda1(n1), z1(n1);
+    MatrixXd Q1(n1, n1);
+    if (n1 > 0) {
+      tridiagonal_eigensolve(a + k + 1, b + k + 1, n1, lambda1.data(), Q1);
+      z1 = b[k] * Q1.row(0).transpose();
+    }
+
+    arrow_merge(n, k, a[k], lambda0, Q0, z0, lambda1, Q1, z1, evals, V);
+  }
+
+} // namespace quda
@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 #include <iostream>
 #include <vector>
@@ -25,6 +26,9 @@ namespace quda
     alpha.resize(n_kr, 0.0);
     beta.resize(n_kr, 0.0);
 
+    char *dense_arrow_env = getenv("QUDA_EIG_DENSE_ARROW");
+    if (dense_arrow_env && strcmp(dense_arrow_env, "0")) dense_arrow = true;
+
     // Thick restart specific checks
     if (n_kr < n_ev + 6) errorQuda("n_kr=%d must be greater than n_ev+6=%d\n", n_kr, n_ev + 6);
 
@@ -256,8 +260,6 @@ namespace quda
     int dim = n_kr - num_locked;
     int arrow_pos = num_keep - num_locked;
 
-    // Eigen objects
-    MatrixXd A = MatrixXd::Zero(dim, dim);
     ritz_mat.resize(dim * dim, 0.0);
 
     // Invert the spectrum due to chebyshev
@@ -269,39 +271,55 @@ namespace quda
       alpha[n_kr - 1] *= -1.0;
     }
 
-    // Construct arrow mat A_{dim,dim}
-    for (int i = 0; i < dim; i++) {
+    if (!dense_arrow) {
+      // Eigensolve the arrow matrix by divide and conquer, directly into the ritz matrix
+      std::vector<double> evals(dim);
+      arrowEigensolve(alpha.data() + num_locked, beta.data() + num_locked, dim, arrow_pos, evals.data(),
+                      ritz_mat.data());
 
-      // alpha populates the diagonal
-      A(i, i) = alpha[i + num_locked];
-    }
+      for (int i = 0; i < dim; i++) {
+        residua[i + num_locked] = fabs(beta[n_kr - 1] * ritz_mat[dim * i + dim - 1]);
+        // Update the alpha array
+        alpha[i + num_locked] = evals[i];
+      }
+    } else {
+      // Eigen objects
+      MatrixXd A = MatrixXd::Zero(dim, dim);
 
-    for (int i = 0; i < arrow_pos; i++) {
+      // Construct arrow mat A_{dim,dim}
+      for (int i = 0; i < dim; i++) {
 
-      // beta populates the arrow
-      A(i, arrow_pos) = beta[i + num_locked];
-      A(arrow_pos, i) = beta[i + num_locked];
-    }
+        // alpha populates the diagonal
+        A(i, i) = alpha[i + num_locked];
+      }
 
-    for (int i = arrow_pos; i < dim - 1; i++) {
+      for (int i = 0; i < arrow_pos; i++) {
 
-      // beta populates the sub-diagonal
-      A(i, i + 1) = beta[i + num_locked];
-      A(i + 1, i) = beta[i + num_locked];
-    }
+        // beta populates the arrow
+        A(i, arrow_pos) = beta[i + num_locked];
+        A(arrow_pos, i) = beta[i + num_locked];
+      }
+
+      for (int i = arrow_pos; i < dim - 1; i++) {
 
-    // Eigensolve the arrow matrix
-    SelfAdjointEigenSolver<MatrixXd> eigensolver;
-    eigensolver.compute(A);
+        // beta populates the sub-diagonal
+        A(i, i + 1) = beta[i + num_locked];
+        A(i + 1, i) = beta[i + num_locked];
+      }
+
+      // Eigensolve the arrow matrix
+      SelfAdjointEigenSolver<MatrixXd> eigensolver;
+      eigensolver.compute(A);
 
-    // repopulate ritz matrix
-    for (int i = 0; i < dim; i++)
-      for (int j = 0; j < dim; j++) ritz_mat[dim * i + j] = eigensolver.eigenvectors().col(i)[j];
+      // repopulate ritz matrix
+      for (int i = 0; i < dim; i++)
+        for (int j = 0; j < dim; j++) ritz_mat[dim * i + j] = eigensolver.eigenvectors().col(i)[j];
 
-    for (int i = 0; i < dim; i++) {
-      residua[i + num_locked] = fabs(beta[n_kr - 1] * eigensolver.eigenvectors().col(i)[dim - 1]);
-      // Update the alpha array
-      alpha[i + num_locked] = eigensolver.eigenvalues()[i];
+      for (int i = 0; i < dim; i++) {
+        residua[i + num_locked] = fabs(beta[n_kr - 1] * eigensolver.eigenvectors().col(i)[dim - 1]);
+        // Update the alpha array
+        alpha[i + num_locked] = eigensolver.eigenvalues()[i];
+      }
     }
 
     // Put spectrum back in order
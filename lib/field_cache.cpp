@@ -1,21 +1,326 @@
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <list>
+#include <mutex>
+#include <set>
 #include <field_cache.h>
 #include <color_spinor_field.h>
 
 namespace quda {
 
-  template <typename T> std::map<FieldKey<T>, std::stack<T>> FieldTmp<T>::cache;
+  /**
+     The field cache proper.  The shared cache holds fields in a list
+     in order of use, indexed both by key, for exact matches, and by
+     size, to find the smallest larger compatible field.  In front of
+     this each thread has a small cache of the fields it most recently
+     released.  The counters include the fields held in the front
+     caches.
+   */
+  template <typename T> struct FieldTmp<T>::Cache {
+    struct entry_t;
+    using list_t = std::list<entry_t>;
+    using key_map_t = std::multimap<FieldKey<T>, typename list_t::iterator>;
+    using size_map_t = std::multimap<size_t, typename list_t::iterator>;
+
+    struct entry_t {
+      T field;
+      typename key_map_t::iterator key_it;
+      typename size_map_t::iterator size_it;
+    };
+
+    /**
+       Per-thread front cache.  Its mutex is only contended when the
+       front caches are flushed by destroy().
+    */
+    struct Front {
+      std::mutex mutex;
+      std::vector<std::pair<FieldKey<T>, T>> fields; /** fields, with the most recently released at the back */
+      Front() { FieldTmp<T>::cache().attach(this); }
+      ~Front() { FieldTmp<T>::cache().detach(this); }
+    };
+
+    /** maximum number of fields held by each front cache */
+    static constexpr size_t front_capacity = 4;
+
+    std::mutex mutex;         /** protects the shared cache and the set of front caches */
+    std::set<Front *> fronts; /** the front caches of all threads */
+
+    list_t lru;          /** cached fields, with the least recently used at the front */
+    key_map_t key_map;   /** cached fields indexed by key */
+    size_map_t size_map; /** cached fields indexed by size in bytes */
+
+    std::atomic<size_t> budget = std::numeric_limits<size_t>::max();
+    std::atomic<double> reuse_larger = 0.0;
+
+    std::atomic<size_t> hits = 0;
+    std::atomic<size_t> larger_hits = 0;
+    std::atomic<size_t> misses = 0;
+    std::atomic<size_t> evictions = 0;
+    std::atomic<size_t> fields_held = 0;
+    std::atomic<size_t> bytes_held = 0;
+    std::atomic<size_t> peak_bytes_held = 0;
+
+    Cache()
+    {
+      char *budget_env = getenv("QUDA_FIELD_CACHE_BUDGET");
+      if (budget_env) budget = static_cast<size_t>(std::stod(budget_env) * (1 << 20));
+      char *reuse_larger_env = getenv("QUDA_FIELD_CACHE_REUSE_LARGER");
+      if (reuse_larger_env) reuse_larger = std::stod(reuse_larger_env);
+    }
+
+    /**
+       @brief Return the front cache of the calling thread
+    */
+    static Front &front()
+    {
+      static thread_local Front front_;
+      return front_;
+    }
+
+    void attach(Front *f)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      fronts.insert(f);
+    }
+
+    /**
+       @brief Detach a front cache when its thread exits, moving its
+       fields to the shared cache
+    */
+    void detach(Front *f)
+    {
+      std::vector<std::pair<FieldKey<T>, T>> fields;
+      {
+        std::lock_guard<std::mutex> lock(f->mutex);
+        fields = std::move(f->fields);
+      }
+
+      std::lock_guard<std::mutex> lock(mutex);
+      fronts.erase(f);
+      for (auto &field : fields) {
+        remove_bytes(field.second.Bytes());
+        push(field.first, std::move(field.second));
+      }
+    }
+
+    void add_bytes(size_t bytes)
+    {
+      fields_held++;
+      size_t held = bytes_held += bytes;
+      size_t peak = peak_bytes_held.load();
+      while (held > peak && !peak_bytes_held.compare_exchange_weak(peak, held)) { }
+    }
+
+    void remove_bytes(size_t bytes)
+    {
+      fields_held--;
+      bytes_held -= bytes;
+    }
+
+    /**
+       @brief Remove an entry from the shared cache, returning its
+       field.  The shared cache mutex must be held.
+    */
+    T erase(typename list_t::iterator it)
+    {
+      T field = std::move(it->field);
+      key_map.erase(it->key_it);
+      size_map.erase(it->size_it);
+      lru.erase(it);
+      remove_bytes(field.Bytes());
+      return field;
+    }
+
+    /**
+       @brief Free cached fields until the total held is no more than
+       the given number of bytes.  The least recently used fields of
+       the shared cache are freed first, followed by those of the front
+       caches.  The shared cache mutex must be held.
+    */
+    void evict(size_t bytes)
+    {
+      while (bytes_held > bytes && lru.size()) {
+        erase(lru.begin());
+        evictions++;
+      }
+
+      for (auto f : fronts) {
+        if (bytes_held <= bytes) break;
+        std::lock_guard<std::mutex> front_lock(f->mutex);
+        while (bytes_held > bytes && f->fields.size()) {
+          remove_bytes(f->fields.front().second.Bytes());
+          f->fields.erase(f->fields.begin());
+          evictions++;
+        }
+      }
+    }
+
+    /**
+       @brief Pop the most recently cached field matching a key from
+       the shared cache.  The shared cache mutex must be held.
+       @return Whether a matching field was found
+    */
+    bool pop(const FieldKey<T> &key, T &field)
+    {
+      auto range = key_map.equal_range(key);
+      if (range.first == range.second) return false;
+      field = erase(std::prev(range.second)->second);
+      hits++;
+      return true;
+    }
+
+    /**
+       @brief Push a field onto the shared cache, first evicting the
+       least recently used fields as needed to stay within the budget.
+       If the field is larger than the budget it is freed.  The shared
+       cache mutex must be held.
+    */
+    void push(const FieldKey<T> &key, T &&field)
+    {
+      const size_t bytes = field.Bytes();
+      if (bytes > budget) {
+        evictions++;
+        return;
+      }
+      evict(budget - bytes);
+
+      auto it = lru.insert(lru.end(), entry_t {std::move(field), {}, {}});
+      it->key_it = key_map.insert({key, it});
+      it->size_it = size_map.insert({bytes, it});
+      add_bytes(bytes);
+    }
+
+    /**
+       @brief Acquire the most recently released field matching a key,
+       searching first the front cache of this thread and then the
+       shared cache
+       @return Whether a matching field was found
+    */
+    bool acquire(const FieldKey<T> &key, T &field)
+    {
+      auto &f = front();
+      {
+        std::lock_guard<std::mutex> lock(f.mutex);
+        for (auto it = f.fields.rbegin(); it != f.fields.rend(); it++) {
+          if (it->first == key) {
+            field = std::move(it->second);
+            f.fields.erase(std::next(it).base());
+            remove_bytes(field.Bytes());
+            hits++;
+            return true;
+          }
+        }
+      }
+
+      std::lock_guard<std::mutex> lock(mutex);
+      return pop(key, field);
+    }
+
+    /**
+       @brief Acquire the smallest field from the shared cache that can
+       be aliased to create a field matching a, provided it is no more
+       than reuse_larger times the size of a
+       @return Whether a compatible field was found
+    */
+    bool acquire_larger(const T &a, T &field, FieldKey<T> &field_key)
+    {
+      if (reuse_larger <= 1.0) return false;
+      const size_t max_bytes = static_cast<size_t>(reuse_larger * a.Bytes());
+
+      std::lock_guard<std::mutex> lock(mutex);
+      for (auto it = size_map.lower_bound(a.Bytes()); it != size_map.end() && it->first <= max_bytes; it++) {
+        const T &f = it->second->field;
+        if (f.Location() == a.Location() && f.MemType() == a.MemType() && f.Precision() >= a.Precision()
+            && !f.IsComposite()) {
+          field_key = it->second->key_it->first;
+          field = erase(it->second);
+          larger_hits++;
+          return true;
+        }
+      }
+      return false;
+    }
+
+    /**
+       @brief Release a field to the front cache of this thread.  If
+       the front cache is full, its least recently released field is
+       moved to the shared cache.  If holding the field would exceed
+       the budget, it is instead pushed directly to the shared cache,
+       where the budget is enforced.
+    */
+    void release(const FieldKey<T> &key, T &&field)
+    {
+      const size_t bytes = field.Bytes();
+      if (bytes_held + bytes > budget) {
+        std::lock_guard<std::mutex> lock(mutex);
+        push(key, std::move(field));
+        return;
+      }
+
+      std::vector<std::pair<FieldKey<T>, T>> overflow;
+      {
+        auto &f = front();
+        std::lock_guard<std::mutex> lock(f.mutex);
+        if (f.fields.size() == front_capacity) {
+          overflow.push_back(std::move(f.fields.front()));
+          f.fields.erase(f.fields.begin());
+        }
+        f.fields.emplace_back(key, std::move(field));
+        add_bytes(bytes);
+      }
+
+      // the front cache lock is released before taking the shared cache lock to preserve the lock order of clear()
+      if (overflow.size()) {
+        std::lock_guard<std::mutex> lock(mutex);
+        remove_bytes(overflow[0].second.Bytes());
+        push(overflow[0].first, std::move(overflow[0].second));
+      }
+    }
+
+    void set_budget(size_t bytes)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      budget = bytes;
+      evict(bytes);
+    }
+
+    /**
+       @brief Free all fields held by the shared and front caches
+    */
+    void clear()
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      for (auto f : fronts) {
+        std::lock_guard<std::mutex> front_lock(f->mutex);
+        for (auto &field : f->fields) remove_bytes(field.second.Bytes());
+        f->fields.clear();
+      }
+      while (lru.size()) erase(lru.begin());
+    }
+  };
+
+  template <typename T> typename FieldTmp<T>::Cache &FieldTmp<T>::cache()
+  {
+    // deliberately never destroyed, so that it outlives the front caches of all threads
+    static Cache *cache_ = new Cache;
+    return *cache_;
+  }
 
   template <typename T> FieldTmp<T>::FieldTmp(const T &a) : key(FieldKey(a))
   {
-    auto it = cache.find(key);
+    auto &cache = FieldTmp<T>::cache();
 
-    if (it != cache.end() && it->second.size()) { // found an entry
-      tmp = std::move(it->second.top());
-      it->second.pop(); // pop the defunct object
-    } else { // no entry found, we must allocate a new field
+    if (!cache.acquire(key, tmp)) {
       typename T::param_type param(a);
-      param.create = QUDA_ZERO_FIELD_CREATE;
-      tmp = T(param);
+      if (cache.acquire_larger(a, backing, backing_key)) { // found a larger entry we can alias
+        tmp = backing.create_alias(param);
+        tmp.zeroPad();
+      } else { // no entry found, we must allocate a new field
+        param.create = QUDA_ZERO_FIELD_CREATE;
+        tmp = T(param);
+        cache.misses++;
+      }
     }
 
     if constexpr (std::is_same_v<T, ColorSpinorField>) {
@@ -25,26 +330,58 @@ namespace quda {
 
   template <typename T> FieldTmp<T>::FieldTmp(const FieldKey<T> &key, const typename T::param_type &param) : key(key)
   {
-    auto it = cache.find(key);
+    auto &cache = FieldTmp<T>::cache();
 
-    if (it != cache.end() && it->second.size()) { // found an entry
-      tmp = std::move(it->second.top());
-      it->second.pop(); // pop the defunct object
-    } else {            // no entry found, we must allocate a new field
+    if (!cache.acquire(key, tmp)) { // no entry found, we must allocate a new field
       tmp = T(param);
+      cache.misses++;
     }
   }
 
   template <typename T> FieldTmp<T>::~FieldTmp()
   {
+    // if we are aliasing a larger field, it is that which is returned to the cache
+    if (backing.Bytes() != 0) {
+      cache().release(backing_key, std::move(backing));
+      return;
+    }
+
     // don't cache the field if it's empty (e.g., has been moved)
     if (tmp.Bytes() == 0) return;
-    cache[key].push(std::move(tmp));
+    cache().release(key, std::move(tmp));
   }
 
   template <typename T> void FieldTmp<T>::destroy()
   {
-    cache.clear();
+    cache().clear();
+  }
+
+  template <typename T> void FieldTmp<T>::set_budget(size_t bytes) { cache().set_budget(bytes); }
+
+  template <typename T> size_t FieldTmp<T>::get_budget() { return cache().budget; }
+
+  template <typename T> void FieldTmp<T>::set_reuse_larger(double factor) { cache().reuse_larger = factor; }
+
+  template <typename T> FieldCacheStats FieldTmp<T>::get_stats()
+  {
+    auto &cache = FieldTmp<T>::cache();
+    FieldCacheStats stats;
+    stats.hits = cache.hits;
+    stats.larger_hits = cache.larger_hits;
+    stats.misses = cache.misses;
+    stats.evictions = cache.evictions;
+    stats.fields_held = cache.fields_held;
+    stats.bytes_held = cache.bytes_held;
+    stats.peak_bytes_held = cache.peak_bytes_held;
+    return stats;
+  }
+
+  template <typename T> void FieldTmp<T>::print_stats()
+  {
+    auto stats = get_stats();
+    printfQuda("Field cache: hits = %lu, larger hits = %lu, misses = %lu, evictions = %lu, peak held = %.1f MiB\n",
+               stats.hits, stats.larger_hits, stats.misses, stats.evictions,
+               stats.peak_bytes_held / static_cast<double>(1 << 20));
   }
 
   template class FieldTmp<ColorSpinorField>;
@@ -1041,8 +1041,14 @@ namespace quda {
     } else if (src.Location() == QUDA_CPU_FIELD_LOCATION) {
 
       if (location == QUDA_CPU_FIELD_LOCATION) {
-        // copy field and ghost zone directly
-        copyGenericGauge(*this, src, QUDA_CPU_FIELD_LOCATION);
+        if (reorderGaugeHost(*this, src)) {
+          // body has been reordered, so only the ghost zone remains to be copied
+          if (ghostExchange == QUDA_GHOST_EXCHANGE_PAD && src.GhostExchange() == QUDA_GHOST_EXCHANGE_PAD)
+            copyGenericGauge(*this, src, QUDA_CPU_FIELD_LOCATION, nullptr, nullptr, nullptr, nullptr, 1);
+        } else {
+          // copy field and ghost zone directly
+          copyGenericGauge(*this, src, QUDA_CPU_FIELD_LOCATION);
+        }
       } else {
         if (reorder_location() == QUDA_CPU_FIELD_LOCATION) { // do reorder on the CPU
           void *buffer = pool_pinned_malloc(bytes);
@@ -1,6 +1,8 @@
 #include <quda_internal.h>
 #include <gauge_field.h>
 #include <random_quda.h>
+#include <random_host.h>
+#include <thread_pool.h>
 #include <instantiate.h>
 #include <tunable_nd.h>
 #include <kernels/gauge_noise.cuh>
@@ -28,7 +30,52 @@ namespace quda {
       } else {
         logQuda(QUDA_SUMMARIZE, "Creating uniformly distributed field\n");
       }
-      apply(device::get_default_stream());
+      if (U.Location() == QUDA_CPU_FIELD_LOCATION) {
+        if (U.Order() == QUDA_QDP_GAUGE_ORDER) applyHost<QUDA_QDP_GAUGE_ORDER>();
+        else if (U.Order() == QUDA_MILC_GAUGE_ORDER) applyHost<QUDA_MILC_GAUGE_ORDER>();
+        else errorQuda("Unsupported order %d", U.Order());
+      } else {
+        apply(device::get_default_stream());
+      }
+    }
+
+    /**
+       @brief Generate the noise on the host thread pool, recreating
+       the state of each site with skip-ahead
+    */
+    template <QudaGaugeFieldOrder order> void applyHost()
+    {
+      unsigned long long offset;
+      if (!rng.HostOffset(offset)) errorQuda("RNG states are resident on the device");
+      if (2 * U.LocalVolumeCB() != rng.Size())
+        errorQuda("Field sites (%lu) do not match the RNG states (%lu)", 2 * U.LocalVolumeCB(), rng.Size());
+
+      gauge::FieldOrder<real, nColor, 1, order, true, real> V(U);
+      int X[4], E[4], border[4];
+      for (int dir = 0; dir < 4; dir++) {
+        border[dir] = U.R()[dir];
+        E[dir] = U.X()[dir];
+        X[dir] = U.X()[dir] - border[dir] * 2;
+      }
+      const size_t volume_cb = U.LocalVolumeCB();
+      const int geometry = U.Geometry();
+      const unsigned long long seed = rng.Seed();
+
+      thread_pool::parallel_for(2 * volume_cb, 0, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+          const int parity = i / volume_cb;
+          int x[4];
+          getCoords(x, i % volume_cb, X, parity);
+          for (int dr = 0; dr < 4; ++dr) x[dr] += border[dr]; // extended grid coordinates
+          const int e_cb = linkIndex(x, E);
+
+          HostRNGState state(seed, rng.Subsequence(i), offset);
+          for (int g = 0; g < geometry; g++)
+            for (int r = 0; r < nColor; r++)
+              for (int c = 0; c < nColor; c++) V(g, parity, e_cb, r, c) = hostNoise<real>(state, type);
+        }
+      });
+      rng.Advance(noise_draws * geometry * nColor * nColor);
     }
 
     void apply(const qudaStream_t &stream)
@@ -66,11 +113,19 @@ namespace quda {
     
   void gaugeNoise(GaugeField &U_, RNG &rng, QudaNoiseType type)
   {
+    // CPU fields are filled on the host if the RNG states can be regenerated there.  The host
+    // only tracks a single offset for all states, so the field must draw from every state.
+    unsigned long long offset;
+    const bool host = U_.Location() == QUDA_CPU_FIELD_LOCATION && U_.Precision() >= QUDA_SINGLE_PRECISION
+      && U_.Reconstruct() == QUDA_RECONSTRUCT_NO
+      && (U_.Order() == QUDA_QDP_GAUGE_ORDER || U_.Order() == QUDA_MILC_GAUGE_ORDER) && rng.HostOffset(offset)
+      && 2 * U_.LocalVolumeCB() == rng.Size() && hostNoiseEnabled();
+
     GaugeFieldParam param(U_);
     GaugeField *U = nullptr;
     bool copy_back = false;
-    if (U_.Location() == QUDA_CPU_FIELD_LOCATION || U_.Precision() < QUDA_SINGLE_PRECISION ||
-        U_.Reconstruct() != QUDA_RECONSTRUCT_NO || !U_.isNative()) {
+    if (!host && (U_.Location() == QUDA_CPU_FIELD_LOCATION || U_.Precision() < QUDA_SINGLE_PRECISION ||
+        U_.Reconstruct() != QUDA_RECONSTRUCT_NO || !U_.isNative())) {
       QudaPrecision prec = std::max(U_.Precision(), QUDA_SINGLE_PRECISION);
       param.setPrecision(prec, true);
       if (param.order != QUDA_FLOAT2_GAUGE_ORDER) errorQuda("Unexpected order %d", param.order);
@@ -0,0 +1,239 @@
+#include <cstdlib>
+#include <cstring>
+#include <gauge_field.h>
+#include <thread_pool.h>
+
+#if defined(__SSE2__) && defined(__x86_64__)
+#include <immintrin.h>
+#define QUDA_STREAMING_STORES
+#endif
+
+/**
+   @file gauge_reorder_host.cpp
+
+   @section Description
+
+   Dedicated engine for reordering Nc = 3, non-reconstructed link
+   fields between the legacy host orders (QDP, MILC, MILC_SITE, BQCD,
+   TIFR and TIFR_PADDED).  Each order is reduced to a descriptor of
+   where a given link lives in memory, and the field is copied one
+   x-row of sites at a time: a row of X[0]/2 sites and all of their
+   links is small enough to remain in L1, so whichever of the source
+   or destination is strided is only strided within the tile.  Rows
+   are distributed over the host thread pool, and for destinations
+   larger than the last-level cache the links are written with
+   non-temporal stores to avoid the read-for-ownership of each
+   destination line.
+ */
+
+namespace quda
+{
+
+  /**
+     Where the links of a given order live: the link (d, parity, x_cb)
+     begins at base[d] + parity * parity_stride + site(x_cb) *
+     site_stride bytes, where site() is the identity apart from the
+     z-padded TIFR order.
+   */
+  struct LinkLayout {
+    char *base[4];
+    size_t parity_stride;
+    size_t site_stride;
+    bool transpose;  /** links are stored as the transpose (column major) */
+    bool dir_major;  /** whether the links of a given dimension are contiguous */
+    bool z_padded;   /** whether the z dimension is padded by two sites either side */
+    double scale;    /** links are stored multiplied by this factor */
+
+    /**
+       @brief Return the site index of the first site of the given
+       x-row in this layout
+       @param[in] row The x-row index within a parity, e.g., (t * Z + z) * Y + y
+       @param[in] X The lattice dimensions
+     */
+    size_t row_site(size_t row, const lat_dim_t &X) const
+    {
+      if (!z_padded) return row * (X[0] / 2);
+      const size_t y = row % X[1];
+      const size_t z = (row / X[1]) % X[2];
+      const size_t t = row / (X[1] * X[2]);
+      return ((t * (X[2] + 4) + z + 2) * X[1] + y) * (X[0] / 2);
+    }
+
+    char *link(int d, int parity, size_t site) const { return base[d] + parity * parity_stride + site * site_stride; }
+  };
+
+  /**
+     @brief Build the layout descriptor for a given field
+     @param[in] u The field
+     @param[out] layout The layout
+     @return Whether the order of u is supported
+   */
+  static bool get_layout(const GaugeField &u, LinkLayout &layout)
+  {
+    const size_t link_bytes = 18 * u.Precision();
+    const size_t volume_cb = u.VolumeCB();
+
+    layout.transpose = false;
+    layout.dir_major = true;
+    layout.z_padded = false;
+    layout.scale = 1.0;
+
+    switch (u.Order()) {
+    case QUDA_QDP_GAUGE_ORDER:
+      for (int d = 0; d < 4; d++) layout.base[d] = u.data<char *>(d);
+      layout.parity_stride = volume_cb * link_bytes;
+      layout.site_stride = link_bytes;
+      return true;
+    case QUDA_MILC_GAUGE_ORDER:
+      for (int d = 0; d < 4; d++) layout.base[d] = u.data<char *>() + d * link_bytes;
+      layout.parity_stride = volume_cb * 4 * link_bytes;
+      layout.site_stride = 4 * link_bytes;
+      layout.dir_major = false;
+      return true;
+    case QUDA_MILC_SITE_GAUGE_ORDER:
+      for (int d = 0; d < 4; d++) layout.base[d] = u.data<char *>() + u.SiteOffset() + d * link_bytes;
+      layout.parity_stride = volume_cb * u.SiteSize();
+      layout.site_stride = u.SiteSize();
+      layout.dir_major = false;
+      return true;
+#ifdef BUILD_BQCD_INTERFACE
+    case QUDA_BQCD_GAUGE_ORDER: {
+      size_t ex_volume_cb = u.X()[0] / 2 + 2;
+      for (int i = 1; i < 4; i++) ex_volume_cb *= u.X()[i] + 2;
+      for (int d = 0; d < 4; d++) layout.base[d] = u.data<char *>() + d * 2 * ex_volume_cb * link_bytes;
+      layout.parity_stride = ex_volume_cb * link_bytes;
+      layout.site_stride = link_bytes;
+      layout.transpose = true;
+      return true;
+    }
+#endif
+#ifdef BUILD_TIFR_INTERFACE
+    case QUDA_TIFR_GAUGE_ORDER:
+    case QUDA_TIFR_PADDED_GAUGE_ORDER: {
+      layout.z_padded = u.Order() == QUDA_TIFR_PADDED_GAUGE_ORDER;
+      const size_t ex_volume_cb = layout.z_padded ? volume_cb / u.X()[2] * (u.X()[2] + 4) : volume_cb;
+      for (int d = 0; d < 4; d++) layout.base[d] = u.data<char *>() + d * 2 * ex_volume_cb * link_bytes;
+      layout.parity_stride = ex_volume_cb * link_bytes;
+      layout.site_stride = link_bytes;
+      layout.transpose = true;
+      layout.scale = u.Scale();
+      return true;
+    }
+#endif
+    default: return false;
+    }
+  }
+
+  /**
+     @brief Store a link, using non-temporal stores if requested
+     @param[out] dst The destination link
+     @param[in] src The link to be stored
+     @param[in] stream Whether to use non-temporal stores
+   */
+  template <typename T> inline void store_link(char *dst, const T (&src)[18], bool stream)
+  {
+#ifdef QUDA_STREAMING_STORES
+    if (stream) {
+      constexpr size_t n_word = 18 * sizeof(T) / sizeof(long long);
+      static_assert(18 * sizeof(T) % sizeof(long long) == 0, "link size must be a multiple of 8 bytes");
+      for (size_t i = 0; i < n_word; i++) {
+        long long word;
+        memcpy(&word, reinterpret_cast<const char *>(src) + i * sizeof(long long), sizeof(long long));
+        _mm_stream_si64(reinterpret_cast<long long *>(dst) + i, word);
+      }
+      return;
+    }
+#endif
+    memcpy(dst, src, sizeof(src));
+  }
+
+  template <typename Out, typename In>
+  void reorder(const LinkLayout &out, const LinkLayout &in, const lat_dim_t &X, size_t volume_cb, bool stream)
+  {
+    const size_t row_length = X[0] / 2;
+    const size_t n_row = volume_cb / row_length;
+    const bool transpose = out.transpose != in.transpose;
+    const double scale = out.scale / in.scale;
+
+    auto copy_link = [&](int d, int parity, size_t out_site, size_t in_site) {
+      const In *src = reinterpret_cast<const In *>(in.link(d, parity, in_site));
+      Out v[18];
+      if (transpose) {
+        for (int i = 0; i < 3; i++)
+          for (int j = 0; j < 3; j++)
+            for (int c = 0; c < 2; c++) v[(i * 3 + j) * 2 + c] = src[(j * 3 + i) * 2 + c] * scale;
+      } else {
+        for (int i = 0; i < 18; i++) v[i] = src[i] * scale;
+      }
+      store_link(out.link(d, parity, out_site), v, stream);
+    };
+
+    thread_pool::parallel_for(2 * n_row, 0, [&](size_t begin, size_t end) {
+      for (size_t r = begin; r < end; r++) {
+        const int parity = r / n_row;
+        const size_t out_site = out.row_site(r % n_row, X);
+        const size_t in_site = in.row_site(r % n_row, X);
+
+        // traverse the tile in the order the destination is laid out
+        if (out.dir_major) {
+          for (int d = 0; d < 4; d++)
+            for (size_t x = 0; x < row_length; x++) copy_link(d, parity, out_site + x, in_site + x);
+        } else {
+          for (size_t x = 0; x < row_length; x++)
+            for (int d = 0; d < 4; d++) copy_link(d, parity, out_site + x, in_site + x);
+        }
+      }
+#ifdef QUDA_STREAMING_STORES
+      if (stream) _mm_sfence();
+#endif
+    });
+  }
+
+  bool reorderGaugeHost(GaugeField &out, const GaugeField &in)
+  {
+    static const bool enabled = [] {
+      char *enable_env = getenv("QUDA_ENABLE_HOST_GAUGE_REORDER");
+      return !(enable_env && strcmp(enable_env, "0") == 0);
+    }();
+    if (!enabled) return false;
+
+    if (out.Location() != QUDA_CPU_FIELD_LOCATION || in.Location() != QUDA_CPU_FIELD_LOCATION) return false;
+    if (out.Ncolor() != 3 || in.Ncolor() != 3) return false;
+    if (out.Reconstruct() != QUDA_RECONSTRUCT_NO || in.Reconstruct() != QUDA_RECONSTRUCT_NO) return false;
+    if (out.Geometry() != QUDA_VECTOR_GEOMETRY || in.Geometry() != QUDA_VECTOR_GEOMETRY) return false;
+    if (out.LinkType() == QUDA_ASQTAD_MOM_LINKS || in.LinkType() == QUDA_ASQTAD_MOM_LINKS) return false;
+    if (out.GhostExchange() == QUDA_GHOST_EXCHANGE_EXTENDED || in.GhostExchange() == QUDA_GHOST_EXCHANGE_EXTENDED)
+      return false;
+    if (out.Ndim() != 4 || in.Ndim() != 4) return false;
+    for (int d = 0; d < 4; d++)
+      if (out.X()[d] != in.X()[d]) return false;
+    for (auto prec : {out.Precision(), in.Precision()})
+      if (prec != QUDA_DOUBLE_PRECISION && prec != QUDA_SINGLE_PRECISION) return false;
+
+    LinkLayout out_layout, in_layout;
+    if (!get_layout(out, out_layout) || !get_layout(in, in_layout)) return false;
+
+    // only stream if the destination will not fit in cache and all link addresses are 8-byte aligned
+    constexpr size_t stream_threshold = 16 << 20;
+    bool stream = out.Bytes() > stream_threshold && out_layout.parity_stride % 8 == 0 && out_layout.site_stride % 8 == 0;
+    for (int d = 0; d < 4; d++) stream = stream && reinterpret_cast<uintptr_t>(out_layout.base[d]) % 8 == 0;
+
+    logQuda(QUDA_DEBUG_VERBOSE, "Host gauge reorder from order %d to order %d%s\n", in.Order(), out.Order(),
+            stream ? " with streaming stores" : "");
+
+    if (out.Precision() == QUDA_DOUBLE_PRECISION) {
+      if (in.Precision() == QUDA_DOUBLE_PRECISION)
+        reorder<double, double>(out_layout, in_layout, in.X(), in.VolumeCB(), stream);
+      else
+        reorder<double, float>(out_layout, in_layout, in.X(), in.VolumeCB(), stream);
+    } else {
+      if (in.Precision() == QUDA_DOUBLE_PRECISION)
+        reorder<float, double>(out_layout, in_layout, in.X(), in.VolumeCB(), stream);
+      else
+        reorder<float, float>(out_layout, in_layout, in.X(), in.VolumeCB(), stream);
+    }
+
+    return true;
+  }
+
+} // namespace quda
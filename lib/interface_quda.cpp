@@ -62,6 +62,7 @@ void checkBLASParam(QudaBLASParam &param) { checkBLASParam(&param); }
 #include <gauge_tools.h>
 #include <contract_quda.h>
 #include <momentum.h>
+#include <memory_profile.h>
 
 using namespace quda;
 
@@ -390,6 +391,7 @@ void initCommsGridQuda(int nDim, const int *dims, QudaCommsMap func, void *fdata
 #endif
 
   comms_initialized = true;
+  trace::init();
 }
 
 
@@ -1340,18 +1342,23 @@ void endQuda(void)
     blas_lapack::generic::destroy();
     blas_lapack::native::destroy();
     reducer::destroy();
+    flushGeoMapCache();
 
     pool::flush_pinned();
     pool::flush_device();
+    pool::flush_host();
 
     host_free(num_failures_h);
     num_failures_h = nullptr;
     num_failures_d = nullptr;
 
     destroyDslashEvents();
+    destroyLaunchEvents();
 
     saveTuneCache();
     saveProfile();
+    trace::dump();
+    memory_profile::dump();
 
     // flush any outstanding force monitoring (if enabled)
     flushForceMonitor();
@@ -1403,6 +1410,7 @@ void endQuda(void)
 
     printfQuda("\n");
     printPeakMemUsage();
+    FieldTmp<ColorSpinorField>::print_stats();
     printfQuda("\n");
   }
 
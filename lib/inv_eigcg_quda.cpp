@@ -1,6 +1,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
+#include <functional>
+#include <future>
 #include <memory>
 #include <iostream>
 
@@ -38,6 +40,35 @@ namespace quda {
 
    enum  class libtype {eigen_lib, lapack_lib, mkl_lib};
 
+   /**
+      Persistent dense workspace for the eigCG Rayleigh-Ritz restarts.
+      All the restart matrices are allocated once, with the
+      factorizations constructed at their problem size, so that their
+      storage is reused from cycle to cycle.
+   */
+   struct EigCGWorkspace {
+     SelfAdjointEigenSolver<DenseMatrix> es_tm;  // eigensolver for T[m, m]
+     SelfAdjointEigenSolver<DenseMatrix> es_tm1; // eigensolver for T[m-1, m-1]
+     SelfAdjointEigenSolver<DenseMatrix> es_h2k; // eigensolver for the projected 2k x 2k matrix
+     HouseholderQR<DenseMatrix> qr;              // orthonormalization of the 2k Ritz vectors
+     Vector qr_workspace;
+     DenseMatrix Q2k;                            // orthonormal basis of the 2k Ritz vectors
+     DenseMatrix TmQ;                            // Tm * Q2k
+     RowMajorDenseMatrix Alpha;                  // row-major copy of the Ritz vectors for the basis rotation
+
+     EigCGWorkspace(int m, int k) :
+       es_tm(m),
+       es_tm1(m - 1),
+       es_h2k(2 * k),
+       qr(m, 2 * k),
+       qr_workspace(2 * k),
+       Q2k(m, 2 * k),
+       TmQ(m, 2 * k),
+       Alpha(m, 2 * k)
+     {
+     }
+   };
+
    class EigCGArgs
    {
 
@@ -63,6 +94,10 @@ namespace quda {
      ColorSpinorFieldSet
        *V2k; // eigCG accumulation vectors needed to update Tm (spinor matrix of size eigen_vector_length x (2*k))
 
+     EigCGWorkspace work;
+
+     std::future<void> ritz; // Rayleigh-Ritz step computed concurrently with the following CG iteration
+
      EigCGArgs(int m, int k) :
        Tm(DenseMatrix::Zero(m, m)),
        ritzVecs(VectorSet::Zero(m, m)),
@@ -74,15 +109,25 @@ namespace quda {
        restarts(0),
        global_stop(0.0),
        run_residual_correction(false),
-       V2k(nullptr)
+       V2k(nullptr),
+       work(m, k)
      {
      }
 
      ~EigCGArgs()
      {
+       Wait();
        if (V2k) delete V2k;
      }
 
+     /**
+        @brief Wait for any outstanding Rayleigh-Ritz computation
+     */
+     inline void Wait()
+     {
+       if (ritz.valid()) ritz.get();
+     }
+
      // method for constructing Lanczos matrix :
      inline void SetLanczos(Complex diag_val, Complex offdiag_val)
      {
@@ -102,6 +147,7 @@ namespace quda {
 
      inline void ResetArgs()
      {
+       Wait();
        id = 0;
        Tm.setZero();
        Tmvals.setZero();
@@ -148,29 +194,47 @@ namespace quda {
    {
      const int m = args.m;
      const int k = args.k;
-     //Solve m dim eigenproblem:
-     SelfAdjointEigenSolver<MatrixXcd> es_tm(args.Tm);
-     args.ritzVecs.leftCols(k) = es_tm.eigenvectors().leftCols(k);
-     //Solve m-1 dim eigenproblem:
-     SelfAdjointEigenSolver<MatrixXcd> es_tm1(Map<MatrixXcd, Unaligned, DynamicStride >(args.Tm.data(), (m-1), (m-1), DynamicStride(m, 1)));
-     Block<MatrixXcd>(args.ritzVecs.derived(), 0, k, m-1, k) = es_tm1.eigenvectors().leftCols(k);
+     EigCGWorkspace &w = args.work;
+
+     //Solve the m and m-1 dim eigenproblems concurrently:
+     thread_pool::parallel_for(2, 1, [&](size_t begin, size_t) {
+       if (begin == 0)
+         w.es_tm.compute(args.Tm);
+       else
+         w.es_tm1.compute(args.Tm.topLeftCorner(m - 1, m - 1));
+     });
+     args.ritzVecs.leftCols(k) = w.es_tm.eigenvectors().leftCols(k);
+     args.ritzVecs.block(0, k, m - 1, k) = w.es_tm1.eigenvectors().leftCols(k);
      args.ritzVecs.block(m-1, k, 1, k).setZero();
 
-     MatrixXcd Q2k(MatrixXcd::Identity(m, 2*k));
-     HouseholderQR<MatrixXcd> ritzVecs2k_qr( Map<MatrixXcd, Unaligned >(args.ritzVecs.data(), m, 2*k) );
-     Q2k.applyOnTheLeft( ritzVecs2k_qr.householderQ() );
+     w.qr.compute(args.ritzVecs.leftCols(2 * k));
+     w.Q2k.setIdentity();
+     w.qr.householderQ().applyThisOnTheLeft(w.Q2k, w.qr_workspace);
 
      //2. Construct H = QH*Tm*Q :
-     args.H2k = Q2k.adjoint()*args.Tm*Q2k;
+     parallel_product(w.TmQ, args.Tm, w.Q2k);
+     parallel_product(args.H2k, w.Q2k.adjoint(), w.TmQ);
 
      /* solve the small evecm1 2n_ev x 2n_ev eigenproblem */
-     SelfAdjointEigenSolver<MatrixXcd> es_h2k(args.H2k);
-     Block<MatrixXcd>(args.ritzVecs.derived(), 0, 0, m, 2*k) = Q2k * es_h2k.eigenvectors();
-     args.Tmvals.segment(0,2*k) = es_h2k.eigenvalues();//this is ok
+     w.es_h2k.compute(args.H2k);
+     parallel_product(args.ritzVecs.leftCols(2 * k), w.Q2k, w.es_h2k.eigenvectors());
+     args.Tmvals.segment(0,2*k) = w.es_h2k.eigenvalues();//this is ok
 
      return;
    }
 
+   /**
+      @brief Run the Rayleigh-Ritz procedure with the requested library
+   */
+   static void RayleighRitz(EigCGArgs &args, QudaExtLibType extlib_type)
+   {
+     if (extlib_type == QUDA_EIGEN_EXTLIB) {
+       ComputeRitz<libtype::eigen_lib>(args);//if args.m > 128, one may better use libtype::magma_lib
+     } else {
+       errorQuda("Library type %d is currently not supported.", extlib_type);
+     }
+   }
+
   // set the required parameters for the inner solver
   static void fillEigCGInnerSolverParam(SolverParam &inner, const SolverParam &outer, bool use_sloppy_partial_accumulator = true)
   {
@@ -276,11 +340,11 @@ namespace quda {
   {
     EigCGArgs &args = *eigcg_args;
 
-    if( param.extlib_type == QUDA_EIGEN_EXTLIB ) {
-      ComputeRitz<libtype::eigen_lib>(args);//if args.m > 128, one may better use libtype::magma_lib
-    } else {
-      errorQuda("Library type %d is currently not supported.", param.extlib_type);
-    }
+    // the Rayleigh-Ritz step is normally already in flight, see eigCGsolve
+    if (args.ritz.valid())
+      args.ritz.get();
+    else
+      RayleighRitz(args, param.extlib_type);
 
     //Restart V:
 
@@ -289,7 +353,8 @@ namespace quda {
     std::vector<ColorSpinorField*> vm (Vm->Components());
     std::vector<ColorSpinorField*> v2k(args.V2k->Components());
 
-    RowMajorDenseMatrix Alpha(args.ritzVecs.topLeftCorner(args.m, 2*args.k));
+    RowMajorDenseMatrix &Alpha = args.work.Alpha;
+    Alpha = args.ritzVecs.topLeftCorner(args.m, 2*args.k);
     blas::legacy::caxpy(static_cast<Complex *>(Alpha.data()), vm, v2k);
 
     for(int i = 0; i < 2*args.k; i++)  blas::copy(Vm->Component(i), args.V2k->Component(i));
@@ -492,6 +557,11 @@ namespace quda {
       lanczos_offdiag  = (-sqrt(beta)*alpha_inv);
       args.SetLanczos(lanczos_diag, lanczos_offdiag);
 
+      // the Lanczos matrix is complete, so run the Rayleigh-Ritz step on the host while the next iteration
+      // runs on the device, up to the restart in UpdateVm
+      if (args.id == param.m && !args.run_residual_correction)
+        args.ritz = std::async(std::launch::async, RayleighRitz, std::ref(args), param.extlib_type);
+
       k++;
 
       PrintStats("eigCG", k, r2, b2, heavy_quark_res);
@@ -13,6 +13,8 @@
 
 
 #include <algorithm>
+#include <functional>
+#include <future>
 #include <memory>
 
 #include <eigen_helper.h>
@@ -48,6 +50,47 @@ namespace quda {
 
   enum class libtype { eigen_lib, lapack_lib, mkl_lib };
 
+  /**
+     Persistent dense workspace for the GMRES-DR restarts.  All the
+     restart matrices are allocated once, with the factorizations
+     constructed at their problem size, so that their storage is
+     reused from cycle to cycle.
+  */
+  struct GMResDRWorkspace {
+    DenseMatrix cH;                       // adjoint of the leading m x m block of H
+    DenseMatrix Gk;                       // matrix whose eigenvectors are the harmonic Ritz vectors
+    Vector em;                            // scaled unit vector e_m
+    ColPivHouseholderQR<DenseMatrix> cH_qr;
+    ComplexEigenSolver<DenseMatrix> es;   // harmonic Ritz eigensolver
+    std::vector<SortedEvals> sorted_evals;
+    JacobiSVD<DenseMatrix> svd;           // least squares solver for eta
+    Vector minusHeta;
+    HouseholderQR<DenseMatrix> qr;        // orthonormalization of the k + 1 restart vectors
+    Vector qr_workspace;
+    DenseMatrix Qkp1;                     // orthonormal restart basis, (m + 1) x (k + 1)
+    DenseMatrix HQ;                       // H * Qkp1 restricted to the first k columns
+    RowMajorDenseMatrix Alpha;            // row-major copy of Qkp1 for the basis rotation
+    RowMajorDenseMatrix Beta;             // row-major copy of the leading m x k block of Qkp1
+
+    GMResDRWorkspace(int m, int k) :
+      cH(m, m),
+      Gk(m, m),
+      em(m),
+      cH_qr(m, m),
+      es(m),
+      svd(m + 1, m, ComputeThinU | ComputeThinV),
+      minusHeta(m + 1),
+      qr(m + 1, k + 1),
+      qr_workspace(k + 1),
+      Qkp1(m + 1, k + 1),
+      HQ(m + 1, k),
+      Alpha(m + 1, k + 1),
+      Beta(m, k)
+    {
+      sorted_evals.reserve(m);
+    }
+  };
+
   class GMResDRArgs
   {
 
@@ -64,6 +107,10 @@ namespace quda {
 
     ColorSpinorFieldSet *Vkp1; // high-precision accumulation array
 
+    GMResDRWorkspace work;
+
+    std::future<void> harmonic_ritz; // harmonic Ritz vectors computed concurrently with the end of a cycle
+
     GMResDRArgs(int m, int nev) :
       ritzVecs(VectorSet::Zero(m + 1, nev + 1)),
       H(DenseMatrix::Zero(m + 1, m)),
@@ -71,13 +118,23 @@ namespace quda {
       m(m),
       k(nev),
       restarts(0),
-      Vkp1(nullptr)
+      Vkp1(nullptr),
+      work(m, nev)
     {
       c = static_cast<Complex *>(ritzVecs.col(k).data());
     }
 
+    /**
+       @brief Wait for any outstanding harmonic Ritz computation
+    */
+    inline void Wait()
+    {
+      if (harmonic_ritz.valid()) harmonic_ritz.get();
+    }
+
     inline void ResetArgs()
     {
+      Wait();
       ritzVecs.setZero();
       H.setZero();
       eta.setZero();
@@ -85,6 +142,7 @@ namespace quda {
 
     ~GMResDRArgs()
     {
+      Wait();
       if (Vkp1) delete Vkp1;
     }
   };
@@ -93,41 +151,50 @@ namespace quda {
 
   template <> void ComputeHarmonicRitz<libtype::eigen_lib>(GMResDRArgs &args)
   {
+    GMResDRWorkspace &w = args.work;
 
-    DenseMatrix cH = args.H.block(0, 0, args.m, args.m).adjoint();
-    DenseMatrix Gk = args.H.block(0, 0, args.m, args.m);
-
-    VectorSet harVecs = MatrixXcd::Zero(args.m, args.m);
-    Vector harVals = VectorXcd::Zero(args.m);
+    w.cH = args.H.block(0, 0, args.m, args.m).adjoint();
+    w.Gk = args.H.block(0, 0, args.m, args.m);
 
-    Vector em = VectorXcd::Zero(args.m);
+    w.em.setZero();
+    w.em(args.m - 1) = norm(args.H(args.m, args.m - 1));
+    w.cH_qr.compute(w.cH);
+    w.Gk.col(args.m - 1) += w.cH_qr.solve(w.em);
 
-    em(args.m - 1) = norm(args.H(args.m, args.m - 1));
-    Gk.col(args.m - 1) += cH.colPivHouseholderQr().solve(em);
-
-    ComplexEigenSolver<DenseMatrix> es(Gk);
-    harVecs = es.eigenvectors();
-    harVals = es.eigenvalues();
-
-    std::vector<SortedEvals> sorted_evals;
-    sorted_evals.reserve(args.m);
+    w.es.compute(w.Gk);
+    const auto &harVecs = w.es.eigenvectors();
+    const auto &harVals = w.es.eigenvalues();
 
-    for (int e = 0; e < args.m; e++) sorted_evals.push_back(SortedEvals(abs(harVals.data()[e]), e));
-    std::stable_sort(sorted_evals.begin(), sorted_evals.end(), SortedEvals::SelectSmall);
+    w.sorted_evals.clear();
+    for (int e = 0; e < args.m; e++) w.sorted_evals.push_back(SortedEvals(abs(harVals.data()[e]), e));
+    std::stable_sort(w.sorted_evals.begin(), w.sorted_evals.end(), SortedEvals::SelectSmall);
 
     for (int e = 0; e < args.k; e++)
-      memcpy(args.ritzVecs.col(e).data(), harVecs.col(sorted_evals[e]._idx).data(), (args.m) * sizeof(Complex));
+      memcpy(args.ritzVecs.col(e).data(), harVecs.col(w.sorted_evals[e]._idx).data(), (args.m) * sizeof(Complex));
 
     return;
   }
 
+  /**
+     @brief Compute the harmonic Ritz vectors with the requested library
+  */
+  static void HarmonicRitz(GMResDRArgs &args, QudaExtLibType extlib_type)
+  {
+    if (extlib_type == QUDA_EIGEN_EXTLIB) {
+      ComputeHarmonicRitz<libtype::eigen_lib>(args);
+    } else {
+      errorQuda("Library type %d is currently not supported.\n", extlib_type);
+    }
+  }
+
   template <libtype which_lib> void ComputeEta(GMResDRArgs &) { errorQuda("\nUnknown library type.\n"); }
 
   template <> void ComputeEta<libtype::eigen_lib>(GMResDRArgs &args)
   {
 
     Map<VectorXcd, Unaligned> c_(args.c, args.m + 1);
-    args.eta = args.H.jacobiSvd(ComputeThinU | ComputeThinV).solve(c_);
+    args.work.svd.compute(args.H);
+    args.eta = args.work.svd.solve(c_);
 
     return;
   }
@@ -235,7 +302,8 @@ namespace quda {
 
     blas::legacy::caxpy(static_cast<Complex *>(args.eta.data()), Z_, x_);
 
-    VectorXcd minusHeta = -(args.H * args.eta);
+    Vector &minusHeta = args.work.minusHeta;
+    minusHeta.noalias() = -(args.H * args.eta);
     Map<VectorXcd, Unaligned> c_(args.c, args.m + 1);
     c_ += minusHeta;
 
@@ -245,29 +313,29 @@ namespace quda {
   void GMResDR::RestartVZH()
   {
     GMResDRArgs &args = *gmresdr_args;
+    GMResDRWorkspace &w = args.work;
 
-    if (param.extlib_type == QUDA_EIGEN_EXTLIB) {
-      ComputeHarmonicRitz<libtype::eigen_lib>(args);
-    } else {
-      errorQuda("Library type %d is currently not supported.\n", param.extlib_type);
-    }
-
-    DenseMatrix Qkp1(MatrixXcd::Identity((args.m + 1), (args.k + 1)));
+    // the harmonic Ritz vectors may already be in flight, see operator()
+    if (args.harmonic_ritz.valid())
+      args.harmonic_ritz.get();
+    else
+      HarmonicRitz(args, param.extlib_type);
 
-    HouseholderQR<MatrixXcd> qr(args.ritzVecs);
-    Qkp1.applyOnTheLeft(qr.householderQ());
+    w.qr.compute(args.ritzVecs);
+    w.Qkp1.setIdentity();
+    w.qr.householderQ().applyThisOnTheLeft(w.Qkp1, w.qr_workspace);
 
-    DenseMatrix Res = Qkp1.adjoint() * args.H * Qkp1.topLeftCorner(args.m, args.k);
+    parallel_product(w.HQ, args.H, w.Qkp1.topLeftCorner(args.m, args.k));
     args.H.setZero();
-    args.H.topLeftCorner(args.k + 1, args.k) = Res;
+    parallel_product(args.H.topLeftCorner(args.k + 1, args.k), w.Qkp1.adjoint(), w.HQ);
 
     blas::zero(*args.Vkp1);
 
     std::vector<ColorSpinorField *> vkp1(args.Vkp1->Components());
     std::vector<ColorSpinorField *> vm(Vm->Components());
 
-    RowMajorDenseMatrix Alpha(Qkp1); // convert Qkp1 to Row-major format first
-    blas::legacy::caxpy(static_cast<Complex *>(Alpha.data()), vm, vkp1);
+    w.Alpha = w.Qkp1; // convert Qkp1 to Row-major format first
+    blas::legacy::caxpy(static_cast<Complex *>(w.Alpha.data()), vm, vkp1);
 
     for (int i = 0; i < (args.m + 1); i++) {
       if (i < (args.k + 1)) {
@@ -281,8 +349,8 @@ namespace quda {
       std::vector<ColorSpinorField *> z(Zm->Components());
       std::vector<ColorSpinorField *> vk(args.Vkp1->Components().begin(), args.Vkp1->Components().begin() + args.k);
 
-      RowMajorDenseMatrix Beta(Qkp1.topLeftCorner(args.m, args.k));
-      blas::legacy::caxpy(static_cast<Complex *>(Beta.data()), z, vk);
+      w.Beta = w.Qkp1.topLeftCorner(args.m, args.k);
+      blas::legacy::caxpy(static_cast<Complex *>(w.Beta.data()), z, vk);
 
       for (int i = 0; i < (args.m); i++) {
         if (i < (args.k))
@@ -477,6 +545,12 @@ namespace quda {
 
     while (restart_idx < param.deflation_grid && !(convergence(r2, heavy_quark_res, stop, param.tol_hq) || !(r2 > stop))) {
       tot_iters += FlexArnoldiProcedure(j, (j == 0));
+
+      // H is now final for this cycle, so unless this is the last cycle compute the harmonic Ritz vectors
+      // on the host while the solution update and the restart checks run on the device
+      if (restart_idx != param.deflation_grid - 1)
+        args.harmonic_ritz = std::async(std::launch::async, HarmonicRitz, std::ref(args), param.extlib_type);
+
       UpdateSolution(&e, r_sloppy, !(j == 0));
 
       r2 = norm2(rSloppy);
@@ -537,6 +611,8 @@ namespace quda {
       restart_idx += 1;
     }
 
+    args.Wait();
+
     // final solution:
     xpy(e, x);
 
@@ -0,0 +1,248 @@
+#include <cmath>
+
+#include <blas_quda.h>
+#include <invert_quda.h>
+#include <util_quda.h>
+
+/**
+   @file inv_pipe_cg_quda.cpp
+
+   @section Description
+
+   Pipelined conjugate gradient (Ghysels and Vanroose, Parallel
+   Computing 40, 224 (2014)).  The recurrences of CG are rearranged so
+   that the two inner products of each iteration are independent of
+   the matrix-vector product of that iteration: the global reduction
+   of the inner products is started with a non-blocking allreduce, and
+   is completed after the matrix-vector product, hiding its latency.
+   The additional recurrences reduce the attainable accuracy, so the
+   residual is periodically replaced by the true residual, with the
+   reliable-update criterion of CG, and the recurrences restarted.
+ */
+
+namespace quda
+{
+
+  PipeCG::PipeCG(const DiracMatrix &mat, const DiracMatrix &matSloppy, const DiracMatrix &matPrecon,
+                 SolverParam &param) :
+    Solver(mat, matSloppy, matPrecon, matPrecon, param)
+  {
+  }
+
+  void PipeCG::create(ColorSpinorField &x, const ColorSpinorField &b)
+  {
+    Solver::create(x, b);
+
+    if (!init) {
+      ColorSpinorParam csParam(b);
+      csParam.create = QUDA_ZERO_FIELD_CREATE;
+      r = ColorSpinorField(csParam);
+      y = ColorSpinorField(csParam);
+
+      // Sloppy fields
+      const bool mixed_precision = (param.precision != param.precision_sloppy);
+      csParam.setPrecision(param.precision_sloppy);
+      rS = mixed_precision ? ColorSpinorField(csParam) : r.create_alias();
+      xS = mixed_precision ? ColorSpinorField(csParam) : x.create_alias();
+      wS = ColorSpinorField(csParam);
+      qS = ColorSpinorField(csParam);
+      zS = ColorSpinorField(csParam);
+      sS = ColorSpinorField(csParam);
+      pS = ColorSpinorField(csParam);
+
+      init = true;
+    }
+  }
+
+  ColorSpinorField &PipeCG::get_residual()
+  {
+    if (!init) errorQuda("No residual vector present");
+    return r;
+  }
+
+  void PipeCG::operator()(ColorSpinorField &x, ColorSpinorField &b)
+  {
+    if (param.residual_type & QUDA_HEAVY_QUARK_RESIDUAL) errorQuda("Heavy-quark residual not supported");
+
+    if (param.is_preconditioner) commGlobalReductionPush(param.global_reduction);
+
+    // the inner products are only reduced across ranks if global reduction is enabled on entry, so that as a
+    // preconditioner or smoother the solver remains local to each rank
+    const bool global_reduction = commGlobalReduction();
+
+    if (!param.is_preconditioner) getProfile().TPSTART(QUDA_PROFILE_PREAMBLE);
+
+    // Check to see that we're not trying to invert on a zero-field source
+    double b2 = blas::norm2(b);
+    if (b2 == 0
+        && (param.compute_null_vector == QUDA_COMPUTE_NULL_VECTOR_NO || param.use_init_guess == QUDA_USE_INIT_GUESS_NO)) {
+      if (!param.is_preconditioner) getProfile().TPSTOP(QUDA_PROFILE_PREAMBLE);
+      printfQuda("Warning: inverting on zero-field source\n");
+      x = b;
+      param.true_res = 0.0;
+      param.true_res_hq = 0.0;
+      if (param.is_preconditioner) commGlobalReductionPop();
+      return;
+    }
+
+    const bool mixed_precision = (param.precision != param.precision_sloppy);
+    create(x, b);
+
+    // compute initial residual depending on whether we have an initial guess or not
+    double r2;
+    if (param.use_init_guess == QUDA_USE_INIT_GUESS_YES) {
+      mat(r, x);
+      r2 = blas::xmyNorm(b, r);
+      if (b2 == 0) b2 = r2;
+      if (mixed_precision) {
+        blas::copy(y, x);
+        blas::zero(xS);
+      }
+    } else {
+      blas::copy(r, b);
+      r2 = b2;
+      blas::zero(x);
+      if (mixed_precision) {
+        blas::zero(y);
+        blas::zero(xS);
+      }
+    }
+    blas::copy(rS, r);
+
+    double stop = stopping(param.tol, b2, param.residual_type); // stopping condition of solver
+
+    // this parameter determines how many consective reliable update
+    // residual increases we tolerate before terminating the solver
+    const int maxResIncrease = param.max_res_increase;
+    const int maxResIncreaseTotal = param.max_res_increase_total;
+    int resIncrease = 0;
+    int resIncreaseTotal = 0;
+
+    if (!param.is_preconditioner) getProfile().TPSTOP(QUDA_PROFILE_PREAMBLE);
+    if (convergence(r2, 0.0, stop, 0.0)) {
+      if (param.is_preconditioner) commGlobalReductionPop();
+      return;
+    }
+    if (!param.is_preconditioner) getProfile().TPSTART(QUDA_PROFILE_COMPUTE);
+
+    matSloppy(wS, rS);
+
+    double r0Norm = sqrt(r2);
+    double maxrr = r0Norm;
+    double alpha = 0.0;
+    double gamma = 0.0;
+    bool restart = true; // whether the recurrences are to be (re)started
+    int k = 0;
+
+    PrintStats("PipeCG", k, r2, b2, 0.0);
+
+    while (k < param.maxiter) {
+      // start the reduction of gamma = (r, r) and delta = (w, r), and overlap it with q = A w
+      commGlobalReductionPush(false);
+      double3 local = blas::cDotProductNormA(rS, wS)[0];
+      commGlobalReductionPop();
+      double reduce[2] = {local.z, local.x};
+      ReduceHandle *rh = global_reduction ? comm_iallreduce_sum_array(reduce, 2) : nullptr;
+
+      matSloppy(qS, wS);
+
+      if (rh) comm_iallreduce_wait(rh);
+      const double gamma_old = gamma;
+      gamma = reduce[0];
+      const double delta = reduce[1];
+      r2 = gamma;
+
+      const double rNorm = sqrt(r2);
+      if (rNorm > maxrr) maxrr = rNorm;
+
+      // replace the residual with the true residual if it has converged, or if it has decreased sufficiently
+      bool update = convergence(r2, 0.0, stop, 0.0) || (!restart && rNorm < param.delta * maxrr);
+      if (update) {
+        if (mixed_precision) {
+          blas::xpy(xS, y);
+          blas::zero(xS);
+          mat(r, y);
+        } else {
+          mat(r, x);
+        }
+        r2 = blas::xmyNorm(b, r);
+        param.true_res = sqrt(r2 / b2);
+
+        // break-out check if we have reached the limit of the precision
+        if (sqrt(r2) > r0Norm) {
+          resIncrease++;
+          resIncreaseTotal++;
+          warningQuda("PipeCG: new reliable residual norm %e is greater than previous reliable residual norm %e (total "
+                      "#inc %i)",
+                      sqrt(r2), r0Norm, resIncreaseTotal);
+          if (resIncrease > maxResIncrease or resIncreaseTotal > maxResIncreaseTotal) {
+            warningQuda("PipeCG: solver exiting due to too many true residual norm increases");
+            break;
+          }
+        } else {
+          resIncrease = 0;
+        }
+
+        r0Norm = sqrt(r2);
+        maxrr = r0Norm;
+        if (convergence(r2, 0.0, stop, 0.0)) break;
+
+        // restart the recurrences from the true residual
+        blas::copy(rS, r);
+        matSloppy(wS, rS);
+        restart = true;
+        continue;
+      }
+
+      double beta;
+      if (restart) {
+        beta = 0.0;
+        alpha = gamma / delta;
+        restart = false;
+      } else {
+        beta = gamma / gamma_old;
+        alpha = gamma / (delta - beta * gamma / alpha);
+      }
+
+      // z = q + beta z, s = w + beta s, p = r + beta p
+      blas::xpay(qS, beta, zS);
+      blas::xpay(wS, beta, sS);
+      blas::xpay(rS, beta, pS);
+
+      // x = x + alpha p, r = r - alpha s, w = w - alpha z
+      blas::axpy(alpha, pS, xS);
+      blas::axpy(-alpha, sS, rS);
+      blas::axpy(-alpha, zS, wS);
+
+      k++;
+      PrintStats("PipeCG", k, r2, b2, 0.0);
+    }
+
+    if (mixed_precision) {
+      blas::xpy(xS, y);
+      blas::copy(x, y);
+    }
+
+    if (!param.is_preconditioner) {
+      getProfile().TPSTOP(QUDA_PROFILE_COMPUTE);
+      getProfile().TPSTART(QUDA_PROFILE_EPILOGUE);
+    }
+
+    param.iter += k;
+
+    if (k == param.maxiter) warningQuda("Exceeded maximum iterations %d", param.maxiter);
+
+    // compute the true residuals
+    if (param.compute_true_res) {
+      mat(r, x);
+      param.true_res = sqrt(blas::xmyNorm(b, r) / b2);
+    }
+
+    PrintSummary("PipeCG", k, r2, b2, stop, param.tol_hq);
+
+    if (!param.is_preconditioner) getProfile().TPSTOP(QUDA_PROFILE_EPILOGUE);
+
+    if (param.is_preconditioner) commGlobalReductionPop();
+  }
+
+} // namespace quda
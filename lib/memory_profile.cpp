@@ -0,0 +1,333 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <memory_profile.h>
+#include <comm_quda.h>
+#include <util_quda.h>
+
+namespace quda
+{
+
+  namespace memory_profile
+  {
+
+    /** Number of call sites retained in each peak snapshot */
+    constexpr size_t snapshot_sites = 16;
+
+    /** Relative growth of a peak at which a new snapshot is started */
+    constexpr double snapshot_growth = 1.1;
+
+    /** Maximum number of timeline samples retained */
+    constexpr size_t max_samples = 1 << 16;
+
+    struct Site {
+      int type;
+      std::string func;
+      std::string file;
+      int line;
+      size_t live = 0;      /** bytes presently allocated */
+      size_t peak_live = 0; /** peak bytes allocated */
+      size_t allocs = 0;    /** number of allocations */
+      size_t bytes = 0;     /** total bytes allocated */
+    };
+
+    /**
+       Call sites with the most live bytes at a peak of a type
+    */
+    struct Snapshot {
+      size_t start;  /** the peak at which the snapshot was started */
+      size_t bytes;  /** the peak of the latest update */
+      double time;   /** time of the latest update */
+      std::vector<std::pair<int, size_t>> sites; /** (site, live bytes) pairs */
+    };
+
+    struct Sample {
+      double time;
+      std::vector<size_t> bytes; /** total bytes of each type */
+    };
+
+    /**
+       Global profile state
+    */
+    struct Profile {
+      std::mutex mutex; /** protects the members below */
+      std::vector<std::string> types;
+      std::vector<Site> sites;
+      std::unordered_map<std::string, int> ids;
+      std::vector<size_t> total;
+      std::vector<size_t> peak;
+      std::vector<std::vector<Snapshot>> snapshots;
+      std::vector<Sample> timeline;
+      std::unordered_map<const void *, std::pair<int, size_t>> pooled; /** (site, bytes) of each pooled block */
+      double interval = 0.01;
+      double last_sample = -1.0;
+      std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+      bool enabled = false;
+
+      Profile()
+      {
+        char *enable_env = getenv("QUDA_ENABLE_MEMORY_PROFILE");
+        if (enable_env && strcmp(enable_env, "0")) enabled = true;
+        char *interval_env = getenv("QUDA_MEMORY_PROFILE_INTERVAL");
+        if (interval_env) interval = std::max(atof(interval_env), 0.0);
+      }
+
+      double now() const
+      {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - epoch).count();
+      }
+
+      /**
+         @brief Add a sample to the timeline if the interval has elapsed
+      */
+      void sample(double time)
+      {
+        if (last_sample >= 0.0 && time - last_sample < interval) return;
+        if (timeline.size() == max_samples) {
+          for (size_t i = 0; i < max_samples / 2; i++) timeline[i] = std::move(timeline[2 * i]);
+          timeline.resize(max_samples / 2);
+          interval *= 2;
+        }
+        timeline.push_back({time, total});
+        last_sample = time;
+      }
+
+      /**
+         @brief Update the peak snapshot of a type
+      */
+      void snapshot(int type, double time)
+      {
+        auto &list = snapshots[type];
+        if (list.empty() || peak[type] >= snapshot_growth * list.back().start) list.push_back({peak[type], 0, 0.0, {}});
+
+        Snapshot &s = list.back();
+        s.bytes = peak[type];
+        s.time = time;
+        s.sites.clear();
+        for (size_t i = 0; i < sites.size(); i++)
+          if (sites[i].type == type && sites[i].live > 0) s.sites.push_back({static_cast<int>(i), sites[i].live});
+        auto greater = [](const auto &a, const auto &b) { return a.second > b.second; };
+        if (s.sites.size() > snapshot_sites) {
+          std::partial_sort(s.sites.begin(), s.sites.begin() + snapshot_sites, s.sites.end(), greater);
+          s.sites.resize(snapshot_sites);
+        } else {
+          std::sort(s.sites.begin(), s.sites.end(), greater);
+        }
+      }
+    };
+
+    static Profile &get_profile()
+    {
+      static Profile *profile = new Profile; // never destroyed, so that it outlives any static allocations
+      return *profile;
+    }
+
+    bool enabled() { return get_profile().enabled; }
+
+    /**
+       @brief Return the id of a call site, with the mutex held
+    */
+    static int site_locked(Profile &profile, const char *type, const std::string &func, const std::string &file,
+                           int line)
+    {
+      auto type_it = std::find(profile.types.begin(), profile.types.end(), type);
+      const int type_id = type_it - profile.types.begin();
+      if (type_it == profile.types.end()) {
+        profile.types.push_back(type);
+        profile.total.push_back(0);
+        profile.peak.push_back(0);
+        profile.snapshots.emplace_back();
+        for (auto &s : profile.timeline) s.bytes.push_back(0);
+      }
+
+      std::string key = std::string(type) + ':' + file + ':' + std::to_string(line) + ':' + func;
+      auto it = profile.ids.find(key);
+      if (it != profile.ids.end()) return it->second;
+      const int id = profile.sites.size();
+      profile.sites.push_back({type_id, func, file, line});
+      profile.ids[key] = id;
+      return id;
+    }
+
+    /**
+       @brief Record an allocation, with the mutex held
+    */
+    static void allocate_locked(Profile &profile, int site, size_t bytes)
+    {
+      Site &s = profile.sites[site];
+      s.live += bytes;
+      s.peak_live = std::max(s.peak_live, s.live);
+      s.allocs++;
+      s.bytes += bytes;
+
+      const double time = profile.now();
+      profile.total[s.type] += bytes;
+      if (profile.total[s.type] > profile.peak[s.type]) {
+        profile.peak[s.type] = profile.total[s.type];
+        profile.snapshot(s.type, time);
+      }
+      profile.sample(time);
+    }
+
+    /**
+       @brief Record the release of an allocation, with the mutex held
+    */
+    static void free_locked(Profile &profile, int site, size_t bytes)
+    {
+      Site &s = profile.sites[site];
+      s.live -= bytes;
+      profile.total[s.type] -= bytes;
+      profile.sample(profile.now());
+    }
+
+    /**
+       @brief Return the id of the pseudo-site of the blocks cached by
+       the pools of the type of a site, with the mutex held
+    */
+    static int cached_site_locked(Profile &profile, int site)
+    {
+      return site_locked(profile, profile.types[profile.sites[site].type].c_str(), "(pool cached)", "", 0);
+    }
+
+    int site(const char *type, const std::string &func, const std::string &file, int line)
+    {
+      auto &profile = get_profile();
+      std::lock_guard<std::mutex> lock(profile.mutex);
+      return site_locked(profile, type, func, file, line);
+    }
+
+    void allocate(int site, size_t bytes)
+    {
+      auto &profile = get_profile();
+      std::lock_guard<std::mutex> lock(profile.mutex);
+      allocate_locked(profile, site, bytes);
+    }
+
+    void free(int site, size_t bytes)
+    {
+      auto &profile = get_profile();
+      std::lock_guard<std::mutex> lock(profile.mutex);
+      free_locked(profile, site, bytes);
+    }
+
+    void pool_allocate(const char *type, const char *func, const char *file, int line, const void *ptr, size_t bytes)
+    {
+      auto &profile = get_profile();
+      if (!profile.enabled) return;
+      std::lock_guard<std::mutex> lock(profile.mutex);
+
+      const int id = site_locked(profile, type, func, file, line);
+      auto it = profile.pooled.find(ptr);
+      if (it != profile.pooled.end()) { // a cached block keeps its size
+        bytes = it->second.second;
+        free_locked(profile, it->second.first, bytes);
+      }
+      allocate_locked(profile, id, bytes);
+      profile.pooled[ptr] = {id, bytes};
+    }
+
+    void pool_free(const void *ptr)
+    {
+      auto &profile = get_profile();
+      if (!profile.enabled) return;
+      std::lock_guard<std::mutex> lock(profile.mutex);
+
+      auto it = profile.pooled.find(ptr);
+      if (it == profile.pooled.end()) return;
+      auto &[id, bytes] = it->second;
+      const int cached = cached_site_locked(profile, id);
+      free_locked(profile, id, bytes);
+      allocate_locked(profile, cached, bytes);
+      id = cached;
+    }
+
+    void pool_trim(const void *ptr)
+    {
+      auto &profile = get_profile();
+      if (!profile.enabled) return;
+      std::lock_guard<std::mutex> lock(profile.mutex);
+
+      auto it = profile.pooled.find(ptr);
+      if (it == profile.pooled.end()) return;
+      free_locked(profile, it->second.first, it->second.second);
+      profile.pooled.erase(it);
+    }
+
+    /**
+       @brief Escape a string for inclusion in JSON
+    */
+    static std::string escape(const std::string &s)
+    {
+      std::string out;
+      for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+      }
+      return out;
+    }
+
+    void dump()
+    {
+      auto &profile = get_profile();
+      if (!profile.enabled) return;
+      std::lock_guard<std::mutex> lock(profile.mutex);
+
+      char *path = getenv("QUDA_RESOURCE_PATH");
+      const std::string profile_path = std::string(path ? path : ".") + "/memory_profile_rank"
+        + std::to_string(comm_rank_global()) + ".json";
+      std::ofstream file(profile_path);
+
+      auto site_string = [&](int i) {
+        const Site &s = profile.sites[i];
+        return "\"type\":\"" + escape(profile.types[s.type]) + "\",\"func\":\"" + escape(s.func) + "\",\"file\":\""
+          + escape(s.file) + "\",\"line\":" + std::to_string(s.line);
+      };
+
+      // call sites, in order of decreasing peak
+      std::vector<int> order(profile.sites.size());
+      for (size_t i = 0; i < order.size(); i++) order[i] = i;
+      std::stable_sort(order.begin(), order.end(),
+                       [&](int a, int b) { return profile.sites[a].peak_live > profile.sites[b].peak_live; });
+      file << "{\"sites\":[";
+      for (size_t i = 0; i < order.size(); i++) {
+        const Site &s = profile.sites[order[i]];
+        file << (i ? ",\n" : "\n") << "{" << site_string(order[i]) << ",\"live\":" << s.live
+             << ",\"peak_live\":" << s.peak_live << ",\"allocs\":" << s.allocs << ",\"bytes\":" << s.bytes << "}";
+      }
+
+      file << "\n],\"peaks\":[";
+      bool first = true;
+      for (size_t t = 0; t < profile.types.size(); t++) {
+        for (auto &snapshot : profile.snapshots[t]) {
+          file << (first ? "\n" : ",\n") << "{\"type\":\"" << escape(profile.types[t])
+               << "\",\"bytes\":" << snapshot.bytes << ",\"time\":" << snapshot.time << ",\"sites\":[";
+          for (size_t i = 0; i < snapshot.sites.size(); i++)
+            file << (i ? "," : "") << "{" << site_string(snapshot.sites[i].first)
+                 << ",\"live\":" << snapshot.sites[i].second << "}";
+          file << "]}";
+          first = false;
+        }
+      }
+
+      file << "\n],\"timeline\":{\"interval\":" << profile.interval << ",\"time\":[";
+      for (size_t i = 0; i < profile.timeline.size(); i++) file << (i ? "," : "") << profile.timeline[i].time;
+      file << "]";
+      for (size_t t = 0; t < profile.types.size(); t++) {
+        file << ",\n\"" << escape(profile.types[t]) << "\":[";
+        for (size_t i = 0; i < profile.timeline.size(); i++) file << (i ? "," : "") << profile.timeline[i].bytes[t];
+        file << "]";
+      }
+      file << "}}\n";
+
+      logQuda(QUDA_SUMMARIZE, "Saved memory profile to %s\n", profile_path.c_str());
+    }
+
+  } // namespace memory_profile
+
+} // namespace quda
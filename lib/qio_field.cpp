@@ -5,7 +5,10 @@
 #include <util_quda.h>
 #include <layout_hyper.h>
 
+#include <algorithm>
+#include <functional>
 #include <string>
+#include <vector>
 
 using namespace quda;
 
@@ -126,8 +129,15 @@ QIO_Writer *open_test_output(const char *filename, int volfmt, int serpar, int i
   return outfile;
 }
 
-int read_field(QIO_Reader *infile, int count, void *field_in[], QudaPrecision cpu_prec, QudaSiteSubset, QudaParity,
-               int nSpin, int nColor, int len)
+/**
+   @brief Read the next record from infile, converting to cpu_prec.
+   @param[in] count Expected number of fields in the record, or zero if any number is accepted
+   @param[in] get_fields Returns the array of fields to read into, given the number of fields in the record
+   @param[out] count_read Number of fields read (may be nullptr)
+   @return Zero on success
+*/
+static int read_record(QIO_Reader *infile, int count, const std::function<void **(int)> &get_fields,
+                       QudaPrecision cpu_prec, int nSpin, int nColor, int len, int *count_read)
 {
   // Get the QIO record and string
   char dummy[100] = "";
@@ -160,7 +170,8 @@ int read_field(QIO_Reader *infile, int count, void *field_in[], QudaPrecision cp
       warningQuda("QIO_get_colors %d does not match expected number of spins %d", in_nColor, nColor);
   }
 
-  if (in_count != count) errorQuda("QIO_get_datacount %d does not match expected number of fields %d", in_count, count);
+  if (count != 0 && in_count != count)
+    errorQuda("QIO_get_datacount %d does not match expected number of fields %d", in_count, count);
 
   if (in_typesize != file_prec * len)
     errorQuda("QIO_get_typesize %d does not match expected datasize %d", in_typesize, file_prec * len);
@@ -171,9 +182,10 @@ int read_field(QIO_Reader *infile, int count, void *field_in[], QudaPrecision cp
   if (len != 18 && QIO_string_length(xml_record_in) > 0) printfQuda("QIO string: %s\n", QIO_string_ptr(xml_record_in));
 
   // Get total size. Could probably check the filesize better, but tbd.
-  size_t rec_size = file_prec * count * len;
+  size_t rec_size = file_prec * in_count * len;
 
   vlen = len;
+  void **field_in = get_fields(in_count);
 
   /* Read the field record and convert to cpu precision*/
   if (cpu_prec == QUDA_DOUBLE_PRECISION) {
@@ -193,10 +205,17 @@ int read_field(QIO_Reader *infile, int count, void *field_in[], QudaPrecision cp
   QIO_string_destroy(xml_record_in);
   QIO_destroy_record_info(rec_info);
   printfQuda("%s: QIO_read_record_data returns status %d\n", __func__, status);
+  if (count_read) *count_read = in_count;
   if (status != QIO_SUCCESS) return 1;
   return 0;
 }
 
+int read_field(QIO_Reader *infile, int count, void *field_in[], QudaPrecision cpu_prec, QudaSiteSubset, QudaParity,
+               int nSpin, int nColor, int len)
+{
+  return read_record(infile, count, [=](int) { return field_in; }, cpu_prec, nSpin, nColor, len, nullptr);
+}
+
 int read_su3_field(QIO_Reader *infile, int count, void *field_in[], QudaPrecision cpu_prec)
 {
   return read_field(infile, count, field_in, cpu_prec, QUDA_FULL_SITE_SUBSET, QUDA_INVALID_PARITY, 1, 9, 18);
@@ -288,6 +307,43 @@ void read_spinor_field(const char *filename, void *V[], QudaPrecision precision,
   printfQuda("%s: Closed file for reading\n",__func__);
 }
 
+void read_spinor_field(const char *filename, QudaPrecision precision, const int *X, QudaSiteSubset subset,
+                       QudaParity parity, int nColor, int nSpin, int Nvec,
+                       const std::function<std::vector<void *>(int, int)> &get_chunk,
+                       const std::function<void(int, int)> &chunk_done)
+{
+  quda_this_node = QMP_get_node_number();
+
+  set_layout(X, subset);
+
+  /* Open the test file for reading */
+  QIO_Reader *infile = open_test_input(filename, QIO_UNKNOWN, QIO_PARALLEL);
+  if (infile == NULL) { errorQuda("Open file failed\n"); }
+
+  /* Read the spinor field records in turn */
+  printfQuda("%s: reading %d vector fields\n", __func__, Nvec); fflush(stdout);
+  for (int begin = 0; begin < Nvec;) {
+    std::vector<void *> V;
+    int count = 0;
+    int status = read_record(
+      infile, 0,
+      [&](int in_count) {
+        if (begin + in_count > Nvec)
+          errorQuda("Record of %d fields exceeds the %d fields remaining", in_count, Nvec - begin);
+        V = get_chunk(begin, in_count);
+        return V.data();
+      },
+      precision, nSpin, nColor, 2 * nSpin * nColor, &count);
+    if (status) { errorQuda("read_spinor_fields failed %d\n", status); }
+    chunk_done(begin, count);
+    begin += count;
+  }
+
+  /* Close the file */
+  QIO_close_read(infile);
+  printfQuda("%s: Closed file for reading\n",__func__);
+}
+
 int write_field(QIO_Writer *outfile, int count, const void *field_out[], QudaPrecision file_prec, QudaPrecision cpu_prec,
                 QudaSiteSubset subset, QudaParity parity, int nSpin, int nColor, int len, const char *type)
 {
@@ -440,3 +496,35 @@ void write_spinor_field(const char *filename, const void *V[], QudaPrecision pre
   QIO_close_write(outfile);
   printfQuda("%s: Closed file for writing\n",__func__);
 }
+
+void write_spinor_field(const char *filename, QudaPrecision precision, const int *X, QudaSiteSubset subset,
+                        QudaParity parity, int nColor, int nSpin, int Nvec, int chunk_size,
+                        const std::function<std::vector<const void *>(int, int)> &get_chunk, bool partfile)
+{
+  quda_this_node = QMP_get_node_number();
+
+  set_layout(X, subset);
+
+  QudaPrecision file_prec = precision;
+
+  char type[128];
+  sprintf(type, "QUDA_%sNs%dNc%d_ColorSpinorField", (file_prec == QUDA_DOUBLE_PRECISION) ? "D" : "F", nSpin, nColor);
+
+  /* Open the test file for writing */
+  QIO_Writer *outfile = open_test_output(filename, (partfile ? QIO_PARTFILE : QIO_SINGLEFILE), QIO_PARALLEL, QIO_ILDGNO);
+  if (outfile == NULL) { errorQuda("Open file failed\n"); }
+
+  /* Write the spinor field records, one per chunk */
+  printfQuda("%s: writing %d vector fields in chunks of %d\n", __func__, Nvec, chunk_size); fflush(stdout);
+  for (int begin = 0; begin < Nvec; begin += chunk_size) {
+    int count = std::min(chunk_size, Nvec - begin);
+    std::vector<const void *> V = get_chunk(begin, count);
+    int status = write_field(outfile, count, V.data(), precision, precision, subset, parity, nSpin, nColor,
+                             2 * nSpin * nColor, type);
+    if (status) { errorQuda("write_spinor_fields failed %d\n", status); }
+  }
+
+  /* Close the file */
+  QIO_close_write(outfile);
+  printfQuda("%s: Closed file for writing\n",__func__);
+}
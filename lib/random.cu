@@ -8,18 +8,25 @@ namespace quda {
 
   class RNGInit : public TunableKernel2D {
 
-    RNG &rng;
-    const LatticeField &meta;
+    RNGState *state;
     unsigned long long seed;
-    unsigned int minThreads() const { return meta.VolumeCB(); }
+    unsigned long long offset;
+    const lat_dim_t &X;
+    size_t volume_cb;
+    int site_subset;
+    unsigned int minThreads() const { return volume_cb; }
     bool tuneSharedBytes() const { return false; }
 
   public:
-    RNGInit(RNG &rng, const LatticeField &meta, unsigned long long seed) :
-      TunableKernel2D(meta, meta.SiteSubset()),
-      rng(rng),
-      meta(meta),
-      seed(seed)
+    RNGInit(RNGState *state, unsigned long long seed, unsigned long long offset, const lat_dim_t &X,
+            size_t volume_cb, int site_subset) :
+      TunableKernel2D(volume_cb, site_subset, QUDA_CUDA_FIELD_LOCATION),
+      state(state),
+      seed(seed),
+      offset(offset),
+      X(X),
+      volume_cb(volume_cb),
+      site_subset(site_subset)
     {
       apply(device::get_default_stream());
     }
@@ -27,7 +34,7 @@ namespace quda {
     void apply(const qudaStream_t &stream)
     {
       TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
-      launch_device<init_random>(tp, stream, rngArg(rng.State(), seed, meta));
+      launch_device<init_random>(tp, stream, rngArg(state, seed, offset, X, volume_cb, site_subset));
     }
 
     long long flops() const { return 0; }
@@ -36,8 +43,10 @@ namespace quda {
 
   RNG::RNG(const LatticeField &meta, unsigned long long seedin) :
     size(meta.LocalVolume()),
-    state((RNGState *)device_malloc(size * sizeof(RNGState)), [](RNGState *ptr){ device_free(ptr); } ),
-    seed(seedin)
+    seed(seedin),
+    X(meta.LocalX()),
+    volume_cb(meta.LocalVolumeCB()),
+    site_subset(meta.SiteSubset())
   {
 #if defined(XORWOW)
     if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Using randStateXORWOW\n");
@@ -47,18 +56,65 @@ namespace quda {
     if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Using randStateMRG32k3a\n");
 #endif
 
-    if (getVerbosity() >= QUDA_DEBUG_VERBOSE)
-      printfQuda("Allocated array of random numbers with size: %.2f MB\n",
-                 size * sizeof(RNGState) / (float)(1048576));
+    for (int i = 0; i < 4; i++) {
+      X_global[i] = X[i] * comm_dim(i);
+      comm_offset[i] = X[i] * comm_coord(i);
+    }
+
+    if (meta.Location() == QUDA_CUDA_FIELD_LOCATION) initDevice();
+  }
+
+  void RNG::initDevice()
+  {
+    if (!state) {
+      state = std::shared_ptr<RNGState>((RNGState *)device_malloc(size * sizeof(RNGState)),
+                                        [](RNGState *ptr) { device_free(ptr); });
+      if (getVerbosity() >= QUDA_DEBUG_VERBOSE)
+        printfQuda("Allocated array of random numbers with size: %.2f MB\n",
+                   size * sizeof(RNGState) / (float)(1048576));
+    }
+
+    RNGInit(state.get(), seed, offset, X, volume_cb, site_subset);
+    device_init = true;
+    device_offset = offset;
+  }
+
+  RNGState *RNG::State()
+  {
+    // bring the device states up to date with any draws consumed on the host
+    if (offset_known && (!device_init || device_offset != offset)) initDevice();
+    offset_known = false;
+    return state.get();
+  }
+
+  unsigned long long RNG::Subsequence(size_t i) const
+  {
+    // this must match the sequence number assigned by init_random
+    const int parity = i / volume_cb;
+    int x[4];
+    getCoords(x, i % volume_cb, X, parity);
+    for (int d = 0; d < 4; d++) x[d] += comm_offset[d];
+    return (((x[3] * X_global[2] + x[2]) * X_global[1]) + x[1]) * X_global[0] + x[0];
+  }
 
-    RNGInit(*this, meta, seed);
+  bool RNG::HostOffset(unsigned long long &offset) const
+  {
+    offset = this->offset;
+    return offset_known;
+  }
+
+  void RNG::Advance(unsigned long long n)
+  {
+    if (!offset_known) errorQuda("Cannot advance RNG states that are resident on the device");
+    offset += n;
   }
 
   /*! @brief Backup CURAND array states initialization */
   void RNG::backup()
   {
+    RNGState *state = State();
     backup_state = (RNGState *)safe_malloc(size * sizeof(RNGState));
-    qudaMemcpy(backup_state, state.get(), size * sizeof(RNGState), qudaMemcpyDeviceToHost);
+    qudaMemcpy(backup_state, state, size * sizeof(RNGState), qudaMemcpyDeviceToHost);
   }
 
   /*! @brief Restore CURAND array states initialization */
@@ -0,0 +1,348 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#include <size_class_pool.h>
+#include <malloc_quda.h>
+#include <memory_profile.h>
+#include <util_quda.h>
+
+namespace quda
+{
+
+  int numa_node()
+  {
+#ifdef SYS_getcpu
+    unsigned int cpu, node;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) return static_cast<int>(node);
+#endif
+    return 0;
+  }
+
+  /**
+     @return Whether transparent huge pages are to be used for host
+     memory, set with QUDA_ENABLE_HOST_HUGE_PAGES=1
+  */
+  static bool use_huge_pages()
+  {
+    static const bool huge_pages = [] {
+      char *enable_huge_pages = getenv("QUDA_ENABLE_HOST_HUGE_PAGES");
+      return enable_huge_pages && strcmp(enable_huge_pages, "1") == 0;
+    }();
+    return huge_pages;
+  }
+
+  /**
+     @return The size of a transparent huge page, as reported by the
+     kernel, defaulting to 2 MiB
+  */
+  static size_t huge_page_size()
+  {
+    static const size_t size = [] {
+      size_t size = 0;
+      std::ifstream file("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size");
+      if (!(file >> size) || size == 0) size = 2 * 1024 * 1024;
+      return size;
+    }();
+    return size;
+  }
+
+  void *host_pages_malloc(size_t bytes)
+  {
+    size_t align = getpagesize();
+    if (use_huge_pages() && bytes >= huge_page_size()) align = huge_page_size();
+
+    void *ptr = nullptr;
+    if (posix_memalign(&ptr, align, bytes) != 0) return nullptr;
+#ifdef MADV_HUGEPAGE
+    // this is only advice, so a failure (e.g., THP disabled) is harmless
+    if (align == huge_page_size()) madvise(ptr, bytes, MADV_HUGEPAGE);
+#endif
+    return ptr;
+  }
+
+  SizeClassPool::SizeClassPool(const std::string &name, size_t min_bytes, int sub_classes, free_t backing_free) :
+    name(name),
+    log2_sub(__builtin_ctz(sub_classes)),
+    n_class((std::numeric_limits<size_t>::digits - 1) << log2_sub),
+    min_class(class_of(min_bytes)),
+    backing_free(backing_free)
+  {
+    if (sub_classes <= 0 || (sub_classes & (sub_classes - 1)))
+      errorQuda("Number of sub-classes %d must be a power of two", sub_classes);
+  }
+
+  int SizeClassPool::class_of(size_t bytes) const
+  {
+    if (bytes <= 1) return 0;
+
+    // find the octave (2^o, 2^(o+1)] that holds bytes
+    int o = 0;
+    while (o < std::numeric_limits<size_t>::digits - 2 && (static_cast<size_t>(1) << (o + 1)) < bytes) o++;
+
+    // and the sub-class within the octave, where the sub-classes collapse for octaves smaller than their number
+    const size_t step = (static_cast<size_t>(1) << o) >> log2_sub;
+    if (step == 0) return std::min((o + 1) << log2_sub, n_class - 1);
+    const size_t k = (bytes - (static_cast<size_t>(1) << o) + step - 1) / step;
+    return std::min((o << log2_sub) + static_cast<int>(k), n_class - 1);
+  }
+
+  size_t SizeClassPool::class_size(int size_class) const
+  {
+    const int o = size_class >> log2_sub;
+    const size_t k = size_class & ((1 << log2_sub) - 1);
+    return (static_cast<size_t>(1) << o) + k * ((static_cast<size_t>(1) << o) >> log2_sub);
+  }
+
+  int SizeClassPool::size_class(size_t bytes) const { return std::max(class_of(bytes), min_class); }
+
+  void *SizeClassPool::take(int node, int size_class)
+  {
+    if (node >= static_cast<int>(arena.size())) return nullptr;
+    auto &list = arena[node][size_class];
+    if (list.empty()) return nullptr;
+    void *ptr = list.back();
+    list.pop_back();
+    stats_.cached_bytes -= class_size(size_class);
+    stats_.cached_blocks--;
+    return ptr;
+  }
+
+  void *SizeClassPool::take_nearest(int &node, int size_class)
+  {
+    void *ptr = take(node, size_class);
+    for (int n = 0; n < static_cast<int>(arena.size()) && !ptr; n++) {
+      if (n != node && (ptr = take(n, size_class))) node = n;
+    }
+    return ptr;
+  }
+
+  void SizeClassPool::free_cached(int node, int size_class)
+  {
+    backing_free(take(node, size_class));
+    stats_.trims++;
+    stats_.trimmed_bytes += class_size(size_class);
+  }
+
+  void SizeClassPool::set_budget(size_t bytes)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    budget = bytes;
+    if (stats_.cached_bytes > budget) trim_locked(stats_.cached_bytes - budget);
+  }
+
+  size_t SizeClassPool::get_budget() const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return budget;
+  }
+
+  void *SizeClassPool::allocate(size_t bytes, const alloc_t &backing_alloc)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    int c = size_class(bytes);
+    const int node = numa_node();
+
+    // reuse a block of the same class, or else of the next larger class, from the nearest arena
+    int block_node = node;
+    void *ptr = take_nearest(block_node, c);
+    if (!ptr && c + 1 < n_class && (ptr = take_nearest(block_node, c + 1))) {
+      c++;
+      stats_.larger_hits++;
+    }
+
+    if (ptr) {
+      if (block_node == node)
+        stats_.hits++;
+      else
+        stats_.remote_hits++;
+    } else {
+      stats_.misses++;
+      ptr = backing_alloc(class_size(c));
+      if (!ptr && stats_.cached_blocks > 0) {
+        trim_locked(std::numeric_limits<size_t>::max());
+        ptr = backing_alloc(class_size(c));
+      }
+      if (!ptr) return nullptr;
+    }
+
+    active[ptr] = {c, block_node, bytes};
+    stats_.active_bytes += class_size(c);
+    stats_.requested_bytes += bytes;
+    stats_.total_class_bytes += class_size(c);
+    stats_.total_requested_bytes += bytes;
+    return ptr;
+  }
+
+  bool SizeClassPool::release(void *ptr)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = active.find(ptr);
+    if (it == active.end()) return false;
+
+    const Block block = it->second;
+    active.erase(it);
+    if (block.node >= static_cast<int>(arena.size()))
+      arena.resize(block.node + 1, std::vector<std::vector<void *>>(n_class));
+    arena[block.node][block.size_class].push_back(ptr);
+
+    const size_t bytes = class_size(block.size_class);
+    stats_.active_bytes -= bytes;
+    stats_.requested_bytes -= block.requested;
+    stats_.cached_bytes += bytes;
+    stats_.cached_blocks++;
+    stats_.peak_cached_bytes = std::max(stats_.peak_cached_bytes, stats_.cached_bytes);
+    if (stats_.cached_bytes > budget) trim_locked(stats_.cached_bytes - budget);
+    return true;
+  }
+
+  size_t SizeClassPool::trim_locked(size_t bytes)
+  {
+    size_t released = 0;
+    for (int c = n_class - 1; c >= 0 && released < bytes && stats_.cached_blocks > 0; c--) {
+      for (int n = 0; n < static_cast<int>(arena.size()); n++) {
+        while (!arena[n][c].empty() && released < bytes) {
+          free_cached(n, c);
+          released += class_size(c);
+        }
+      }
+    }
+    return released;
+  }
+
+  size_t SizeClassPool::trim(size_t bytes)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return trim_locked(bytes);
+  }
+
+  SizeClassPool::Stats SizeClassPool::stats() const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats_;
+  }
+
+  void SizeClassPool::print() const
+  {
+    const Stats s = stats();
+    if (s.hits + s.remote_hits + s.misses == 0) return;
+
+    constexpr double MiB = 1 << 20;
+    const double padding = s.total_class_bytes > 0 ?
+      100.0 * (s.total_class_bytes - s.total_requested_bytes) / s.total_class_bytes :
+      0.0;
+    printfQuda("%s memory pool: %.1f MiB cached in %zu blocks (peak %.1f MiB), %.1f MiB active, %.1f%% size-class "
+               "padding\n",
+               name.c_str(), s.cached_bytes / MiB, s.cached_blocks, s.peak_cached_bytes / MiB, s.active_bytes / MiB,
+               padding);
+    printfQuda("%s memory pool: %zu hits (%zu remote-node, %zu larger-class), %zu misses, %zu blocks trimmed "
+               "(%.1f MiB)\n",
+               name.c_str(), s.hits + s.remote_hits, s.remote_hits, s.larger_hits, s.misses, s.trims,
+               s.trimmed_bytes / MiB);
+  }
+
+  bool use_host_pool(size_t bytes)
+  {
+    static const bool enabled = [] {
+      char *enable_host_pool = getenv("QUDA_ENABLE_HOST_MEMORY_POOL");
+      return !enable_host_pool || strcmp(enable_host_pool, "0") != 0;
+    }();
+    constexpr size_t min_bytes = 128 * 1024;
+    return enabled && bytes >= min_bytes;
+  }
+
+  /**
+     @brief Set the budget of a pool from the environment, in MiB
+     @param[in] pool The pool
+     @param[in] env The environment variable
+  */
+  static void set_budget_env(SizeClassPool &pool, const char *env)
+  {
+    char *budget = getenv(env);
+    if (budget) pool.set_budget(static_cast<size_t>(std::stod(budget) * (1 << 20)));
+  }
+
+  SizeClassPool &host_pool()
+  {
+    static SizeClassPool pool("Host", 128 * 1024, 1, [](void *ptr) { free(ptr); });
+    static std::once_flag budget_flag;
+    std::call_once(budget_flag, [] { set_budget_env(pool, "QUDA_HOST_MEMORY_POOL_BUDGET"); });
+    return pool;
+  }
+
+  bool use_pinned_pool()
+  {
+    static const bool enabled = [] {
+      char *enable_pinned_pool = getenv("QUDA_ENABLE_PINNED_MEMORY_POOL");
+      return !enable_pinned_pool || strcmp(enable_pinned_pool, "0") != 0;
+    }();
+    return enabled;
+  }
+
+  /**
+     @brief Allocate a page-locked block for the pinned pool, returning
+     nullptr on failure.  The block is rounded up to whole pages, as
+     required for page-locking.
+  */
+  static void *pinned_block_malloc(const char *func, const char *file, int line, size_t bytes)
+  {
+    const size_t page_size = getpagesize();
+    bytes = ((bytes + page_size - 1) / page_size) * page_size;
+    void *ptr = host_pages_malloc(bytes);
+    if (ptr && !register_pinned_block_(func, file, line, ptr, bytes)) {
+      free(ptr);
+      ptr = nullptr;
+    }
+    return ptr;
+  }
+
+  SizeClassPool &pinned_pool()
+  {
+    static SizeClassPool pool("Pinned", 2 * getpagesize(), 4, [](void *ptr) {
+      memory_profile::pool_trim(ptr);
+      unregister_pinned_block_(ptr);
+      free(ptr);
+    });
+    static std::once_flag budget_flag;
+    std::call_once(budget_flag, [] { set_budget_env(pool, "QUDA_PINNED_MEMORY_POOL_BUDGET"); });
+    return pool;
+  }
+
+  namespace pool
+  {
+
+    void *pinned_malloc_(const char *func, const char *file, int line, size_t nbytes)
+    {
+      if (!use_pinned_pool()) return quda::pinned_malloc_(func, file, line, nbytes);
+      void *ptr = pinned_pool().allocate(
+        nbytes, [&](size_t bytes) { return pinned_block_malloc(func, file, line, bytes); });
+      if (!ptr) errorQuda("Failed to allocate pinned memory of size %zu (%s:%d in %s())\n", nbytes, file, line, func);
+      memory_profile::pool_allocate("Pinned", func, file, line, ptr, pinned_pool().class_bytes(nbytes));
+      return ptr;
+    }
+
+    void pinned_free_(const char *func, const char *file, int line, void *ptr)
+    {
+      if (use_pinned_pool()) {
+        memory_profile::pool_free(ptr); // before the release, which may trim the block
+        if (!pinned_pool().release(ptr)) { errorQuda("Attempt to free invalid pointer"); }
+      } else {
+        quda::host_free_(func, file, line, ptr);
+      }
+    }
+
+    void flush_pinned()
+    {
+      if (use_pinned_pool()) pinned_pool().trim();
+    }
+
+    void flush_host() { host_pool().trim(); }
+
+  } // namespace pool
+
+} // namespace quda
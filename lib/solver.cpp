@@ -151,6 +151,10 @@ namespace quda {
       report("CG3NR");
       solver = new CG3NR(mat, matSloppy, matPrecon, param);
       break;
+    case QUDA_PIPE_CG_INVERTER:
+      report("PipeCG");
+      solver = new PipeCG(mat, matSloppy, matPrecon, param);
+      break;
     default:
       errorQuda("Invalid solver type %d", param.inv_type);
     }
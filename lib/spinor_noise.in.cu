@@ -1,5 +1,7 @@
 #include <color_spinor_field.h>
 #include <random_quda.h>
+#include <random_host.h>
+#include <thread_pool.h>
 #include <tunable_nd.h>
 #include <kernels/spinor_noise.cuh>
 #include <instantiate.h>
@@ -21,7 +23,36 @@ namespace quda {
       type(type)
     {
       strcat(aux, type == QUDA_NOISE_GAUSS ? ",gauss" : ",uniform");
-      apply(device::get_default_stream());
+      if (v.Location() == QUDA_CPU_FIELD_LOCATION)
+        applyHost();
+      else
+        apply(device::get_default_stream());
+    }
+
+    /**
+       @brief Generate the noise on the host thread pool, recreating
+       the state of each site with skip-ahead
+    */
+    void applyHost()
+    {
+      unsigned long long offset;
+      if (!rng.HostOffset(offset)) errorQuda("RNG states are resident on the device");
+      if (v.SiteSubset() * v.VolumeCB() != rng.Size())
+        errorQuda("Field sites (%lu) do not match the RNG states (%lu)", v.SiteSubset() * v.VolumeCB(), rng.Size());
+
+      colorspinor::FieldOrderCB<real, Ns, Nc, 1, QUDA_SPACE_SPIN_COLOR_FIELD_ORDER> V(v);
+      const size_t volume_cb = v.VolumeCB();
+      const unsigned long long seed = rng.Seed();
+      thread_pool::parallel_for(v.SiteSubset() * volume_cb, 0, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+          const int parity = i / volume_cb;
+          const int x_cb = i % volume_cb;
+          HostRNGState state(seed, rng.Subsequence(i), offset);
+          for (int s = 0; s < Ns; s++)
+            for (int c = 0; c < Nc; c++) V(parity, x_cb, s, c) = hostNoise<real>(state, type);
+        }
+      });
+      rng.Advance(noise_draws * Ns * Nc);
     }
 
     void apply(const qudaStream_t &stream) {
@@ -58,7 +89,7 @@ namespace quda {
   template <typename real>
   void spinorNoise(ColorSpinorField &src, RNG& randstates, QudaNoiseType type)
   {
-    checkNative(src);
+    if (src.Location() == QUDA_CUDA_FIELD_LOCATION) checkNative(src);
     if (!is_enabled_spin(src.Nspin()))
       errorQuda("spinorNoise has not been built for nSpin=%d fields", src.Nspin());
 
@@ -75,11 +106,18 @@ namespace quda {
 
   void spinorNoise(ColorSpinorField &src_, RNG &randstates, QudaNoiseType type)
   {
-    // if src is a CPU field then create GPU field
+    // CPU fields are filled on the host if the RNG states can be regenerated there.  The host
+    // only tracks a single offset for all states, so the field must draw from every state.
+    unsigned long long offset;
+    const bool host = src_.Location() == QUDA_CPU_FIELD_LOCATION && src_.Precision() >= QUDA_SINGLE_PRECISION
+      && src_.FieldOrder() == QUDA_SPACE_SPIN_COLOR_FIELD_ORDER && randstates.HostOffset(offset)
+      && src_.SiteSubset() * src_.VolumeCB() == randstates.Size() && hostNoiseEnabled();
+
+    // otherwise, if src is a CPU field then create GPU field
     ColorSpinorField src;
     ColorSpinorParam param(src_);
     bool copy_back = false;
-    if (src_.Location() == QUDA_CPU_FIELD_LOCATION || src_.Precision() < QUDA_SINGLE_PRECISION) {
+    if (!host && (src_.Location() == QUDA_CPU_FIELD_LOCATION || src_.Precision() < QUDA_SINGLE_PRECISION)) {
       QudaPrecision prec = std::max(src_.Precision(), QUDA_SINGLE_PRECISION);
       param.setPrecision(prec, prec, true); // change to native field order
       param.create = QUDA_NULL_FIELD_CREATE;
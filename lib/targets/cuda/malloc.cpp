@@ -6,6 +6,8 @@
 #include <execinfo.h> // for backtrace
 #include <quda_internal.h>
 #include <device.h>
+#include <size_class_pool.h>
+#include <memory_profile.h>
 #include <shmem_helper.cuh>
 #include "timer.h"
 
@@ -31,13 +33,15 @@ namespace quda
     int line;
     size_t size;
     size_t base_size;
+    int site; /** call-site id used by the memory profile */
 #ifdef QUDA_BACKWARDSCPP
     backward::StackTrace st;
 #endif
 
-    MemAlloc() : line(-1), size(0), base_size(0) {}
+    MemAlloc() : line(-1), size(0), base_size(0), site(-1) {}
 
-    MemAlloc(std::string func, std::string file, int line) : func(func), file(file), line(line), size(0), base_size(0)
+    MemAlloc(std::string func, std::string file, int line) :
+      func(func), file(file), line(line), size(0), base_size(0), site(-1)
     {
 #ifdef QUDA_BACKWARDSCPP
       st.load_here(32);
@@ -53,6 +57,7 @@ namespace quda
   };
 
   static std::map<void *, MemAlloc> alloc[N_ALLOC_TYPE];
+  static const char *alloc_type_name[N_ALLOC_TYPE] = {"Device", "Device Pinned", "Host", "Pinned", "Mapped", "Managed", "Shmem"};
   static size_t total_bytes[N_ALLOC_TYPE] = {0};
   static size_t max_total_bytes[N_ALLOC_TYPE] = {0};
   static size_t total_host_bytes, max_total_host_bytes;
@@ -114,7 +119,7 @@ namespace quda
     }
   }
 
-  static void track_malloc(const AllocType &type, const MemAlloc &a, void *ptr)
+  static void track_malloc(const AllocType &type, const MemAlloc &a, void *ptr, bool profile = true)
   {
     total_bytes[type] += a.base_size;
     if (total_bytes[type] > max_total_bytes[type]) { max_total_bytes[type] = total_bytes[type]; }
@@ -127,11 +132,18 @@ namespace quda
       if (total_pinned_bytes > max_total_pinned_bytes) { max_total_pinned_bytes = total_pinned_bytes; }
     }
     alloc[type][ptr] = a;
+
+    if (profile && memory_profile::enabled()) {
+      MemAlloc &entry = alloc[type][ptr];
+      entry.site = memory_profile::site(alloc_type_name[type], a.func, a.file, a.line);
+      memory_profile::allocate(entry.site, a.base_size);
+    }
   }
 
   static void track_free(const AllocType &type, void *ptr)
   {
     size_t size = alloc[type][ptr].base_size;
+    if (alloc[type][ptr].site >= 0) memory_profile::free(alloc[type][ptr].site, size);
     total_bytes[type] -= size;
     if (type != DEVICE && type != DEVICE_PINNED && type != SHMEM) { total_host_bytes -= size; }
     if (type == PINNED || type == MAPPED) { total_pinned_bytes -= size; }
@@ -217,11 +229,12 @@ namespace quda
   }
 
   /**
-   * Perform a standard cudaMalloc() with error-checking.  This
-   * function should only be called via the device_malloc() macro,
-   * defined in malloc_quda.h
+   * Perform a standard cudaMalloc() with error-checking, recording
+   * the allocation in the memory profile if profile is set.  The
+   * device-memory pool records its allocations itself, at the site
+   * that requested them from the pool.
    */
-  void *device_malloc_(const char *func, const char *file, int line, size_t size)
+  static void *allocate_device(const char *func, const char *file, int line, size_t size, bool profile)
   {
     if (use_managed_memory()) return managed_malloc_(func, file, line, size);
 
@@ -233,6 +246,7 @@ namespace quda
 #ifndef USE_QDPJIT
     cudaError_t err = cudaMalloc(&ptr, size);
     if (err != cudaSuccess) {
+      memory_profile::dump();
       errorQuda("Failed to allocate device memory of size %zu (%s:%d in %s())\n", size, file, line, func);
     }
 #else
@@ -241,13 +255,23 @@ namespace quda
 #endif
 
     if (is_prefetch_enabled()) qudaMemPrefetchAsync(ptr, size, QUDA_CUDA_FIELD_LOCATION, device::get_default_stream());
-    track_malloc(DEVICE, a, ptr);
+    track_malloc(DEVICE, a, ptr, profile);
 #ifdef HOST_DEBUG
     cudaMemset(ptr, 0xff, size);
 #endif
     return ptr;
   }
 
+  /**
+   * Perform a standard cudaMalloc() with error-checking.  This
+   * function should only be called via the device_malloc() macro,
+   * defined in malloc_quda.h
+   */
+  void *device_malloc_(const char *func, const char *file, int line, size_t size)
+  {
+    return allocate_device(func, file, line, size, true);
+  }
+
   /**
    * Perform a cuMemAlloc with error-checking.  This function is to
    * guarantee a unique memory allocation on the device, since
@@ -276,16 +300,23 @@ namespace quda
   }
 
   /**
-   * Perform a standard malloc() with error-checking.  This function
-   * should only be called via the safe_malloc() macro, defined in
-   * malloc_quda.h
+   * Perform a standard malloc() with error-checking.  Large
+   * allocations are served from the host-memory pool (see
+   * use_host_pool).  This function should only be called via the
+   * safe_malloc() macro, defined in malloc_quda.h
    */
   void *safe_malloc_(const char *func, const char *file, int line, size_t size)
   {
     MemAlloc a(func, file, line);
     a.size = a.base_size = size;
 
-    void *ptr = malloc(size);
+    void *ptr = nullptr;
+    if (use_host_pool(size)) {
+      a.base_size = host_pool().class_bytes(size);
+      ptr = host_pool().allocate(size, host_pages_malloc);
+    } else {
+      ptr = malloc(size);
+    }
     if (!ptr) { errorQuda("Failed to allocate host memory of size %zu (%s:%d in %s())\n", size, file, line, func); }
     track_malloc(HOST, a, ptr);
 #ifdef HOST_DEBUG
@@ -485,7 +516,7 @@ namespace quda
     if (!ptr) { errorQuda("Attempt to free NULL host pointer (%s:%d in %s())\n", file, line, func); }
     if (alloc[HOST].count(ptr)) {
       track_free(HOST, ptr);
-      free(ptr);
+      if (!host_pool().release(ptr)) free(ptr);
     } else if (alloc[PINNED].count(ptr)) {
       cudaError_t err = cudaHostUnregister(ptr);
       if (err != cudaSuccess) { errorQuda("Failed to unregister pinned memory (%s:%d in %s())\n", file, line, func); }
@@ -551,6 +582,8 @@ namespace quda
     printfQuda("Shmem memory used = %.1f MiB\n", max_total_bytes[SHMEM] / (double)(1 << 20));
     printfQuda("Page-locked host memory used = %.1f MiB\n", max_total_pinned_bytes / (double)(1 << 20));
     printfQuda("Total host memory used >= %.1f MiB\n", max_total_host_bytes / (double)(1 << 20));
+    host_pool().print();
+    pinned_pool().print();
   }
 
   void assertAllMemFree()
@@ -620,18 +653,28 @@ namespace quda
     }
   }
 
-  namespace pool
+  bool register_pinned_block_(const char *func, const char *file, int line, void *ptr, size_t bytes)
   {
+    MemAlloc a(func, file, line);
+    a.size = a.base_size = bytes;
+    if (cudaHostRegister(ptr, bytes, cudaHostRegisterDefault) != cudaSuccess) {
+      cudaGetLastError(); // clear the error so that it is not reported by a later check
+      return false;
+    }
+    track_malloc(PINNED, a, ptr, false); // profiled by the pinned pool
+    return true;
+  }
 
-    /** Cache of inactive pinned-memory allocations.  We cache pinned
-        memory allocations so that fields can reuse these with minimal
-        overhead.*/
-    static std::multimap<size_t, void *> pinnedCache;
+  void unregister_pinned_block_(void *ptr)
+  {
+    if (!alloc[PINNED].count(ptr)) errorQuda("Attempt to unregister invalid pinned pointer %p", ptr);
+    auto error = cudaHostUnregister(ptr);
+    if (error != cudaSuccess) errorQuda("cudaHostUnregister failed with error %s", cudaGetErrorString(error));
+    track_free(PINNED, ptr);
+  }
 
-    /** Sizes of active pinned-memory allocations.  For convenience,
-        we keep track of the sizes of active allocations (i.e., those not
-        in the cache). */
-    static std::map<void *, size_t> pinnedSize;
+  namespace pool
+  {
 
     /** Cache of inactive device-memory allocations.  We cache pinned
         memory allocations so that fields can reuse these with minimal
@@ -648,9 +691,6 @@ namespace quda
     /** whether to use a memory pool allocator for device memory */
     static bool device_memory_pool = true;
 
-    /** whether to use a memory pool allocator for pinned memory */
-    static bool pinned_memory_pool = true;
-
     void init()
     {
       if (!pool_init) {
@@ -665,14 +705,11 @@ namespace quda
         }
 
         // pinned memory pool
-        char *enable_pinned_pool = getenv("QUDA_ENABLE_PINNED_MEMORY_POOL");
-        if (!enable_pinned_pool || strcmp(enable_pinned_pool, "0") != 0) {
+        if (use_pinned_pool())
           warningQuda("Using pinned memory pool allocator");
-          pinned_memory_pool = true;
-        } else {
+        else
           warningQuda("Not using pinned memory pool allocator");
-          pinned_memory_pool = false;
-        }
+
         pool_init = true;
       }
 #if defined(NVSHMEM_COMMS)
@@ -684,50 +721,12 @@ namespace quda
 #endif
     }
 
-    void *pinned_malloc_(const char *func, const char *file, int line, size_t nbytes)
-    {
-      void *ptr = nullptr;
-      if (pinned_memory_pool) {
-        if (pinnedCache.empty()) {
-          ptr = quda::pinned_malloc_(func, file, line, nbytes);
-        } else {
-          auto it = pinnedCache.lower_bound(nbytes);
-          if (it != pinnedCache.end()) { // sufficiently large allocation found
-            nbytes = it->first;
-            ptr = it->second;
-            pinnedCache.erase(it);
-          } else { // sacrifice the smallest cached allocation
-            it = pinnedCache.begin();
-            ptr = it->second;
-            pinnedCache.erase(it);
-            host_free(ptr);
-            ptr = quda::pinned_malloc_(func, file, line, nbytes);
-          }
-        }
-        pinnedSize[ptr] = nbytes;
-      } else {
-        ptr = quda::pinned_malloc_(func, file, line, nbytes);
-      }
-      return ptr;
-    }
-
-    void pinned_free_(const char *func, const char *file, int line, void *ptr)
-    {
-      if (pinned_memory_pool) {
-        if (!pinnedSize.count(ptr)) { errorQuda("Attempt to free invalid pointer"); }
-        pinnedCache.insert(std::make_pair(pinnedSize[ptr], ptr));
-        pinnedSize.erase(ptr);
-      } else {
-        quda::host_free_(func, file, line, ptr);
-      }
-    }
-
     void *device_malloc_(const char *func, const char *file, int line, size_t nbytes)
     {
       void *ptr = nullptr;
       if (device_memory_pool) {
         if (deviceCache.empty()) {
-          ptr = quda::device_malloc_(func, file, line, nbytes);
+          ptr = allocate_device(func, file, line, nbytes, false);
         } else {
           auto it = deviceCache.lower_bound(nbytes);
           if (it != deviceCache.end()) { // sufficiently large allocation found
@@ -738,11 +737,13 @@ namespace quda
             it = deviceCache.begin();
             ptr = it->second;
             deviceCache.erase(it);
+            memory_profile::pool_trim(ptr);
             quda::device_free_(func, file, line, ptr);
-            ptr = quda::device_malloc_(func, file, line, nbytes);
+            ptr = allocate_device(func, file, line, nbytes, false);
           }
         }
         deviceSize[ptr] = nbytes;
+        memory_profile::pool_allocate("Device", func, file, line, ptr, nbytes);
       } else {
         ptr = quda::device_malloc_(func, file, line, nbytes);
       }
@@ -755,6 +756,7 @@ namespace quda
         if (!deviceSize.count(ptr)) { errorQuda("Attempt to free invalid pointer"); }
         deviceCache.insert(std::make_pair(deviceSize[ptr], ptr));
         deviceSize.erase(ptr);
+        memory_profile::pool_free(ptr);
       } else {
         quda::device_free_(func, file, line, ptr);
       }
@@ -772,18 +774,13 @@ namespace quda
     }
 #endif
 
-    void flush_pinned()
-    {
-      if (pinned_memory_pool) {
-        for (auto it : pinnedCache) { host_free(it.second); }
-        pinnedCache.clear();
-      }
-    }
-
     void flush_device()
     {
       if (device_memory_pool) {
-        for (auto it : deviceCache) { device_free(it.second); }
+        for (auto it : deviceCache) {
+          memory_profile::pool_trim(it.second);
+          device_free(it.second);
+        }
         deviceCache.clear();
       }
     }
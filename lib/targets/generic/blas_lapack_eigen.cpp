@@ -1,6 +1,7 @@
 #include <timer.h>
 #include <blas_lapack.h>
 #include <eigen_helper.h>
+#include <thread_pool.h>
 
 //#define _DEBUG
 
@@ -21,6 +22,11 @@ namespace quda
 
       void destroy() {}
 
+      // whether stridedBatchGEMM maps the user arrays in place, or copies them through dense temporaries
+      static bool zero_copy_gemm = true;
+      bool use_zero_copy_gemm() { return zero_copy_gemm; }
+      void set_zero_copy_gemm(bool zero_copy) { zero_copy_gemm = zero_copy; }
+
       // Batched inversion ckecking
       //---------------------------------------------------
       template <typename EigenMatrix, typename Float>
@@ -46,6 +52,112 @@ namespace quda
         printfQuda("Eigen: Norm of (A * Ainv - I) batch %lu = %e\n", batch, L2norm);
 #endif
       }
+
+      /**
+         @brief In-place inversion of an N x N complex matrix, stored as
+         interleaved real and imaginary parts, using Gauss-Jordan
+         elimination with partial pivoting.  The matrix size is known at
+         compile time, so the row updates are fully unrolled and
+         vectorized, and no heap memory is used.  The pivot is chosen
+         by the 1-norm of each element, as per LAPACK.  Since the
+         inverse of the transpose is the transpose of the inverse, the
+         matrix may be in either row- or column-major order.
+      */
+      template <int N, typename Float> void invertFixed(Float *a)
+      {
+        int pivot[N];
+
+        for (int k = 0; k < N; k++) {
+          Float *row_k = a + 2 * k * N;
+
+          // find the pivot row and swap it into place
+          int p = k;
+          Float max = std::abs(row_k[2 * k]) + std::abs(row_k[2 * k + 1]);
+          for (int i = k + 1; i < N; i++) {
+            Float abs = std::abs(a[2 * (i * N + k)]) + std::abs(a[2 * (i * N + k) + 1]);
+            if (abs > max) {
+              max = abs;
+              p = i;
+            }
+          }
+          pivot[k] = p;
+          if (p != k) {
+            for (int j = 0; j < 2 * N; j++) std::swap(row_k[j], a[2 * p * N + j]);
+          }
+
+          // scale the pivot row by the reciprocal of the pivot
+          const Float norm2 = row_k[2 * k] * row_k[2 * k] + row_k[2 * k + 1] * row_k[2 * k + 1];
+          const Float inv_re = row_k[2 * k] / norm2;
+          const Float inv_im = -row_k[2 * k + 1] / norm2;
+          row_k[2 * k] = 1.0;
+          row_k[2 * k + 1] = 0.0;
+          for (int j = 0; j < N; j++) {
+            const Float re = row_k[2 * j];
+            const Float im = row_k[2 * j + 1];
+            row_k[2 * j] = re * inv_re - im * inv_im;
+            row_k[2 * j + 1] = re * inv_im + im * inv_re;
+          }
+
+          // eliminate column k from all other rows
+          for (int i = 0; i < N; i++) {
+            if (i == k) continue;
+            Float *row_i = a + 2 * i * N;
+            const Float f_re = row_i[2 * k];
+            const Float f_im = row_i[2 * k + 1];
+            row_i[2 * k] = 0.0;
+            row_i[2 * k + 1] = 0.0;
+            for (int j = 0; j < N; j++) {
+              row_i[2 * j] -= f_re * row_k[2 * j] - f_im * row_k[2 * j + 1];
+              row_i[2 * j + 1] -= f_re * row_k[2 * j + 1] + f_im * row_k[2 * j];
+            }
+          }
+        }
+
+        // undo the row interchanges by swapping the columns in reverse order
+        for (int k = N - 1; k >= 0; k--) {
+          if (pivot[k] == k) continue;
+          for (int i = 0; i < N; i++) {
+            std::swap(a[2 * (i * N + k)], a[2 * (i * N + pivot[k])]);
+            std::swap(a[2 * (i * N + k) + 1], a[2 * (i * N + pivot[k]) + 1]);
+          }
+        }
+      }
+
+      /**
+         @brief Batched inversion for the matrix sizes that arise in
+         practice: the coarse clover inverse, with 2 * Nvec = 48, 64
+         and 128, and the staggered Kahler-Dirac block with 48.  Each
+         matrix is copied to its output location and inverted in place,
+         with the batches distributed over the OpenMP threads, as for
+         the dynamic fallback, or else over the host thread pool.
+         @return Whether the matrix size is supported
+      */
+      template <typename Float> bool invertBatchFixed(Float *Ainv, const Float *A, int n, uint64_t batch)
+      {
+        auto invert = [&](auto N) {
+          constexpr int size = 2 * decltype(N)::value * decltype(N)::value;
+          auto invert_one = [&](uint64_t i) {
+            std::copy(A + i * size, A + (i + 1) * size, Ainv + i * size);
+            invertFixed<decltype(N)::value>(Ainv + i * size);
+          };
+#ifdef _OPENMP
+#pragma omp parallel for
+          for (uint64_t i = 0; i < batch; i++) invert_one(i);
+#else
+          thread_pool::parallel_for(batch, 0, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) invert_one(i);
+          });
+#endif
+          return true;
+        };
+
+        switch (n) {
+        case 48: return invert(std::integral_constant<int, 48>());
+        case 64: return invert(std::integral_constant<int, 64>());
+        case 128: return invert(std::integral_constant<int, 128>());
+        default: return false;
+        }
+      }
       //---------------------------------------------------
 
       // Batched Inversions
@@ -65,24 +177,31 @@ namespace quda
         timeval start, stop;
         gettimeofday(&start, NULL);
 
+        bool fixed = false;
         if (prec == QUDA_SINGLE_PRECISION) {
           std::complex<float> *A_eig = (std::complex<float> *)A_h;
           std::complex<float> *Ainv_eig = (std::complex<float> *)Ainv_h;
 
+          fixed = invertBatchFixed((float *)Ainv_h, (const float *)A_h, n, batch);
+          if (!fixed) {
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-          for (uint64_t i = 0; i < batch; i++) { invertEigen<MatrixXcf, float>(A_eig, Ainv_eig, n, i); }
-          flops += batch * FLOPS_CGETRF(n, n);
+            for (uint64_t i = 0; i < batch; i++) { invertEigen<MatrixXcf, float>(A_eig, Ainv_eig, n, i); }
+          }
+          flops += batch * (FLOPS_CGETRF(n, n) + FLOPS_CGETRI(n));
         } else if (prec == QUDA_DOUBLE_PRECISION) {
           std::complex<double> *A_eig = (std::complex<double> *)A_h;
           std::complex<double> *Ainv_eig = (std::complex<double> *)Ainv_h;
 
+          fixed = invertBatchFixed((double *)Ainv_h, (const double *)A_h, n, batch);
+          if (!fixed) {
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-          for (uint64_t i = 0; i < batch; i++) { invertEigen<MatrixXcd, double>(A_eig, Ainv_eig, n, i); }
-          flops += batch * FLOPS_ZGETRF(n, n);
+            for (uint64_t i = 0; i < batch; i++) { invertEigen<MatrixXcd, double>(A_eig, Ainv_eig, n, i); }
+          }
+          flops += batch * (FLOPS_ZGETRF(n, n) + FLOPS_ZGETRI(n));
         } else {
           errorQuda("%s not implemented for precision = %d", __func__, prec);
         }
@@ -93,12 +212,13 @@ namespace quda
         double timeh = dsh + 0.000001 * dush;
 
         if (getVerbosity() >= QUDA_VERBOSE) {
-          int threads = 1;
 #ifdef _OPENMP
-          threads = omp_get_num_threads();
+          int threads = omp_get_max_threads();
+#else
+          int threads = fixed ? thread_pool::get_num_threads() : 1;
 #endif
-          printfQuda("CPU: Batched matrix inversion completed in %f seconds using %d threads with GFLOPS = %f\n", timeh,
-                     threads, 1e-9 * flops / timeh);
+          printfQuda("CPU: Batched %s matrix inversion completed in %f seconds using %d threads with GFLOPS = %f\n",
+                     fixed ? "fixed-size" : "dynamic", timeh, threads, 1e-9 * flops / timeh);
         }
 
         if (location == QUDA_CUDA_FIELD_LOCATION) {
@@ -113,9 +233,9 @@ namespace quda
       // Srided Batched GEMM helpers
       //--------------------------------------------------------------------------
       template <typename EigenMat, typename T>
-      void fillArray(EigenMat &EigenArr, T *arr, int rows, int cols, int ld, int offset, bool fill_eigen)
+      void fillArray(EigenMat &EigenArr, T *arr, int rows, int cols, int ld, size_t offset, bool fill_eigen)
       {
-        int counter = offset;
+        size_t counter = offset;
         for (int i = 0; i < rows; i++) {
           for (int j = 0; j < cols; j++) {
             if (fill_eigen)
@@ -128,76 +248,159 @@ namespace quda
         }
       }
 
+      /**
+         @brief The layout of the matrices of a strided batched GEMM,
+         computed once from the parameters after their conversion to
+         row-major order.  It sizes the host staging of device arrays
+         and is walked by both GEMM implementations.
+      */
+      struct GEMMBatch {
+        uint64_t n_gemm; // number of GEMMs computed
+        int a_rows, a_cols, b_rows, b_cols; // dimensions of the stored A and B matrices
+        size_t A_batch_size, B_batch_size, C_batch_size; // number of data between consecutive GEMMs
+        size_t A_size, B_size, C_size; // number of data spanned by all GEMMs, including the offsets
+
+        GEMMBatch(const QudaBLASParam &blas_param, int max_stride) :
+          n_gemm((blas_param.batch_count + max_stride - 1) / max_stride),
+          a_rows(blas_param.trans_a == QUDA_BLAS_OP_N ? blas_param.m : blas_param.k),
+          a_cols(blas_param.trans_a == QUDA_BLAS_OP_N ? blas_param.k : blas_param.m),
+          b_rows(blas_param.trans_b == QUDA_BLAS_OP_N ? blas_param.k : blas_param.n),
+          b_cols(blas_param.trans_b == QUDA_BLAS_OP_N ? blas_param.n : blas_param.k)
+        {
+          // If the user did not set any stride values, we default them to 1
+          // as batch size 0 is an option.
+          A_batch_size = static_cast<size_t>(blas_param.lda) * a_rows * std::max(blas_param.a_stride, 1);
+          B_batch_size = static_cast<size_t>(blas_param.ldb) * b_rows * std::max(blas_param.b_stride, 1);
+          C_batch_size = static_cast<size_t>(blas_param.ldc) * blas_param.m * std::max(blas_param.c_stride, 1);
+
+          A_size = span(blas_param.a_offset, A_batch_size, a_rows, a_cols, blas_param.lda);
+          B_size = span(blas_param.b_offset, B_batch_size, b_rows, b_cols, blas_param.ldb);
+          C_size = span(blas_param.c_offset, C_batch_size, blas_param.m, blas_param.n, blas_param.ldc);
+        }
+
+        /**
+           @brief Number of data from the start of an array to the end of
+           the last row of the matrix of the last GEMM
+        */
+        size_t span(int offset, size_t batch_size, int rows, int cols, int ld) const
+        {
+          return offset + (n_gemm - 1) * batch_size + static_cast<size_t>(rows - 1) * ld + cols;
+        }
+      };
+
       template <typename EigenMat, typename T>
-      void GEMM(void *A_h, void *B_h, void *C_h, T alpha, T beta, int max_stride, QudaBLASParam &blas_param)
+      void GEMM(void *A_h, void *B_h, void *C_h, T alpha, T beta, const GEMMBatch &batch, QudaBLASParam &blas_param)
       {
         // Problem parameters
         int m = blas_param.m;
         int n = blas_param.n;
-        int k = blas_param.k;
         int lda = blas_param.lda;
         int ldb = blas_param.ldb;
         int ldc = blas_param.ldc;
 
-        // If the user did not set any stride values, we default them to 1
-        // as batch size 0 is an option.
-        int a_stride = blas_param.a_stride == 0 ? 1 : blas_param.a_stride;
-        int b_stride = blas_param.b_stride == 0 ? 1 : blas_param.b_stride;
-        int c_stride = blas_param.c_stride == 0 ? 1 : blas_param.c_stride;
-        int a_offset = blas_param.a_offset;
-        int b_offset = blas_param.b_offset;
-        int c_offset = blas_param.c_offset;
-        int batches = blas_param.batch_count;
-
-        // Number of data between batches
-        unsigned int A_batch_size = blas_param.lda * blas_param.k;
-        if (blas_param.trans_a != QUDA_BLAS_OP_N) A_batch_size = blas_param.lda * blas_param.m;
-        unsigned int B_batch_size = blas_param.ldb * blas_param.n;
-        if (blas_param.trans_b != QUDA_BLAS_OP_N) B_batch_size = blas_param.ldb * blas_param.k;
-        unsigned int C_batch_size = blas_param.ldc * blas_param.n;
+        size_t a_offset = blas_param.a_offset;
+        size_t b_offset = blas_param.b_offset;
+        size_t c_offset = blas_param.c_offset;
 
         T *A_ptr = (T *)(&A_h)[0];
         T *B_ptr = (T *)(&B_h)[0];
         T *C_ptr = (T *)(&C_h)[0];
 
-        // Eigen objects to store data
-        EigenMat Amat = EigenMat::Zero(m, k);
-        EigenMat Bmat = EigenMat::Zero(k, n);
+        // Eigen objects to store data, with A and B in their stored shapes
+        EigenMat Amat = EigenMat::Zero(batch.a_rows, batch.a_cols);
+        EigenMat Bmat = EigenMat::Zero(batch.b_rows, batch.b_cols);
         EigenMat Cmat = EigenMat::Zero(m, n);
 
-        for (int batch = 0; batch < batches; batch += max_stride) {
+        for (uint64_t i = 0; i < batch.n_gemm; i++) {
 
           // Populate Eigen objects
-          fillArray<EigenMat, T>(Amat, A_ptr, m, k, lda, a_offset, true);
-          fillArray<EigenMat, T>(Bmat, B_ptr, k, n, ldb, b_offset, true);
+          fillArray<EigenMat, T>(Amat, A_ptr, batch.a_rows, batch.a_cols, lda, a_offset, true);
+          fillArray<EigenMat, T>(Bmat, B_ptr, batch.b_rows, batch.b_cols, ldb, b_offset, true);
           fillArray<EigenMat, T>(Cmat, C_ptr, m, n, ldc, c_offset, true);
 
           // Apply op(A) and op(B)
+          EigenMat opA, opB;
           switch (blas_param.trans_a) {
-          case QUDA_BLAS_OP_T: Amat.transposeInPlace(); break;
-          case QUDA_BLAS_OP_C: Amat.adjointInPlace(); break;
-          case QUDA_BLAS_OP_N: break;
+          case QUDA_BLAS_OP_T: opA = Amat.transpose(); break;
+          case QUDA_BLAS_OP_C: opA = Amat.adjoint(); break;
+          case QUDA_BLAS_OP_N: opA = Amat; break;
           default: errorQuda("Unknown blas op type %d", blas_param.trans_a);
           }
 
           switch (blas_param.trans_b) {
-          case QUDA_BLAS_OP_T: Bmat.transposeInPlace(); break;
-          case QUDA_BLAS_OP_C: Bmat.adjointInPlace(); break;
-          case QUDA_BLAS_OP_N: break;
+          case QUDA_BLAS_OP_T: opB = Bmat.transpose(); break;
+          case QUDA_BLAS_OP_C: opB = Bmat.adjoint(); break;
+          case QUDA_BLAS_OP_N: opB = Bmat; break;
           default: errorQuda("Unknown blas op type %d", blas_param.trans_b);
           }
 
           // Perform GEMM using Eigen
-          Cmat = alpha * Amat * Bmat + beta * Cmat;
+          Cmat = alpha * opA * opB + beta * Cmat;
 
           // Write back to the C array
           fillArray<EigenMat, T>(Cmat, C_ptr, m, n, ldc, c_offset, false);
 
-          a_offset += A_batch_size * a_stride;
-          b_offset += B_batch_size * b_stride;
-          c_offset += C_batch_size * c_stride;
+          a_offset += batch.A_batch_size;
+          b_offset += batch.B_batch_size;
+          c_offset += batch.C_batch_size;
         }
       }
+
+      /**
+         @brief Zero-copy strided batched GEMM.  The matrices of each
+         batch are mapped in place as row-major matrices with the given
+         leading dimensions, and op(A) and op(B) are applied as Eigen
+         expressions, so no copies or transposes are materialized.  The
+         batches are distributed over the host thread pool.  The
+         parameters must already have been converted to row-major order.
+      */
+      template <typename T>
+      void GEMMZeroCopy(void *A_h, void *B_h, void *C_h, T alpha, T beta, const GEMMBatch &batch,
+                        const QudaBLASParam &blas_param)
+      {
+        using Mat = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+        using ConstMap = Eigen::Map<const Mat, Eigen::Unaligned, Eigen::OuterStride<>>;
+        using Map = Eigen::Map<Mat, Eigen::Unaligned, Eigen::OuterStride<>>;
+
+        // Problem parameters
+        const int m = blas_param.m;
+        const int n = blas_param.n;
+        const int lda = blas_param.lda;
+        const int ldb = blas_param.ldb;
+        const int ldc = blas_param.ldc;
+
+        for (auto trans : {blas_param.trans_a, blas_param.trans_b})
+          if (trans != QUDA_BLAS_OP_N && trans != QUDA_BLAS_OP_T && trans != QUDA_BLAS_OP_C)
+            errorQuda("Unknown blas op type %d", trans);
+
+        const T *A_ptr = static_cast<const T *>(A_h) + blas_param.a_offset;
+        const T *B_ptr = static_cast<const T *>(B_h) + blas_param.b_offset;
+        T *C_ptr = static_cast<T *>(C_h) + blas_param.c_offset;
+
+        // call f with the expression for op(X)
+        auto apply_op = [](QudaBLASOperation trans, const ConstMap &X, auto &&f) {
+          switch (trans) {
+          case QUDA_BLAS_OP_T: f(X.transpose()); break;
+          case QUDA_BLAS_OP_C: f(X.adjoint()); break;
+          default: f(X);
+          }
+        };
+
+        thread_pool::parallel_for(batch.n_gemm, 0, [&](size_t begin, size_t end) {
+          for (size_t i = begin; i < end; i++) {
+            ConstMap A(A_ptr + i * batch.A_batch_size, batch.a_rows, batch.a_cols, Eigen::OuterStride<>(lda));
+            ConstMap B(B_ptr + i * batch.B_batch_size, batch.b_rows, batch.b_cols, Eigen::OuterStride<>(ldb));
+            Map C(C_ptr + i * batch.C_batch_size, m, n, Eigen::OuterStride<>(ldc));
+
+            apply_op(blas_param.trans_a, A, [&](const auto &opA) {
+              apply_op(blas_param.trans_b, B, [&](const auto &opB) {
+                C *= beta;
+                C.noalias() += alpha * opA * opB;
+              });
+            });
+          }
+        });
+      }
       //---------------------------------------------------
 
       // Strided Batched GEMM
@@ -295,8 +498,8 @@ namespace quda
         // If this evaluates to -1, the user did not set any strides.
         if (max_stride <= 0) max_stride = 1;
 
-        // Then number of GEMMs to compute
-        const uint64_t batch = blas_param.batch_count / max_stride;
+        // The number of GEMMs to compute and the extents of the arrays
+        const GEMMBatch batch(blas_param, max_stride);
 
         uint64_t data_size
           = (blas_param.data_type == QUDA_BLAS_DATATYPE_S || blas_param.data_type == QUDA_BLAS_DATATYPE_C) ? 4 : 8;
@@ -305,17 +508,10 @@ namespace quda
           data_size *= 2;
         }
 
-        // Number of data between batches
-        unsigned int A_batch_size = blas_param.lda * blas_param.k;
-        if (blas_param.trans_a != QUDA_BLAS_OP_N) A_batch_size = blas_param.lda * blas_param.m;
-        unsigned int B_batch_size = blas_param.ldb * blas_param.n;
-        if (blas_param.trans_b != QUDA_BLAS_OP_N) B_batch_size = blas_param.ldb * blas_param.k;
-        unsigned int C_batch_size = blas_param.ldc * blas_param.n;
-
         // Data size of the entire array
-        size_t sizeAarr = A_batch_size * data_size * batch;
-        size_t sizeBarr = B_batch_size * data_size * batch;
-        size_t sizeCarr = C_batch_size * data_size * batch;
+        size_t sizeAarr = batch.A_size * data_size;
+        size_t sizeBarr = batch.B_size * data_size;
+        size_t sizeCarr = batch.C_size * data_size;
 
         // If already on the host, just use the given pointer. If the data is on
         // the device, allocate host memory and transfer
@@ -333,32 +529,44 @@ namespace quda
           typedef std::complex<double> Z;
           const Z alpha = blas_param.alpha;
           const Z beta = blas_param.beta;
-          GEMM<MatrixXcd, Z>(A_h, B_h, C_h, alpha, beta, max_stride, blas_param);
-          flops += batch * FLOPS_CGEMM(blas_param.m, blas_param.n, blas_param.k);
+          if (zero_copy_gemm)
+            GEMMZeroCopy<Z>(A_h, B_h, C_h, alpha, beta, batch, blas_param);
+          else
+            GEMM<MatrixXcd, Z>(A_h, B_h, C_h, alpha, beta, batch, blas_param);
+          flops += batch.n_gemm * FLOPS_CGEMM(blas_param.m, blas_param.n, blas_param.k);
 
         } else if (blas_param.data_type == QUDA_BLAS_DATATYPE_C) {
 
           typedef std::complex<float> C;
           const C alpha = blas_param.alpha;
           const C beta = blas_param.beta;
-          GEMM<MatrixXcf, C>(A_h, B_h, C_h, alpha, beta, max_stride, blas_param);
-          flops += batch * FLOPS_CGEMM(blas_param.m, blas_param.n, blas_param.k);
+          if (zero_copy_gemm)
+            GEMMZeroCopy<C>(A_h, B_h, C_h, alpha, beta, batch, blas_param);
+          else
+            GEMM<MatrixXcf, C>(A_h, B_h, C_h, alpha, beta, batch, blas_param);
+          flops += batch.n_gemm * FLOPS_CGEMM(blas_param.m, blas_param.n, blas_param.k);
 
         } else if (blas_param.data_type == QUDA_BLAS_DATATYPE_D) {
 
           typedef double D;
           const D alpha = (D)(static_cast<std::complex<double>>(blas_param.alpha).real());
           const D beta = (D)(static_cast<std::complex<double>>(blas_param.beta).real());
-          GEMM<MatrixXd, D>(A_h, B_h, C_h, alpha, beta, max_stride, blas_param);
-          flops += batch * FLOPS_SGEMM(blas_param.m, blas_param.n, blas_param.k);
+          if (zero_copy_gemm)
+            GEMMZeroCopy<D>(A_h, B_h, C_h, alpha, beta, batch, blas_param);
+          else
+            GEMM<MatrixXd, D>(A_h, B_h, C_h, alpha, beta, batch, blas_param);
+          flops += batch.n_gemm * FLOPS_SGEMM(blas_param.m, blas_param.n, blas_param.k);
 
         } else if (blas_param.data_type == QUDA_BLAS_DATATYPE_S) {
 
           typedef float S;
           const S alpha = (S)(static_cast<std::complex<float>>(blas_param.alpha).real());
           const S beta = (S)(static_cast<std::complex<float>>(blas_param.beta).real());
-          GEMM<MatrixXf, S>(A_h, B_h, C_h, alpha, beta, max_stride, blas_param);
-          flops += batch * FLOPS_SGEMM(blas_param.m, blas_param.n, blas_param.k);
+          if (zero_copy_gemm)
+            GEMMZeroCopy<S>(A_h, B_h, C_h, alpha, beta, batch, blas_param);
+          else
+            GEMM<MatrixXf, S>(A_h, B_h, C_h, alpha, beta, batch, blas_param);
+          flops += batch.n_gemm * FLOPS_SGEMM(blas_param.m, blas_param.n, blas_param.k);
 
         } else {
           errorQuda("blasGEMM type %d not implemented\n", blas_param.data_type);
@@ -388,7 +596,8 @@ namespace quda
         long dus = stop.tv_usec - start.tv_usec;
         double time = ds + 0.000001 * dus;
         if (getVerbosity() >= QUDA_DEBUG_VERBOSE)
-          printfQuda("Batched matrix GEMM completed in %f seconds with GFLOPS = %f\n", time, 1e-9 * flops / time);
+          printfQuda("Batched matrix GEMM (%s) completed in %f seconds with GFLOPS = %f\n",
+                     zero_copy_gemm ? "zero copy" : "copy", time, 1e-9 * flops / time);
 
         return flops;
       }
@@ -0,0 +1,188 @@
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <thread_pool.h>
+#include <util_quda.h>
+
+namespace quda
+{
+
+  namespace thread_pool
+  {
+
+    /**
+       Set for any thread that is currently executing a parallel
+       region (both the pool workers and the calling thread), and is
+       used to serialize nested parallel_for calls.
+    */
+    static thread_local bool in_region = false;
+
+    /**
+       @brief Persistent pool of worker threads.  The workers sleep on
+       a condition variable between jobs, and each job is split into
+       chunks that are claimed from a shared atomic counter.
+    */
+    class Pool
+    {
+      std::vector<std::thread> workers;
+      std::mutex mutex;                 /** protects the job state below */
+      std::condition_variable start_cv; /** signals the workers that a new job is available */
+      std::condition_variable done_cv;  /** signals the caller that all workers have finished */
+
+      const std::function<void(size_t, size_t)> *job = nullptr;
+      size_t n = 0;
+      size_t grain = 1;
+      std::atomic<size_t> next {0};
+      int pending = 0;
+      unsigned long generation = 0;
+      bool stop = false;
+
+      /**
+         @brief Claim and execute chunks of the current job until none remain
+      */
+      void run_chunks()
+      {
+        while (true) {
+          size_t begin = next.fetch_add(grain, std::memory_order_relaxed);
+          if (begin >= n) break;
+          (*job)(begin, std::min(begin + grain, n));
+        }
+      }
+
+      void worker(unsigned long seen)
+      {
+        in_region = true;
+        while (true) {
+          std::unique_lock<std::mutex> lock(mutex);
+          start_cv.wait(lock, [&] { return stop || generation != seen; });
+          if (stop) return;
+          seen = generation;
+          lock.unlock();
+
+          run_chunks();
+
+          lock.lock();
+          if (--pending == 0) done_cv.notify_one();
+        }
+      }
+
+      void spawn(int n_threads)
+      {
+        stop = false;
+        workers.reserve(n_threads - 1);
+        for (int i = 0; i < n_threads - 1; i++) workers.emplace_back([this, g = generation] { worker(g); });
+      }
+
+      void join()
+      {
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          stop = true;
+        }
+        start_cv.notify_all();
+        for (auto &w : workers) w.join();
+        workers.clear();
+      }
+
+    public:
+      std::mutex launch_mutex; /** serializes jobs issued from different client threads */
+
+      Pool(int n_threads)
+      {
+        spawn(n_threads);
+        if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Host thread pool using %d threads\n", size());
+      }
+
+      ~Pool() { join(); }
+
+      int size() const { return workers.size() + 1; }
+
+      void resize(int n_threads)
+      {
+        join();
+        spawn(n_threads);
+      }
+
+      void execute(size_t n_, size_t grain_, const std::function<void(size_t, size_t)> &f)
+      {
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          job = &f;
+          n = n_;
+          grain = grain_;
+          next.store(0, std::memory_order_relaxed);
+          pending = workers.size();
+          generation++;
+        }
+        start_cv.notify_all();
+
+        in_region = true;
+        run_chunks();
+        in_region = false;
+
+        std::unique_lock<std::mutex> lock(mutex);
+        done_cv.wait(lock, [&] { return pending == 0; });
+        job = nullptr;
+      }
+    };
+
+    static int hardware_threads()
+    {
+      int n = std::thread::hardware_concurrency();
+      return n > 0 ? n : 1;
+    }
+
+    // default is serial execution but can be overridden with the QUDA_HOST_THREADS environment variable
+    static int default_threads()
+    {
+      char *host_threads_env = getenv("QUDA_HOST_THREADS");
+      if (!host_threads_env) return 1;
+      int n = atoi(host_threads_env);
+      return n > 0 ? n : hardware_threads();
+    }
+
+    static Pool &get_pool()
+    {
+      static Pool pool(default_threads());
+      return pool;
+    }
+
+    int get_num_threads() { return get_pool().size(); }
+
+    void set_num_threads(int n_threads)
+    {
+      if (in_region) errorQuda("Cannot resize the host thread pool from within a parallel region");
+      auto &pool = get_pool();
+      std::lock_guard<std::mutex> lock(pool.launch_mutex);
+      pool.resize(n_threads > 0 ? n_threads : hardware_threads());
+    }
+
+    bool in_parallel() { return in_region; }
+
+    void parallel_for(size_t n, size_t grain, const std::function<void(size_t, size_t)> &f)
+    {
+      if (n == 0) return;
+      auto &pool = get_pool();
+      int n_threads = in_region ? 1 : pool.size();
+
+      // default to four chunks per thread to balance the load
+      if (grain == 0) grain = std::max(n / (4 * n_threads), static_cast<size_t>(1));
+
+      if (n_threads == 1 || n <= grain) {
+        for (size_t begin = 0; begin < n; begin += grain) f(begin, std::min(begin + grain, n));
+        return;
+      }
+
+      std::lock_guard<std::mutex> lock(pool.launch_mutex);
+      pool.execute(n, grain, f);
+    }
+
+  } // namespace thread_pool
+
+} // namespace quda
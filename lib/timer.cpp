@@ -136,11 +136,30 @@ namespace quda {
 #define POP_RANGE
 #endif
 
+  void TimeProfile::StartTimer(const char *func, const char *file, int line, QudaProfileType idx)
+  {
+    bool running = profile[idx].running;
+    profile[idx].start(func, file, line);
+    if (!running && trace::enabled()) trace_start[idx] = trace::now();
+  }
+
+  bool TimeProfile::StopTimer(const char *func, const char *file, int line, QudaProfileType idx)
+  {
+    bool rtn = profile[idx].stop(func, file, line);
+    if (rtn && !profile[idx].running && trace::enabled() && trace_start[idx] != 0) {
+      if (trace_id[idx] == 0)
+        trace_id[idx] = trace::intern(idx == QUDA_PROFILE_TOTAL ? fname : fname + ":" + pname[idx]);
+      trace::record(trace_id[idx], trace_start[idx], trace::now());
+      trace_start[idx] = 0;
+    }
+    return rtn;
+  }
+
   void TimeProfile::StartTotal(const char *func, const char *file, int line, QudaProfileType idx)
   {
     // if total timer isn't running, then start it running
     if (!profile[QUDA_PROFILE_TOTAL].running && idx != QUDA_PROFILE_TOTAL) {
-      profile[QUDA_PROFILE_TOTAL].start(func, file, line);
+      StartTimer(func, file, line, QUDA_PROFILE_TOTAL);
       switchOff = true;
     }
   }
@@ -149,7 +168,7 @@ namespace quda {
   {
     // switch off total timer if we need to
     if (switchOff && idx != QUDA_PROFILE_TOTAL) {
-      profile[QUDA_PROFILE_TOTAL].stop(func, file, line);
+      StopTimer(func, file, line, QUDA_PROFILE_TOTAL);
       switchOff = false;
     }
   }
@@ -164,14 +183,14 @@ namespace quda {
         if ((i == QUDA_PROFILE_COMPUTE || i == QUDA_PROFILE_H2D || i == QUDA_PROFILE_D2H)
             && i != idx) // don't synchronize if nesting the same profile type
           qudaDeviceSynchronize();
-        profile[i].stop(file, func, line);
+        StopTimer(file, func, line, static_cast<QudaProfileType>(i));
         if (use_global) StopGlobal(func, file, line, static_cast<QudaProfileType>(i));
         POP_RANGE;
         pt_stack.push(static_cast<QudaProfileType>(i));
       }
     }
 
-    profile[idx].start(func, file, line);
+    StartTimer(func, file, line, idx);
     PUSH_RANGE(fname.c_str(), idx);
     if (use_global) StartGlobal(func, file, line, idx);
   }
@@ -183,7 +202,7 @@ namespace quda {
         && i != idx)           // don't synchronize if nesting same profile type
       qudaDeviceSynchronize(); // ensure accurate profiling
 
-    if (!profile[idx].stop(func, file, line)) {
+    if (!StopTimer(func, file, line, idx)) {
       for (auto i = 0; i < QUDA_PROFILE_COUNT - 1; i++)
         if (profile[i].running) errorQuda("Failed to stop timer idx = %d, however idx = %d is running", idx, i);
       errorQuda("Failed to stop timer idx = %d", idx);
@@ -197,7 +216,7 @@ namespace quda {
       // restore any pre-existing timers if needed
       auto i = pt_stack.top();
       pt_stack.pop();
-      profile[i].start(func, file, line);
+      StartTimer(func, file, line, i);
       PUSH_RANGE(fname.c_str(), i);
       if (use_global) StartGlobal(func, file, line, i);
     }
@@ -0,0 +1,199 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <trace_profile.h>
+#include <comm_quda.h>
+#include <util_quda.h>
+
+namespace quda
+{
+
+  namespace trace
+  {
+
+    struct event_t {
+      int id;
+      uint64_t start;
+      uint64_t end;
+    };
+
+    /**
+       Per-thread trace state: a ring buffer of the most recent spans
+       and a histogram per span name.  The mutex is only contended when
+       the trace is dumped.
+    */
+    struct ThreadBuffer {
+      int tid;
+      std::mutex mutex;
+      std::vector<event_t> events;
+      size_t n_recorded = 0; /** total number of events recorded, the next is written to n_recorded % size */
+      std::unordered_map<int, log_histogram> histograms;
+
+      ThreadBuffer(int tid, size_t size) : tid(tid), events(size) { }
+    };
+
+    /**
+       Global trace state.  Buffers are retained after their thread
+       exits so that its spans are included in the dump.
+    */
+    struct Tracer {
+      std::mutex mutex; /** protects the members below */
+      std::vector<std::string> names {""};
+      std::unordered_map<std::string, int> ids;
+      std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+      size_t buffer_size = 1 << 16;
+      uint64_t epoch = now();  /** monotonic time that the timestamps of the trace are relative to */
+      int64_t epoch_wall = 0; /** wall-clock time at the epoch in nanoseconds since the Unix epoch */
+      std::atomic<bool> enabled = false;
+
+      Tracer()
+      {
+        char *enable_env = getenv("QUDA_ENABLE_PROFILE_TRACE");
+        if (enable_env && strcmp(enable_env, "0")) enabled = true;
+        char *buffer_env = getenv("QUDA_PROFILE_TRACE_BUFFER");
+        if (buffer_env) buffer_size = std::max(atol(buffer_env), 1l);
+        set_epoch();
+      }
+
+      void set_epoch()
+      {
+        epoch = now();
+        epoch_wall = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::system_clock::now().time_since_epoch())
+                       .count();
+      }
+    };
+
+    static Tracer &get_tracer()
+    {
+      static Tracer *tracer = new Tracer; // never destroyed, so that it outlives any thread buffers
+      return *tracer;
+    }
+
+    static ThreadBuffer &get_buffer()
+    {
+      static thread_local ThreadBuffer *buffer = nullptr;
+      if (!buffer) {
+        auto &tracer = get_tracer();
+        std::lock_guard<std::mutex> lock(tracer.mutex);
+        tracer.buffers.push_back(std::make_unique<ThreadBuffer>(tracer.buffers.size(), tracer.buffer_size));
+        buffer = tracer.buffers.back().get();
+      }
+      return *buffer;
+    }
+
+    void init()
+    {
+      // the barrier is unconditional so that ranks with differing environments cannot deadlock
+      comm_barrier();
+      auto &tracer = get_tracer();
+      std::lock_guard<std::mutex> lock(tracer.mutex);
+      tracer.set_epoch();
+    }
+
+    bool enabled() { return get_tracer().enabled; }
+
+    void set_enabled(bool enable) { get_tracer().enabled = enable; }
+
+    int intern(const std::string &name)
+    {
+      auto &tracer = get_tracer();
+      std::lock_guard<std::mutex> lock(tracer.mutex);
+      auto it = tracer.ids.find(name);
+      if (it != tracer.ids.end()) return it->second;
+      int id = tracer.names.size();
+      tracer.names.push_back(name);
+      tracer.ids[name] = id;
+      return id;
+    }
+
+    void record(int id, uint64_t start, uint64_t end)
+    {
+      auto &buffer = get_buffer();
+      std::lock_guard<std::mutex> lock(buffer.mutex);
+      buffer.events[buffer.n_recorded++ % buffer.events.size()] = {id, start, end};
+      buffer.histograms[id].add(end - start);
+    }
+
+    /**
+       @brief Escape a string for inclusion in JSON
+    */
+    static std::string escape(const std::string &s)
+    {
+      std::string out;
+      for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+      }
+      return out;
+    }
+
+    void dump()
+    {
+      auto &tracer = get_tracer();
+      if (!tracer.enabled) return;
+      std::lock_guard<std::mutex> lock(tracer.mutex);
+
+      char *path = getenv("QUDA_RESOURCE_PATH");
+      std::string base = std::string(path ? path : ".") + "/";
+      const int rank = comm_rank_global();
+      const std::string trace_path = base + "trace_rank" + std::to_string(rank) + ".json";
+      const std::string hist_path = base + "trace_hist_rank" + std::to_string(rank) + ".tsv";
+
+      std::ofstream trace_file(trace_path);
+      trace_file << "{\"displayTimeUnit\":\"ns\",\"otherData\":{\"epoch_wall_ns\":" << tracer.epoch_wall
+                 << "},\"traceEvents\":[\n";
+      trace_file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << rank << ",\"args\":{\"name\":\"rank " << rank
+                 << "\"}}";
+
+      std::map<int, log_histogram> histograms;
+      size_t n_dropped = 0;
+      char event[256];
+      for (auto &buffer : tracer.buffers) {
+        std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+        const size_t size = buffer->events.size();
+        const size_t n = std::min(buffer->n_recorded, size);
+        n_dropped += buffer->n_recorded - n;
+
+        // events are written oldest first
+        for (size_t i = buffer->n_recorded - n; i < buffer->n_recorded; i++) {
+          auto &e = buffer->events[i % size];
+          snprintf(event, sizeof(event),
+                   ",\n{\"ph\":\"X\",\"cat\":\"quda\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,", rank,
+                   buffer->tid, static_cast<int64_t>(e.start - tracer.epoch) * 1e-3, (e.end - e.start) * 1e-3);
+          trace_file << event << "\"name\":\"" << escape(tracer.names[e.id]) << "\"}";
+        }
+
+        for (auto &h : buffer->histograms) histograms[h.first].merge(h.second);
+        buffer->n_recorded = 0;
+        buffer->histograms.clear();
+      }
+      trace_file << "\n]}\n";
+
+      std::ofstream hist_file(hist_path);
+      hist_file << "# times in microseconds\n";
+      hist_file << "name\tcount\ttotal\tmean\tp50\tp90\tp99\tmax\n";
+      for (auto &h : histograms) {
+        const log_histogram &hist = h.second;
+        hist_file << tracer.names[h.first] << "\t" << hist.count() << "\t" << hist.sum() * 1e-3 << "\t"
+                  << hist.sum() * 1e-3 / hist.count() << "\t" << hist.percentile(50) * 1e-3 << "\t"
+                  << hist.percentile(90) * 1e-3 << "\t" << hist.percentile(99) * 1e-3 << "\t" << hist.max() * 1e-3
+                  << "\n";
+      }
+
+      if (n_dropped > 0)
+        warningQuda("%lu trace events were overwritten; increase QUDA_PROFILE_TRACE_BUFFER to retain them", n_dropped);
+      logQuda(QUDA_SUMMARIZE, "Saved trace to %s and span histograms to %s\n", trace_path.c_str(), hist_path.c_str());
+    }
+
+  } // namespace trace
+
+} // namespace quda
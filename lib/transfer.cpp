@@ -7,9 +7,12 @@
 #include <multigrid.h>
 #include <tune_quda.h>
 #include <malloc_quda.h>
+#include <thread_pool.h>
 
 #include <iostream>
 #include <algorithm>
+#include <map>
+#include <numeric>
 #include <vector>
 #include <limits>
 
@@ -99,9 +102,6 @@ namespace quda {
     createTmp();                           // allocate temporaries (needed for geomap creation)
 
     // allocate and compute the fine-to-coarse and coarse-to-fine site maps
-    fine_to_coarse_h = static_cast<int *>(pool_pinned_malloc(B[0].Volume() * sizeof(int)));
-    coarse_to_fine_h = static_cast<int *>(pool_pinned_malloc(B[0].Volume() * sizeof(int)));
-
     if (enable_gpu) {
       fine_to_coarse_d = static_cast<int *>(pool_device_malloc(B[0].Volume() * sizeof(int)));
       coarse_to_fine_d = static_cast<int *>(pool_device_malloc(B[0].Volume() * sizeof(int)));
@@ -243,8 +243,6 @@ namespace quda {
     }
     if (coarse_to_fine_d) pool_device_free(coarse_to_fine_d);
     if (fine_to_coarse_d) pool_device_free(fine_to_coarse_d);
-    if (coarse_to_fine_h) pool_pinned_free(coarse_to_fine_h);
-    if (fine_to_coarse_h) pool_pinned_free(fine_to_coarse_h);
 
     if (geo_bs) delete []geo_bs;
   }
@@ -259,48 +257,121 @@ namespace quda {
     site_subset = site_subset_;
   }
 
-  struct Int2 {
-    int x, y;
-    Int2() : x(0), y(0) { } 
-    Int2(int x, int y) : x(x), y(y) { } 
-    
-    bool operator<(const Int2 &a) const {
-      return (x < a.x) ? true : (x==a.x && y<a.y) ? true : false;
+  struct GeoMap {
+    int *fine_to_coarse;
+    int *coarse_to_fine;
+
+    GeoMap(size_t volume) :
+      fine_to_coarse(static_cast<int *>(pool_pinned_malloc(volume * sizeof(int)))),
+      coarse_to_fine(static_cast<int *>(pool_pinned_malloc(volume * sizeof(int))))
+    {
+    }
+
+    GeoMap(const GeoMap &) = delete;
+    GeoMap &operator=(const GeoMap &) = delete;
+
+    ~GeoMap()
+    {
+      pool_pinned_free(coarse_to_fine);
+      pool_pinned_free(fine_to_coarse);
     }
   };
 
-  // compute the fine-to-coarse site map
-  void Transfer::createGeoMap(int *geo_bs) {
+  /** Cache of the geometry maps, keyed by the fine and coarse geometry and the block size */
+  static std::map<std::string, std::shared_ptr<const GeoMap>> geo_map_cache;
 
-    int x[QUDA_MAX_DIM];
+  void flushGeoMapCache() { geo_map_cache.clear(); }
 
-    ColorSpinorField &fine(fine_tmp_h);
-    ColorSpinorField &coarse(coarse_tmp_h);
+  /*
+     The coarse-to-fine map is built with a counting sort over the
+     aggregates: the fine sites are split into one contiguous chunk
+     per thread, each chunk is histogrammed over the aggregates, and a
+     prefix sum over (aggregate, chunk) gives where each chunk writes
+     its sites of each aggregate.
+   */
+  void computeGeoMap(int *fine_to_coarse, int *coarse_to_fine, const ColorSpinorField &fine,
+                     const ColorSpinorField &coarse, const int *geo_bs)
+  {
+    const size_t volume = fine.Volume();
+    const size_t coarse_volume = coarse.Volume();
+
+    constexpr size_t min_chunk = 16384;
+    const size_t n_chunk = std::min(static_cast<size_t>(thread_pool::get_num_threads()),
+                                    std::max(volume / min_chunk, static_cast<size_t>(1)));
+    const size_t grain = (volume + n_chunk - 1) / n_chunk;
+    std::vector<int> count(n_chunk * coarse_volume, 0);
 
     // compute the coarse grid point for every site (assuming parity ordering currently)
-    for (size_t i = 0; i < fine.Volume(); i++) {
-      // compute the lattice-site index for this offset index
-      fine.LatticeIndex(x, i);
-      
-      //printfQuda("fine idx %d = fine (%d,%d,%d,%d), ", i, x[0], x[1], x[2], x[3]);
+    thread_pool::parallel_for(volume, grain, [&](size_t begin, size_t end) {
+      int *chunk_count = count.data() + (begin / grain) * coarse_volume;
+      int x[QUDA_MAX_DIM];
+      for (size_t i = begin; i < end; i++) {
+        // compute the lattice-site index for this offset index
+        fine.LatticeIndex(x, i);
+
+        // compute the corresponding coarse-grid index given the block size
+        for (int d = 0; d < fine.Ndim(); d++) x[d] /= geo_bs[d];
+
+        // compute the coarse-offset index and store in fine_to_coarse
+        int k;
+        coarse.OffsetIndex(k, x); // this index is parity ordered
+        fine_to_coarse[i] = k;
+        chunk_count[k]++;
+      }
+    });
+
+    // exclusive prefix sum over the aggregates, and then over the chunks within each aggregate
+    std::vector<int> aggregate_offset(coarse_volume + 1, 0);
+    thread_pool::parallel_for(coarse_volume, 0, [&](size_t begin, size_t end) {
+      for (size_t k = begin; k < end; k++) {
+        int sum = 0;
+        for (size_t c = 0; c < n_chunk; c++) sum += count[c * coarse_volume + k];
+        aggregate_offset[k + 1] = sum;
+      }
+    });
+    std::partial_sum(aggregate_offset.begin(), aggregate_offset.end(), aggregate_offset.begin());
+
+    thread_pool::parallel_for(coarse_volume, 0, [&](size_t begin, size_t end) {
+      for (size_t k = begin; k < end; k++) {
+        int offset = aggregate_offset[k];
+        for (size_t c = 0; c < n_chunk; c++) {
+          const int n = count[c * coarse_volume + k];
+          count[c * coarse_volume + k] = offset;
+          offset += n;
+        }
+      }
+    });
 
-      // compute the corresponding coarse-grid index given the block size
-      for (int d=0; d<fine.Ndim(); d++) x[d] /= geo_bs[d];
+    // now create an inverse-like variant of this
+    thread_pool::parallel_for(volume, grain, [&](size_t begin, size_t end) {
+      int *chunk_offset = count.data() + (begin / grain) * coarse_volume;
+      for (size_t i = begin; i < end; i++) coarse_to_fine[chunk_offset[fine_to_coarse[i]]++] = i;
+    });
+  }
 
-      // compute the coarse-offset index and store in fine_to_coarse
-      int k;
-      coarse.OffsetIndex(k, x); // this index is parity ordered
-      fine_to_coarse_h[i] = k;
+  // compute the fine-to-coarse site map
+  void Transfer::createGeoMap(int *geo_bs) {
 
-      //printfQuda("coarse after (%d,%d,%d,%d), coarse idx %d\n", x[0], x[1], x[2], x[3], k);
-    }
+    ColorSpinorField &fine(fine_tmp_h);
+    ColorSpinorField &coarse(coarse_tmp_h);
 
-    // now create an inverse-like variant of this
+    std::string key = "fine=" + std::string(fine.VolString()) + ",subset=" + std::to_string(fine.SiteSubset());
+    key += ",coarse=" + std::string(coarse.VolString()) + ",subset=" + std::to_string(coarse.SiteSubset());
+    key += ",block=" + std::to_string(geo_bs[0]);
+    for (int d = 1; d < fine.Ndim(); d++) key += "x" + std::to_string(geo_bs[d]);
 
-    std::vector<Int2> geo_sort(B[0].Volume());
-    for (unsigned int i=0; i<geo_sort.size(); i++) geo_sort[i] = Int2(fine_to_coarse_h[i], i);
-    std::sort(geo_sort.begin(), geo_sort.end());
-    for (unsigned int i=0; i<geo_sort.size(); i++) coarse_to_fine_h[i] = geo_sort[i].y;
+    auto it = geo_map_cache.find(key);
+    if (it != geo_map_cache.end()) {
+      logQuda(QUDA_DEBUG_VERBOSE, "Transfer: reusing geometry map %s\n", key.c_str());
+      geo_map = it->second;
+    } else {
+      auto map = std::make_shared<GeoMap>(B[0].Volume());
+      computeGeoMap(map->fine_to_coarse, map->coarse_to_fine, fine, coarse, geo_bs);
+      geo_map = map;
+      geo_map_cache[key] = geo_map;
+    }
+    fine_to_coarse_h = geo_map->fine_to_coarse;
+    coarse_to_fine_h = geo_map->coarse_to_fine;
 
     if (enable_gpu) {
       qudaMemcpy(fine_to_coarse_d, fine_to_coarse_h, B[0].Volume() * sizeof(int), qudaMemcpyHostToDevice);
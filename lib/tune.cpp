@@ -2,7 +2,9 @@
 #include <comm_quda.h>
 #include <quda.h>     // for QUDA_VERSION_STRING
 #include <timer.h>
+#include <trace_profile.h>
 #include <sys/stat.h> // for stat()
+#include <sys/mman.h> // for mmap()
 #include <fcntl.h>
 #include <cfloat> // for FLT_MAX
 #include <ctime>
@@ -15,6 +17,7 @@
 #include <target_device.h>
 
 #include <deque>
+#include <unordered_map>
 #include <queue>
 #include <functional>
 #include <utility>
@@ -103,8 +106,119 @@ namespace quda
   static const std::string quda_hash = QUDA_HASH; // defined in lib/Makefile
   static std::string resource_path;
   static map tunecache;
-  static map::iterator it;
   static size_t initial_cache_size = 0;
+  static bool binary_cache_stale = false; /** binary tunecache needs writing though the tunecache is unchanged */
+  static std::vector<const map::value_type *> dirty_entries; /** entries inserted or updated since the last save */
+
+  /**
+     @brief Flat open-addressing (linear probing) hash table that
+     indexes the entries of the tunecache map by their key hash.  A
+     lookup costs a single hash of the key and, for a hit, a single
+     key comparison, as opposed to the O(log n) string comparisons of
+     the std::map lookup.  Since map entries are never erased, the
+     entry pointers held in the table remain valid.  Every insertion
+     into the tunecache, whether when loading from disk, receiving
+     the broadcast cache or tuning, goes through tuneCacheInsert, so
+     the index is always in sync, and the read path requires no
+     locking.
+   */
+  class TuneCacheIndex
+  {
+    struct slot_t {
+      uint64_t hash = 0;
+      map::value_type *entry = nullptr;
+    };
+
+    std::vector<slot_t> slots;
+    size_t n_entry = 0;
+
+    void insert_slot(uint64_t hash, map::value_type *entry)
+    {
+      const size_t mask = slots.size() - 1;
+      size_t i = hash & mask;
+      while (slots[i].entry) i = (i + 1) & mask;
+      slots[i] = {hash, entry};
+      n_entry++;
+    }
+
+    /**
+       @brief Rebuild the index from the tunecache, sizing the table
+       so that the load factor is at most one half
+    */
+    void rehash(size_t size)
+    {
+      size_t capacity = 64;
+      while (capacity < 2 * size) capacity *= 2;
+      slots.assign(capacity, slot_t());
+      n_entry = 0;
+      for (auto &entry : tunecache) insert_slot(entry.first.hash(), &entry);
+    }
+
+    /**
+       @brief Check that the index covers every tunecache entry.  Every
+       insertion into the tunecache must go through tuneCacheInsert.
+    */
+    void check() const
+    {
+      if (n_entry != tunecache.size())
+        errorQuda("Tunecache index is out of sync (%lu indexed, %lu entries)", n_entry, tunecache.size());
+    }
+
+  public:
+    /**
+       @brief Add a newly inserted tunecache entry to the index
+       @param[in] entry The tunecache entry
+    */
+    void insert(map::value_type &entry)
+    {
+      if (2 * (n_entry + 1) > slots.size()) {
+        rehash(tunecache.size()); // grow the table, this includes the new entry
+      } else {
+        insert_slot(entry.first.hash(), &entry);
+      }
+      check();
+    }
+
+    /**
+       @brief Find the tunecache entry corresponding to a given key
+       @param[in] key The key we are searching for
+       @return Pointer to the entry, or nullptr if not present
+    */
+    map::value_type *find(const TuneKey &key)
+    {
+      check();
+      if (slots.empty()) return nullptr;
+      const uint64_t hash = key.hash();
+      const size_t mask = slots.size() - 1;
+      for (size_t i = hash & mask; slots[i].entry; i = (i + 1) & mask) {
+        if (slots[i].hash == hash && slots[i].entry->first == key) return slots[i].entry;
+      }
+      return nullptr;
+    }
+  };
+
+  static TuneCacheIndex tune_index;
+
+  /**
+     @brief Insert or update an entry in the tunecache, keeping the
+     hashed index up to date.  Entries tuned by this process are
+     marked dirty, so that they are appended at the next save.  Entries
+     received from a file or from another process are only marked
+     dirty if they are new to this process: these are the entries
+     tuned on a tuning rank other than process 0, which process 0 must
+     save, while the rest of the broadcast cache is already on disk.
+     @param[in] key The key of the entry
+     @param[in] param The launch parameters
+     @param[in] local Whether the entry was tuned by this process
+     @return Reference to the entry in the tunecache
+  */
+  static map::value_type &tuneCacheInsert(const TuneKey &key, const TuneParam &param, bool local = true)
+  {
+    auto [entry, inserted] = tunecache.insert_or_assign(key, param);
+    if (inserted) tune_index.insert(*entry);
+    if (local || inserted) dirty_entries.push_back(&*entry);
+    return *entry;
+  }
 
 #define STR_(x) #x
 #define STR(x) STR_(x)
@@ -126,10 +240,23 @@ namespace quda
 
   const map &getTuneCache() { return tunecache; }
 
+  /**
+     @brief Insert a deserialized entry into a tunecache, using
+     tuneCacheInsert when this is the global tunecache so that its
+     index is updated
+  */
+  static void cacheInsert(map &cache, const TuneKey &key, const TuneParam &param)
+  {
+    if (&cache == &tunecache)
+      tuneCacheInsert(key, param, false);
+    else
+      cache.insert_or_assign(key, param);
+  }
+
   /**
    * Deserialize tunecache from an istream, useful for reading a file or receiving from other nodes.
    */
-  static void deserializeTuneCache(std::istream &in)
+  static void deserializeTuneCache(std::istream &in, map &cache = tunecache)
   {
     std::string line;
     std::stringstream ls;
@@ -160,18 +287,16 @@ namespace quda
       ls.ignore(1);               // throw away tab before comment
       getline(ls, param.comment); // assume anything remaining on the line is a comment
       param.comment += "\n";      // our convention is to include the newline, since ctime() likes to do this
-      tunecache[key] = param;
+      cacheInsert(cache, key, param);
     }
   }
 
   /**
    * Serialize tunecache to an ostream, useful for writing to a file or sending to other nodes.
    */
-  static void serializeTuneCache(std::ostream &out)
+  static void serializeTuneCache(std::ostream &out, const map &cache = tunecache)
   {
-    map::iterator entry;
-
-    for (entry = tunecache.begin(); entry != tunecache.end(); entry++) {
+    for (auto entry = cache.begin(); entry != cache.end(); entry++) {
       TuneKey key = entry->first;
       TuneParam param = entry->second;
 
@@ -184,6 +309,548 @@ namespace quda
     }
   }
 
+  /**
+     @brief The version fields that head a tunecache file, common to
+     both the text and binary formats
+  */
+  struct TuneCacheHeader {
+    std::string quda_version;
+    std::string git_version;
+    std::string quda_hash;
+  };
+
+  /**
+     @brief Return the tunecache header fields of the present build
+  */
+  static TuneCacheHeader currentTuneCacheHeader()
+  {
+#ifdef GITVERSION
+    return {quda_version, gitversion, quda_hash};
+#else
+    return {quda_version, quda_version, quda_hash};
+#endif
+  }
+
+  /**
+     @brief Check that a tunecache header matches the present build,
+     erroring out if not
+     @param[in] header The header read from the cache file
+     @param[in] cache_path The path of the cache file
+  */
+  static void checkTuneCacheHeader(const TuneCacheHeader &header, const std::string &cache_path)
+  {
+    auto current = currentTuneCacheHeader();
+    if (header.quda_version.compare(current.quda_version) || header.git_version.compare(current.git_version))
+      errorQuda("Cache file %s does not match current QUDA version. \nPlease delete this file or set the "
+                "QUDA_RESOURCE_PATH environment variable to point to a new path.",
+                cache_path.c_str());
+    if (header.quda_hash.compare(current.quda_hash))
+      errorQuda("Cache file %s does not match current QUDA build. \nPlease delete this file or set the "
+                "QUDA_RESOURCE_PATH environment variable to point to a new path.",
+                cache_path.c_str());
+  }
+
+  /**
+     The binary tunecache format.  The file consists of a fixed-size
+     header, holding the same version fields as the header of the text
+     format, followed by an array of fixed-size records, one per
+     tunecache entry.  Since the records are fixed size, the file can
+     be memory mapped and parsed in place, and newly tuned entries can
+     be appended without rewriting the file.  When a key appears more
+     than once the last record takes precedence, and the file is
+     compacted once the superseded records make up more than half of
+     it.  The format is
+     native endian, as with the tuned parameters themselves it is not
+     intended to be moved between different systems.
+  */
+  namespace tunecache_binary
+  {
+
+    constexpr char magic[8] = {'Q', 'U', 'D', 'A', 'T', 'U', 'N', 'E'};
+    constexpr uint32_t format_version = 1;
+    constexpr int string_n = 256;
+    constexpr int comment_n = 256;
+
+    /** the file is compacted when appending would take the number of records above this multiple of the entries */
+    constexpr size_t max_record_ratio = 2;
+
+    struct header_t {
+      char magic[8];
+      uint32_t format_version;
+      uint32_t record_size;
+      char quda_version[string_n];
+      char git_version[string_n];
+      char quda_hash[string_n];
+    };
+
+    struct record_t {
+      char volume[TuneKey::volume_n];
+      char name[TuneKey::name_n];
+      char aux[TuneKey::aux_n];
+      uint32_t block[3];
+      uint32_t grid[3];
+      uint32_t shared_bytes;
+      int32_t param_aux[4];
+      float time;
+      char comment[comment_n];
+    };
+
+    static void copy_string(char *dst, const std::string &src, int n, const char *field)
+    {
+      if (src.size() >= static_cast<size_t>(n)) errorQuda("Tunecache %s string too long (%lu)", field, src.size());
+      memset(dst, 0, n);
+      memcpy(dst, src.c_str(), src.size());
+    }
+
+    static header_t make_header(const TuneCacheHeader &h)
+    {
+      header_t header;
+      memset(&header, 0, sizeof(header));
+      memcpy(header.magic, magic, sizeof(magic));
+      header.format_version = format_version;
+      header.record_size = sizeof(record_t);
+      copy_string(header.quda_version, h.quda_version, string_n, "version");
+      copy_string(header.git_version, h.git_version, string_n, "git version");
+      copy_string(header.quda_hash, h.quda_hash, string_n, "hash");
+      return header;
+    }
+
+    static record_t make_record(const TuneKey &key, const TuneParam &param)
+    {
+      record_t record;
+      memset(&record, 0, sizeof(record)); // ensure there are no uninitialized bytes written to disk
+      strncpy(record.volume, key.volume, TuneKey::volume_n - 1);
+      strncpy(record.name, key.name, TuneKey::name_n - 1);
+      strncpy(record.aux, key.aux, TuneKey::aux_n - 1);
+      record.block[0] = param.block.x;
+      record.block[1] = param.block.y;
+      record.block[2] = param.block.z;
+      record.grid[0] = param.grid.x;
+      record.grid[1] = param.grid.y;
+      record.grid[2] = param.grid.z;
+      record.shared_bytes = param.shared_bytes;
+      record.param_aux[0] = param.aux.x;
+      record.param_aux[1] = param.aux.y;
+      record.param_aux[2] = param.aux.z;
+      record.param_aux[3] = param.aux.w;
+      record.time = param.time;
+      // the comment is truncated if needed, retaining the trailing newline
+      std::string comment = param.comment.substr(0, comment_n - 1);
+      if (comment.size() && comment.back() != '\n') comment.back() = '\n';
+      memcpy(record.comment, comment.c_str(), comment.size());
+      return record;
+    }
+
+    static void read_record(const record_t &record, TuneKey &key, TuneParam &param)
+    {
+      key = TuneKey(record.volume, record.name, record.aux);
+      param.block = dim3(record.block[0], record.block[1], record.block[2]);
+      param.grid = dim3(record.grid[0], record.grid[1], record.grid[2]);
+      param.shared_bytes = record.shared_bytes;
+      param.aux = make_int4(record.param_aux[0], record.param_aux[1], record.param_aux[2], record.param_aux[3]);
+      param.time = record.time;
+      param.comment = std::string(record.comment, strnlen(record.comment, comment_n));
+    }
+
+  } // namespace tunecache_binary
+
+  /**
+     @brief Serialize a tunecache to a byte buffer of binary records,
+     used for writing to the binary cache file or sending to other nodes
+     @param[out] out The buffer the records are appended to
+     @param[in] cache The tunecache being serialized
+  */
+  static void serializeTuneCacheBinary(std::vector<char> &out, const map &cache = tunecache)
+  {
+    using namespace tunecache_binary;
+    size_t offset = out.size();
+    out.resize(offset + cache.size() * sizeof(record_t));
+    for (auto &entry : cache) {
+      record_t record = make_record(entry.first, entry.second);
+      memcpy(out.data() + offset, &record, sizeof(record));
+      offset += sizeof(record);
+    }
+  }
+
+  /**
+     @brief Deserialize an array of binary records into a tunecache
+     @param[in] data Pointer to the records
+     @param[in] n_record The number of records
+     @param[in,out] cache The tunecache the records are inserted into
+  */
+  static void deserializeTuneCacheBinary(const char *data, size_t n_record, map &cache = tunecache)
+  {
+    using namespace tunecache_binary;
+    TuneKey key;
+    TuneParam param;
+    for (size_t i = 0; i < n_record; i++) {
+      record_t record;
+      memcpy(&record, data + i * sizeof(record_t), sizeof(record)); // the mapping may not be suitably aligned
+      read_record(record, key, param);
+      cacheInsert(cache, key, param);
+    }
+  }
+
+  /**
+     @brief Read a text tunecache file
+     @param[in] cache_path The path of the file
+     @param[out] cache The tunecache the entries are inserted into
+     @param[out] header The header fields of the file
+     @param[in] version_check Whether to check the header matches the
+     present build
+     @return Whether the file was found
+  */
+  static bool readTuneCacheText(const std::string &cache_path, map &cache, TuneCacheHeader &header, bool version_check)
+  {
+    std::string line, token;
+    std::stringstream ls;
+    std::ifstream cache_file(cache_path.c_str());
+    if (!cache_file) return false;
+
+    if (!cache_file.good()) errorQuda("Bad format in %s", cache_path.c_str());
+    getline(cache_file, line);
+    ls.str(line);
+    ls >> token;
+    if (token.compare("tunecache")) errorQuda("Bad format in %s", cache_path.c_str());
+    ls >> header.quda_version >> header.git_version >> header.quda_hash;
+    if (version_check) checkTuneCacheHeader(header, cache_path);
+
+    if (!cache_file.good()) errorQuda("Bad format in %s", cache_path.c_str());
+    getline(cache_file, line); // eat the blank line
+
+    if (!cache_file.good()) errorQuda("Bad format in %s", cache_path.c_str());
+    getline(cache_file, line); // eat the description line
+
+    deserializeTuneCache(cache_file, cache);
+    return true;
+  }
+
+  /**
+     @brief Write a text tunecache file, overwriting any existing file
+     @param[in] cache_path The path of the file
+     @param[in] cache The tunecache being written
+     @param[in] header The header fields to write
+  */
+  static void writeTuneCacheText(const std::string &cache_path, const map &cache, const TuneCacheHeader &header)
+  {
+    time_t now;
+    std::ofstream cache_file(cache_path.c_str());
+    if (!cache_file) errorQuda("Unable to open %s for writing", cache_path.c_str());
+
+    time(&now);
+    cache_file << "tunecache\t" << header.quda_version << "\t" << header.git_version;
+    cache_file << "\t" << header.quda_hash << "\t# Last updated " << ctime(&now) << std::endl;
+    cache_file << std::setw(16) << "volume"
+               << "\tname\taux\tblock.x\tblock.y\tblock.z\tgrid.x\tgrid.y\tgrid.z\tshared_bytes\taux.x\taux.y\taux."
+                  "z\taux.w\ttime\tcomment"
+               << std::endl;
+    serializeTuneCache(cache_file, cache);
+  }
+
+  /**
+     @brief Read a binary tunecache file.  The file is memory mapped
+     and the records are parsed in place.
+     @param[in] cache_path The path of the file
+     @param[out] cache The tunecache the entries are inserted into
+     @param[out] header The header fields of the file
+     @param[in] version_check Whether to check the header matches the
+     present build
+     @return Whether the file was found
+  */
+  static bool readTuneCacheBinary(const std::string &cache_path, map &cache, TuneCacheHeader &header, bool version_check)
+  {
+    using namespace tunecache_binary;
+    int fd = open(cache_path.c_str(), O_RDONLY);
+    if (fd == -1) return false;
+
+    struct stat fstat_;
+    if (fstat(fd, &fstat_) == -1) errorQuda("Unable to stat %s", cache_path.c_str());
+    size_t bytes = fstat_.st_size;
+    if (bytes < sizeof(header_t)) errorQuda("Bad format in %s", cache_path.c_str());
+
+    void *map_ptr = mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map_ptr == MAP_FAILED) errorQuda("Unable to map %s", cache_path.c_str());
+    const char *data = static_cast<const char *>(map_ptr);
+
+    header_t h;
+    memcpy(&h, data, sizeof(h));
+    if (memcmp(h.magic, magic, sizeof(magic))) errorQuda("Bad format in %s", cache_path.c_str());
+    if (h.format_version != format_version || h.record_size != sizeof(record_t))
+      errorQuda("Cache file %s has unsupported binary format version %u (record size %u)", cache_path.c_str(),
+                h.format_version, h.record_size);
+    header.quda_version = std::string(h.quda_version, strnlen(h.quda_version, string_n));
+    header.git_version = std::string(h.git_version, strnlen(h.git_version, string_n));
+    header.quda_hash = std::string(h.quda_hash, strnlen(h.quda_hash, string_n));
+    if (version_check) checkTuneCacheHeader(header, cache_path);
+
+    // a partially written trailing record (e.g., from an interrupted append) is ignored
+    size_t n_record = (bytes - sizeof(header_t)) / sizeof(record_t);
+    if ((bytes - sizeof(header_t)) % sizeof(record_t))
+      warningQuda("Ignoring truncated trailing record in %s", cache_path.c_str());
+    deserializeTuneCacheBinary(data + sizeof(header_t), n_record, cache);
+
+    munmap(map_ptr, bytes);
+    return true;
+  }
+
+  /**
+     @brief Return the number of records in a binary tunecache file,
+     reading only its header
+     @param[in] cache_path The path of the file
+     @param[in] header The header fields the file must match
+     @param[out] n_record The number of records in the file
+     @return Whether the file was found with a matching header and no
+     truncated trailing record, and so can be appended to
+  */
+  static bool countTuneCacheBinary(const std::string &cache_path, const TuneCacheHeader &header, size_t &n_record)
+  {
+    using namespace tunecache_binary;
+    int fd = open(cache_path.c_str(), O_RDONLY);
+    if (fd == -1) return false;
+
+    struct stat fstat_;
+    header_t h;
+    bool valid = fstat(fd, &fstat_) == 0 && static_cast<size_t>(fstat_.st_size) >= sizeof(header_t)
+      && read(fd, &h, sizeof(h)) == static_cast<ssize_t>(sizeof(h));
+    close(fd);
+    if (!valid) return false;
+
+    header_t expected = make_header(header);
+    if (memcmp(&h, &expected, sizeof(h))) return false;
+
+    size_t bytes = fstat_.st_size - sizeof(header_t);
+    n_record = bytes / sizeof(record_t);
+    return bytes % sizeof(record_t) == 0;
+  }
+
+  /**
+     @brief Write a buffer to a file descriptor
+  */
+  static void writeBuffer(int fd, const std::vector<char> &buffer, const std::string &path)
+  {
+    size_t offset = 0;
+    while (offset < buffer.size()) {
+      auto n = write(fd, buffer.data() + offset, buffer.size() - offset);
+      if (n == -1) errorQuda("Error writing to %s", path.c_str());
+      offset += n;
+    }
+  }
+
+  /**
+     @brief Write a binary tunecache file in its entirety.  The file
+     is written to a temporary file that then replaces the original,
+     so that an interrupted write does not lose the existing cache.
+     @param[in] cache_path The path of the file
+     @param[in] cache The tunecache being written
+     @param[in] header The header fields to write
+     @return The number of records written
+  */
+  static size_t writeTuneCacheBinary(const std::string &cache_path, const map &cache, const TuneCacheHeader &header)
+  {
+    using namespace tunecache_binary;
+    std::vector<char> buffer(sizeof(header_t));
+    header_t h = make_header(header);
+    memcpy(buffer.data(), &h, sizeof(h));
+    serializeTuneCacheBinary(buffer, cache);
+
+    const std::string tmp_path = cache_path + ".tmp";
+    int fd = open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if (fd == -1) errorQuda("Unable to open %s for writing", tmp_path.c_str());
+    writeBuffer(fd, buffer, tmp_path);
+    close(fd);
+    if (rename(tmp_path.c_str(), cache_path.c_str())) errorQuda("Unable to rename %s", tmp_path.c_str());
+
+    return cache.size();
+  }
+
+  /**
+     @brief Append entries to an existing binary tunecache file
+     @param[in] cache_path The path of the file
+     @param[in] entries The entries being appended
+  */
+  static void appendTuneCacheBinary(const std::string &cache_path, const std::vector<const map::value_type *> &entries)
+  {
+    using namespace tunecache_binary;
+    std::vector<char> buffer(entries.size() * sizeof(record_t));
+    for (size_t i = 0; i < entries.size(); i++) {
+      record_t record = make_record(entries[i]->first, entries[i]->second);
+      memcpy(buffer.data() + i * sizeof(record_t), &record, sizeof(record));
+    }
+
+    int fd = open(cache_path.c_str(), O_WRONLY | O_APPEND);
+    if (fd == -1) errorQuda("Unable to open %s for writing", cache_path.c_str());
+    writeBuffer(fd, buffer, cache_path);
+    close(fd);
+  }
+
+  /**
+     @brief Save the tunecache to the binary tunecache file.  Only the
+     entries that have been inserted or updated since the last save
+     are appended, without reading the existing file beyond its
+     header.  The file is instead rewritten if it is missing, stale or
+     from a different build, or compacted if the append would leave
+     more than max_record_ratio records per entry.  When compacting,
+     the records already on disk are merged, so that entries appended
+     by other processes since the cache was loaded are not lost.
+     @param[in] cache_path The path of the file
+     @return The number of records written
+  */
+  static size_t saveTuneCacheBinary(const std::string &cache_path)
+  {
+    using namespace tunecache_binary;
+    const TuneCacheHeader header = currentTuneCacheHeader();
+
+    std::sort(dirty_entries.begin(), dirty_entries.end());
+    dirty_entries.erase(std::unique(dirty_entries.begin(), dirty_entries.end()), dirty_entries.end());
+
+    size_t n_record = 0;
+    bool valid = !binary_cache_stale && countTuneCacheBinary(cache_path, header, n_record);
+    if (valid && n_record + dirty_entries.size() <= max_record_ratio * tunecache.size()) {
+      appendTuneCacheBinary(cache_path, dirty_entries);
+      return dirty_entries.size();
+    }
+
+    if (valid) {
+      map disk_cache;
+      TuneCacheHeader disk_header;
+      readTuneCacheBinary(cache_path, disk_cache, disk_header, false);
+      for (auto &entry : tunecache) disk_cache.insert_or_assign(entry.first, entry.second);
+      logQuda(QUDA_VERBOSE, "Compacting %s from %lu to %lu records\n", cache_path.c_str(), n_record, disk_cache.size());
+      return writeTuneCacheBinary(cache_path, disk_cache, header);
+    }
+
+    return writeTuneCacheBinary(cache_path, tunecache, header);
+  }
+
+  /**
+     @brief Whether the binary tunecache format is enabled, which is
+     set with the QUDA_TUNE_CACHE_BINARY environment variable
+  */
+  static bool binaryTuneCache()
+  {
+    static bool init = false;
+    static bool binary = false;
+    if (!init) {
+      char *binary_env = getenv("QUDA_TUNE_CACHE_BINARY");
+      if (binary_env && strcmp(binary_env, "0")) binary = true;
+      init = true;
+    }
+    return binary;
+  }
+
+  static bool isBinaryTuneCachePath(const std::string &path)
+  {
+    const std::string ext = ".bin";
+    return path.size() >= ext.size() && path.compare(path.size() - ext.size(), ext.size(), ext) == 0;
+  }
+
+  void convertTuneCache(const std::string &in_path, const std::string &out_path)
+  {
+    map cache;
+    TuneCacheHeader header;
+    bool in_binary = isBinaryTuneCachePath(in_path);
+    bool found = in_binary ? readTuneCacheBinary(in_path, cache, header, false) :
+                             readTuneCacheText(in_path, cache, header, false);
+    if (!found) errorQuda("Unable to open %s", in_path.c_str());
+
+    if (isBinaryTuneCachePath(out_path)) {
+      writeTuneCacheBinary(out_path, cache, header);
+    } else {
+      writeTuneCacheText(out_path, cache, header);
+    }
+
+    logQuda(QUDA_SUMMARIZE, "Converted %lu sets of cached parameters from %s to %s\n", cache.size(), in_path.c_str(),
+            out_path.c_str());
+  }
+
+  bool launchTimingEnabled()
+  {
+    static bool init = false;
+    static bool enabled = false;
+
+    if (!init) {
+      char *enable_launch_timing_env = getenv("QUDA_ENABLE_LAUNCH_TIMING");
+      if (enable_launch_timing_env && strcmp(enable_launch_timing_env, "0")) enabled = true;
+      init = true;
+    }
+    return enabled;
+  }
+
+  /** launch-duration histograms (in nanoseconds) of each tunecache entry */
+  static std::unordered_map<const map::value_type *, log_histogram> launch_histograms;
+
+  /** device launch whose timing events have been recorded but not yet resolved */
+  struct PendingLaunch {
+    const map::value_type *entry;
+    qudaEvent_t start;
+    qudaEvent_t stop;
+  };
+
+  static std::deque<PendingLaunch> pending_launches;
+  static std::vector<std::pair<qudaEvent_t, qudaEvent_t>> launch_events; /** pool of available event pairs */
+  constexpr size_t max_pending_launches = 1024;
+
+  /**
+     @brief Resolve the durations of the pending device launches in
+     order of recording, adding them to the launch histograms
+     @param[in] synchronize Whether to wait for all pending launches
+     to complete, else we stop at the first incomplete launch
+  */
+  static void resolveLaunchTimes(bool synchronize)
+  {
+    while (!pending_launches.empty()) {
+      auto &launch = pending_launches.front();
+      if (synchronize)
+        qudaEventSynchronize(launch.stop);
+      else if (!qudaEventQuery(launch.stop))
+        break;
+      launch_histograms[launch.entry].add(static_cast<uint64_t>(1e9 * qudaEventElapsedTime(launch.start, launch.stop)));
+      launch_events.push_back({launch.start, launch.stop});
+      pending_launches.pop_front();
+    }
+  }
+
+  void destroyLaunchEvents()
+  {
+    resolveLaunchTimes(true);
+    for (auto &events : launch_events) {
+      qudaEventDestroy(events.first);
+      qudaEventDestroy(events.second);
+    }
+    launch_events.clear();
+  }
+
+  LaunchTimer::LaunchTimer(const Tunable &tunable) : entry(launchTimingEnabled() ? tunable.launch_entry : nullptr)
+  {
+    if (entry) start = trace::now();
+  }
+
+  LaunchTimer::LaunchTimer(const Tunable &tunable, const qudaStream_t &stream) :
+    entry(launchTimingEnabled() ? tunable.launch_entry : nullptr), device(true), stream(stream)
+  {
+    if (!entry) return;
+
+    resolveLaunchTimes(pending_launches.size() >= max_pending_launches);
+    if (launch_events.empty()) launch_events.push_back({qudaChronoEventCreate(), qudaChronoEventCreate()});
+    start_event = launch_events.back().first;
+    stop_event = launch_events.back().second;
+    launch_events.pop_back();
+    qudaEventRecord(start_event, stream);
+  }
+
+  LaunchTimer::~LaunchTimer()
+  {
+    if (!entry) return;
+
+    if (device) {
+      qudaEventRecord(stop_event, stream);
+      pending_launches.push_back({entry, start_event, stop_event});
+    } else {
+      launch_histograms[entry].add(trace::now() - start);
+    }
+  }
+
   template <class T> struct less_significant {
     inline bool operator()(const T &lhs, const T &rhs)
     {
@@ -191,6 +858,27 @@ namespace quda
     }
   };
 
+  /**
+     @brief Write the launch timing columns of a profile entry: the
+     number of timed launches, their total wall time, and the 50th,
+     90th and 99th percentile launch durations (all in seconds)
+  */
+  static void serializeLaunchTimes(std::ostream &out, const TuneKey &key)
+  {
+    log_histogram hist;
+    auto entry = tunecache.find(key);
+    if (entry != tunecache.end()) {
+      auto it = launch_histograms.find(&*entry);
+      if (it != launch_histograms.end()) hist = it->second;
+    }
+
+    out << std::setw(12) << hist.count() << "\t";
+    out << std::setw(12) << hist.sum() * 1e-9 << "\t";
+    out << std::setw(12) << hist.percentile(50) * 1e-9 << "\t";
+    out << std::setw(12) << hist.percentile(90) * 1e-9 << "\t";
+    out << std::setw(12) << hist.percentile(99) * 1e-9 << "\t";
+  }
+
   /**
    * Serialize tunecache to an ostream, useful for writing to a file or sending to other nodes.
    */
@@ -241,6 +929,7 @@ namespace quda
         out << std::setw(12) << cumulative_percent << "\t";
         out << std::setw(12) << param.n_calls << "\t";
         out << std::setw(12) << param.time << "\t";
+        if (launchTimingEnabled()) serializeLaunchTimes(out, key);
         out << std::setw(16) << key.volume << "\t";
         out << key.name << "\t" << key.aux << "\t" << param.comment; // param.comment ends with a newline
       }
@@ -256,6 +945,7 @@ namespace quda
         async_out << std::setw(12) << cumulative_percent_async << "\t";
         async_out << std::setw(12) << param.n_calls << "\t";
         async_out << std::setw(12) << param.time << "\t";
+        if (launchTimingEnabled()) serializeLaunchTimes(async_out, key);
         async_out << std::setw(16) << key.volume << "\t";
         async_out << key.name << "\t" << key.aux << "\t" << param.comment; // param.comment ends with a newline
       }
@@ -301,6 +991,25 @@ namespace quda
    */
   static void broadcastTuneCache(int32_t root_rank = 0)
   {
+    // with the binary format the fixed-size records are sent directly, avoiding the text formatting and parsing
+    if (binaryTuneCache()) {
+      std::vector<char> serialized;
+      size_t n_record = 0;
+
+      if (comm_rank_global() == root_rank) {
+        serializeTuneCacheBinary(serialized);
+        n_record = tunecache.size();
+      }
+      comm_broadcast_global(&n_record, sizeof(size_t), root_rank);
+
+      if (n_record > 0) {
+        if (comm_rank_global() != root_rank) serialized.resize(n_record * sizeof(tunecache_binary::record_t));
+        comm_broadcast_global(serialized.data(), serialized.size(), root_rank);
+        if (comm_rank_global() != root_rank) deserializeTuneCacheBinary(serialized.data(), n_record);
+      }
+      return;
+    }
+
     std::stringstream serialized;
     size_t size;
 
@@ -335,9 +1044,7 @@ namespace quda
 
     char *path;
     struct stat pstat;
-    std::string cache_path, line, token;
-    std::ifstream cache_file;
-    std::stringstream ls;
+    std::string cache_path;
 
     path = getenv("QUDA_RESOURCE_PATH");
 
@@ -361,49 +1068,23 @@ namespace quda
     }
 
     if (comm_rank_global() == 0) {
-      cache_path = resource_path;
-      cache_path += "/tunecache.tsv";
-      cache_file.open(cache_path.c_str());
-
-      if (cache_file) {
-
-        if (!cache_file.good()) errorQuda("Bad format in %s", cache_path.c_str());
-        getline(cache_file, line);
-        ls.str(line);
-        ls >> token;
-        if (token.compare("tunecache")) errorQuda("Bad format in %s", cache_path.c_str());
-        ls >> token;
-        if (version_check && token.compare(quda_version))
-          errorQuda("Cache file %s does not match current QUDA version. \nPlease delete this file or set the "
-                    "QUDA_RESOURCE_PATH environment variable to point to a new path.",
-                    cache_path.c_str());
-        ls >> token;
-#ifdef GITVERSION
-        if (version_check && token.compare(gitversion))
-          errorQuda("Cache file %s does not match current QUDA version. \nPlease delete this file or set the "
-                    "QUDA_RESOURCE_PATH environment variable to point to a new path.",
-                    cache_path.c_str());
-#else
-      if (version_check && token.compare(quda_version))
-        errorQuda("Cache file %s does not match current QUDA version. \nPlease delete this file or set the "
-                  "QUDA_RESOURCE_PATH environment variable to point to a new path.",
-                  cache_path.c_str());
-#endif
-        ls >> token;
-        if (version_check && token.compare(quda_hash))
-          errorQuda("Cache file %s does not match current QUDA build. \nPlease delete this file or set the "
-                    "QUDA_RESOURCE_PATH environment variable to point to a new path.",
-                    cache_path.c_str());
-
-        if (!cache_file.good()) errorQuda("Bad format in %s", cache_path.c_str());
-        getline(cache_file, line); // eat the blank line
-
-        if (!cache_file.good()) errorQuda("Bad format in %s", cache_path.c_str());
-        getline(cache_file, line); // eat the description line
+      TuneCacheHeader header;
+      bool found = false;
+
+      // if the binary cache is enabled but not yet present, we fall back to the text cache and the binary cache
+      // will be created when the cache is next saved
+      if (binaryTuneCache()) {
+        cache_path = resource_path + "/tunecache.bin";
+        found = readTuneCacheBinary(cache_path, tunecache, header, version_check);
+      }
 
-        deserializeTuneCache(cache_file);
+      if (!found) {
+        cache_path = resource_path + "/tunecache.tsv";
+        found = readTuneCacheText(cache_path, tunecache, header, version_check);
+        if (found && binaryTuneCache()) binary_cache_stale = true;
+      }
 
-        cache_file.close();
+      if (found) {
         initial_cache_size = tunecache.size();
 
         logQuda(QUDA_SUMMARIZE, "Loaded %d sets of cached parameters from %s\n", static_cast<int>(initial_cache_size),
@@ -415,6 +1096,7 @@ namespace quda
     }
 
     broadcastTuneCache();
+    dirty_entries.clear(); // the loaded entries are already on disk
   }
 
   /**
@@ -422,10 +1104,8 @@ namespace quda
    */
   void saveTuneCache(bool error)
   {
-    time_t now;
     int lock_handle;
     std::string lock_path, cache_path;
-    std::ofstream cache_file;
 
     if (resource_path.empty()) return;
 
@@ -435,7 +1115,7 @@ namespace quda
 
     if (comm_rank_global() == 0) {
 
-      if (tunecache.size() == initial_cache_size && !error) return;
+      if (tunecache.size() == initial_cache_size && dirty_entries.empty() && !binary_cache_stale && !error) return;
 
       // Acquire lock.  Note that this is only robust if the filesystem supports flock() semantics, which is true for
       // NFS on recent versions of linux but not Lustre by default (unless the filesystem was mounted with "-o flock").
@@ -453,34 +1133,29 @@ namespace quda
       int stat = write(lock_handle, msg, sizeof(msg)); // check status to avoid compiler warning
       if (stat == -1) warningQuda("Unable to write to lock file for some bizarre reason");
 
-      cache_path = resource_path + (error ? "/tunecache_error.tsv" : "/tunecache.tsv");
-      cache_file.open(cache_path.c_str());
-
-      logQuda(QUDA_SUMMARIZE, "Saving %d sets of cached parameters to %s\n", static_cast<int>(tunecache.size()),
-              cache_path.c_str());
-
-      time(&now);
-      cache_file << "tunecache\t" << quda_version;
-#ifdef GITVERSION
-      cache_file << "\t" << gitversion;
-#else
-    cache_file << "\t" << quda_version;
-#endif
-      cache_file << "\t" << quda_hash << "\t# Last updated " << ctime(&now) << std::endl;
-      cache_file << std::setw(16) << "volume"
-                 << "\tname\taux\tblock.x\tblock.y\tblock.z\tgrid.x\tgrid.y\tgrid.z\tshared_bytes\taux.x\taux.y\taux."
-                    "z\taux.w\ttime\tcomment"
-                 << std::endl;
-      serializeTuneCache(cache_file);
-      cache_file.close();
+      if (binaryTuneCache() && !error) {
+        cache_path = resource_path + "/tunecache.bin";
+        size_t n_record = saveTuneCacheBinary(cache_path);
+        logQuda(QUDA_SUMMARIZE, "Saved %d sets of cached parameters to %s\n", static_cast<int>(n_record),
+                cache_path.c_str());
+        binary_cache_stale = false;
+      } else {
+        cache_path = resource_path + (error ? "/tunecache_error.tsv" : "/tunecache.tsv");
+        logQuda(QUDA_SUMMARIZE, "Saving %d sets of cached parameters to %s\n", static_cast<int>(tunecache.size()),
+                cache_path.c_str());
+        writeTuneCacheText(cache_path, tunecache, currentTuneCacheHeader());
+      }
 
       // Release lock.
       close(lock_handle);
       remove(lock_path.c_str());
 
       initial_cache_size = tunecache.size();
+      if (!error) dirty_entries.clear();
 
     } else {
+      dirty_entries.clear(); // only process 0 writes the tunecache
+
       // give process 0 time to write out its tunecache if needed, but
       // doesn't cause a hang if error is not triggered on process 0
       if (error) sleep(10);
@@ -505,6 +1180,8 @@ namespace quda
       TuneParam &param = entry->second;
       param.n_calls = 0;
     }
+    resolveLaunchTimes(true);
+    launch_histograms.clear();
   }
 
   // save profile
@@ -516,6 +1193,7 @@ namespace quda
     std::ofstream profile_file, async_profile_file, trace_file;
 
     if (resource_path.empty()) return;
+    if (launchTimingEnabled()) resolveLaunchTimes(true);
 
     if (comm_rank_global() == 0) { // Make sure only one rank is writing to disk
 
@@ -594,8 +1272,14 @@ namespace quda
                    << "\t" << std::setw(12) << "percent"
                    << "\t" << std::setw(12) << "cum. percent"
                    << "\t" << std::setw(12) << "calls"
-                   << "\t" << std::setw(12) << "time / call"
-                   << "\t" << std::setw(16) << "volume"
+                   << "\t" << std::setw(12) << "time / call";
+      if (launchTimingEnabled())
+        profile_file << "\t" << std::setw(12) << "timed calls"
+                   << "\t" << std::setw(12) << "wall time"
+                   << "\t" << std::setw(12) << "p50"
+                   << "\t" << std::setw(12) << "p90"
+                   << "\t" << std::setw(12) << "p99";
+      profile_file << "\t" << std::setw(16) << "volume"
                    << "\tname\taux\tcomment" << std::endl;
 
       async_profile_file << Label << "\t" << quda_version;
@@ -609,8 +1293,14 @@ namespace quda
                          << "\t" << std::setw(12) << "percent"
                          << "\t" << std::setw(12) << "cum. percent"
                          << "\t" << std::setw(12) << "calls"
-                         << "\t" << std::setw(12) << "time / call"
-                         << "\t" << std::setw(16) << "volume"
+                         << "\t" << std::setw(12) << "time / call";
+      if (launchTimingEnabled())
+        async_profile_file << "\t" << std::setw(12) << "timed calls"
+                         << "\t" << std::setw(12) << "wall time"
+                         << "\t" << std::setw(12) << "p50"
+                         << "\t" << std::setw(12) << "p90"
+                         << "\t" << std::setw(12) << "p99";
+      async_profile_file << "\t" << std::setw(16) << "volume"
                          << "\tname\taux\tcomment" << std::endl;
 
       serializeProfile(profile_file, async_profile_file);
@@ -681,7 +1371,7 @@ namespace quda
     TuneKey key = tuneKey();
     if (use_managed_memory()) strcat(key.aux, ",managed");
     // if key is present in cache then already tuned
-    return getTuneCache().find(key) != getTuneCache().end();
+    return tune_index.find(key) != nullptr;
   }
 
   std::string Tunable::paramString(const TuneParam &param) const
@@ -845,6 +1535,8 @@ namespace quda
     launchTimer.TPSTART(QUDA_PROFILE_INIT);
 #endif
 
+    tunable.launch_entry = nullptr;
+
     TuneKey key = tunable.tuneKey();
     if (use_managed_memory()) strcat(key.aux, ",managed");
     last_key = key;
@@ -856,17 +1548,17 @@ namespace quda
 #endif
 
     static const Tunable *active_tunable; // for error checking
-    it = tunecache.find(key);
+    map::value_type *entry = tune_index.find(key);
 
     // first check if we have the tuned value and return if we have it
-    if (enabled == QUDA_TUNE_YES && it != tunecache.end()) {
+    if (enabled == QUDA_TUNE_YES && entry) {
 
 #ifdef LAUNCH_TIMER
       launchTimer.TPSTOP(QUDA_PROFILE_PREAMBLE);
       launchTimer.TPSTART(QUDA_PROFILE_COMPUTE);
 #endif
 
-      TuneParam &param_tuned = it->second;
+      TuneParam &param_tuned = entry->second;
 
       logQuda(QUDA_DEBUG_VERBOSE, "Launching %s with %s at vol=%s with %s\n", key.name, key.aux, key.volume,
               tunable.paramString(param_tuned).c_str());
@@ -880,6 +1572,7 @@ namespace quda
 
       // we could be tuning outside of the current scope
       if (!tuning && profile_count) param_tuned.n_calls++;
+      if (!tuning && profile_count && launchTimingEnabled()) tunable.launch_entry = entry;
 
 #ifdef LAUNCH_TIMER
       launchTimer.TPSTOP(QUDA_PROFILE_EPILOGUE);
@@ -1091,7 +1784,7 @@ namespace quda
         tunable.postTune();
         tuning = false;
         param = best_param;
-        tunecache[key] = best_param;
+        tuneCacheInsert(key, best_param);
       }
       if (commGlobalReduction() || policyTuning() || uberTuning()) { broadcastTuneCache(tune_rank); }
 
@@ -1109,7 +1802,8 @@ namespace quda
       }
 
       // check this process is getting the key that is expected
-      if (tunecache.find(key) == tunecache.end()) {
+      entry = tune_index.find(key);
+      if (!entry) {
 
         // if we can't find the key, and debugging, then print out the entire map
         if (verbosity >= QUDA_DEBUG_VERBOSE)
@@ -1117,7 +1811,8 @@ namespace quda
 
         errorQuda("Failed to find key entry (%s:%s:%s)", key.name, key.volume, key.aux);
       }
-      param = tunecache[key]; // read this now for all processes
+      param = entry->second; // read this now for all processes
+      if (!tuning && profile_count && launchTimingEnabled()) tunable.launch_entry = entry;
 
       if (traceEnabled() >= 2) {
         TraceKey trace_entry(key, param.time);
@@ -1,17 +1,207 @@
+#include <algorithm>
+#include <cstdlib>
+#include <future>
 #include <color_spinor_field.h>
 #include <qio_field.h>
 #include <vector_io.h>
 #include <blas_quda.h>
+#include <device.h>
 #include <timer.h>
 
 namespace quda
 {
 
   VectorIO::VectorIO(const std::string &filename, bool parity_inflate, bool partfile) :
-    filename(filename), parity_inflate(parity_inflate), partfile(partfile)
+    filename(filename), parity_inflate(parity_inflate), partfile(partfile), chunk_size(0)
   {
     if (strcmp(filename.c_str(), "") == 0)
       errorQuda("No eigenspace input file defined (filename = %s, parity_inflate = %d", filename.c_str(), parity_inflate);
+
+    char *chunk_env = getenv("QUDA_VECTOR_IO_CHUNK");
+    if (chunk_env) chunk_size = std::max(atoi(chunk_env), 0);
+  }
+
+  /**
+     @brief Return the parameters of the host fields used to stage
+     vectors for QIO, in the given precision
+  */
+  static ColorSpinorParam staging_param(const ColorSpinorField &v0, QudaPrecision prec, bool inflate)
+  {
+    ColorSpinorParam param(v0);
+    param.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+    param.setPrecision(prec);
+    param.location = QUDA_CPU_FIELD_LOCATION;
+    param.create = QUDA_NULL_FIELD_CREATE;
+    if (inflate) {
+      param.x[0] *= 2;                          // corrects for the factor of two in the X direction
+      param.siteSubset = QUDA_FULL_SITE_SUBSET; // create a full-parity field.
+      param.create = QUDA_ZERO_FIELD_CREATE;    // to explicitly zero the odd sites.
+    }
+    return param;
+  }
+
+  /**
+     @brief Return the addresses of the 4-d fields that comprise fields
+     [begin, begin + n), since QIO routines presently assume 4-d fields
+  */
+  template <typename T, typename Fields> static std::vector<T> field_pointers(Fields &fields, int begin, int n, int Ls)
+  {
+    std::vector<T> V(n * Ls);
+    for (int i = 0; i < n; i++) {
+      const ColorSpinorField &v = fields[begin + i];
+      auto stride = (v.Volume() / Ls) * v.Ncolor() * v.Nspin() * 2 * v.Precision();
+      for (int j = 0; j < Ls; j++) V[i * Ls + j] = static_cast<T>(v.data<char *>() + j * stride);
+    }
+    return V;
+  }
+
+  void VectorIO::load_chunked(cvector_ref<ColorSpinorField> &vecs, QudaPrecision load_prec, bool create_tmp)
+  {
+    const ColorSpinorField &v0 = vecs[0];
+    const bool inflate = v0.SiteSubset() == QUDA_PARITY_SITE_SUBSET && parity_inflate;
+    const auto spinor_parity = v0.SuggestedParity();
+    const int Ls = v0.Ndim() == 5 ? v0.X(4) : 1;
+    const ColorSpinorParam param = staging_param(v0, load_prec, inflate);
+    const size_t vector_bytes = v0.Volume() * (inflate ? 2 : 1) * v0.Ncolor() * v0.Nspin() * 2 * load_prec;
+
+    std::vector<ColorSpinorField> buffer[2]; // staging fields, where the r-th record is read into buffer[r % 2]
+    std::future<void> unstaging;             // conversion and upload of the most recently read record
+    int record = 0;
+    double convert_time = 0.0; // time spent converting and uploading, on the worker thread
+    double wait_time = 0.0;    // time the reading thread spent waiting for the worker
+
+    auto unstage = [&](int begin, int n, int b) {
+      device::init_thread();
+      host_timer_t timer;
+      timer.start();
+      for (int i = 0; i < n; i++) {
+        auto &t = buffer[b][i];
+        if (inflate)
+          vecs[begin + i] = spinor_parity == QUDA_EVEN_PARITY ? t.Even() : t.Odd();
+        else
+          vecs[begin + i] = t;
+      }
+      timer.stop();
+      convert_time += timer.last();
+    };
+
+    auto wait = [&](std::future<void> &f) {
+      if (!f.valid()) return;
+      host_timer_t timer;
+      timer.start();
+      f.get();
+      timer.stop();
+      wait_time += timer.last();
+    };
+
+    auto get_chunk = [&](int begin, int count) {
+      if (begin % Ls != 0 || count % Ls != 0)
+        errorQuda("Record of %d fields at %d does not consist of whole %d-d vectors", count, begin, v0.Ndim());
+      const int n = count / Ls;
+      if (!create_tmp) return field_pointers<void *>(vecs, begin / Ls, n, Ls);
+
+      // the record previously read into this buffer has already been unstaged, see chunk_done
+      auto &b = buffer[record % 2];
+      while (static_cast<int>(b.size()) < n) b.push_back(ColorSpinorField(param));
+      return field_pointers<void *>(b, 0, n, Ls);
+    };
+
+    auto chunk_done = [&](int begin, int count) {
+      if (create_tmp) {
+        wait(unstaging);
+        unstaging = std::async(std::launch::async, unstage, begin / Ls, count / Ls, record % 2);
+      }
+      record++;
+    };
+
+    host_timer_t read_timer;
+    read_timer.start();
+    read_spinor_field(filename.c_str(), load_prec, v0.X(), v0.SiteSubset(), spinor_parity, v0.Ncolor(), v0.Nspin(),
+                      vecs.size() * Ls, get_chunk, chunk_done);
+    read_timer.stop();
+    const double read_time = read_timer.last() - wait_time;
+    wait(unstaging);
+
+    const double bytes = static_cast<double>(vector_bytes) * vecs.size();
+    logQuda(QUDA_SUMMARIZE, "Loaded %lu vectors from %s in %d records: read %g secs (%g GB/s)\n", vecs.size(),
+            filename.c_str(), record, read_time, 1e-9 * bytes / read_time);
+    if (create_tmp)
+      logQuda(QUDA_SUMMARIZE, "Convert and upload %g secs (%g GB/s), of which %g secs not overlapped with reading\n",
+              convert_time, 1e-9 * bytes / convert_time, wait_time);
+  }
+
+  void VectorIO::save_chunked(cvector_ref<const ColorSpinorField> &vecs, int Nvec, QudaPrecision save_prec,
+                              bool create_tmp)
+  {
+    const ColorSpinorField &v0 = vecs[0];
+    const bool inflate = v0.SiteSubset() == QUDA_PARITY_SITE_SUBSET && parity_inflate;
+    const auto spinor_parity = v0.SuggestedParity();
+    const int Ls = v0.Ndim() == 5 ? v0.X(4) : 1;
+    const int n_chunk = (Nvec + chunk_size - 1) / chunk_size;
+    const size_t vector_bytes = v0.Volume() * (inflate ? 2 : 1) * v0.Ncolor() * v0.Nspin() * 2 * save_prec;
+
+    std::vector<ColorSpinorField> buffer[2]; // staging fields, where chunk c is staged into buffer[c % 2]
+    if (create_tmp) {
+      const ColorSpinorParam param = staging_param(v0, save_prec, inflate);
+      for (auto &b : buffer)
+        for (int i = 0; i < std::min(chunk_size, Nvec); i++) b.push_back(ColorSpinorField(param));
+    }
+
+    std::future<void> staging; // download and conversion of the next chunk
+    double convert_time = 0.0; // time spent downloading and converting, on the worker thread
+    double wait_time = 0.0;    // time the writing thread spent waiting for the worker
+
+    auto stage = [&](int c) {
+      device::init_thread();
+      host_timer_t timer;
+      timer.start();
+      const int begin = c * chunk_size;
+      for (int i = 0; i < std::min(chunk_size, Nvec - begin); i++) {
+        auto &t = buffer[c % 2][i];
+        if (inflate)
+          // copy the single parity only eigen/singular vector into the even components of the full parity vector
+          blas::copy(spinor_parity == QUDA_EVEN_PARITY ? t.Even() : t.Odd(), vecs[begin + i]);
+        else
+          t = vecs[begin + i];
+      }
+      timer.stop();
+      convert_time += timer.last();
+    };
+
+    auto wait = [&](std::future<void> &f) {
+      if (!f.valid()) return;
+      host_timer_t timer;
+      timer.start();
+      f.get();
+      timer.stop();
+      wait_time += timer.last();
+    };
+
+    auto get_chunk = [&](int begin, int count) {
+      const int c = begin / (chunk_size * Ls);
+      if (!create_tmp) return field_pointers<const void *>(vecs, begin / Ls, count / Ls, Ls);
+
+      // wait for this chunk, and then start staging the next one into the other buffer
+      wait(staging);
+      if (c + 1 < n_chunk) staging = std::async(std::launch::async, stage, c + 1);
+      return field_pointers<const void *>(buffer[c % 2], 0, count / Ls, Ls);
+    };
+
+    if (create_tmp) staging = std::async(std::launch::async, stage, 0);
+
+    host_timer_t write_timer;
+    write_timer.start();
+    write_spinor_field(filename.c_str(), save_prec, v0.X(), v0.SiteSubset(), spinor_parity, v0.Ncolor(), v0.Nspin(),
+                       Nvec * Ls, chunk_size * Ls, get_chunk, partfile);
+    write_timer.stop();
+    const double write_time = write_timer.last() - wait_time;
+
+    const double bytes = static_cast<double>(vector_bytes) * Nvec;
+    logQuda(QUDA_SUMMARIZE, "Saved %d vectors to %s in %d records: write %g secs (%g GB/s)\n", Nvec,
+            filename.c_str(), n_chunk, write_time, 1e-9 * bytes / write_time);
+    if (create_tmp)
+      logQuda(QUDA_SUMMARIZE, "Download and convert %g secs (%g GB/s), of which %g secs not overlapped with writing\n",
+              convert_time, 1e-9 * bytes / convert_time, wait_time);
   }
 
   void VectorIO::load(cvector_ref<ColorSpinorField> &vecs)
@@ -26,10 +216,18 @@ namespace quda
       errorQuda("When loading single parity vectors, the suggested parity must be set.");
     if (getVerbosity() >= QUDA_SUMMARIZE) printfQuda("Start loading %04d vectors from %s\n", Nvec, filename.c_str());
 
-    std::vector<ColorSpinorField> tmp(Nvec);
     bool create_tmp = load_prec != v0.Precision() || (v0.SiteSubset() == QUDA_PARITY_SITE_SUBSET && parity_inflate) ||
       v0.Location() == QUDA_CUDA_FIELD_LOCATION;
 
+    if (chunk_size > 0) {
+      if (v0.Ndim() != 4 && v0.Ndim() != 5) errorQuda("Unexpected field dimension %d", v0.Ndim());
+      load_chunked(vecs, load_prec, create_tmp);
+      if (getVerbosity() >= QUDA_SUMMARIZE) printfQuda("Done loading vectors\n");
+      return;
+    }
+
+    std::vector<ColorSpinorField> tmp(Nvec);
+
     if (create_tmp) {
       ColorSpinorParam csParam(vecs[0]);
       csParam.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
@@ -93,6 +291,17 @@ namespace quda
     if (v0.SiteSubset() == QUDA_PARITY_SITE_SUBSET && parity_inflate &&
         spinor_parity != QUDA_EVEN_PARITY && spinor_parity != QUDA_ODD_PARITY)
       errorQuda("When loading single parity vectors, the suggested parity must be set.");
+
+    if (chunk_size > 0) {
+      if (v0.Ndim() != 4 && v0.Ndim() != 5) errorQuda("Unexpected field dimension %d", v0.Ndim());
+      if (getVerbosity() >= QUDA_SUMMARIZE)
+        printfQuda("Start saving %d vectors to %s in %s format, in chunks of %d\n", Nvec, filename.c_str(),
+                   partfile ? "PARTFILE" : "SINGLEFILE", chunk_size);
+      save_chunked(vecs, Nvec, save_prec, create_tmp);
+      if (getVerbosity() >= QUDA_SUMMARIZE) printfQuda("Done saving vectors\n");
+      return;
+    }
+
     std::vector<ColorSpinorField> tmp(Nvec);
 
     if (create_tmp) {
@@ -6,10 +6,13 @@
 #include <complex>
 
 #include <inttypes.h>
+#include <random>
 
 #include <test.h>
 #include <blas_reference.h>
 #include <misc.h>
+#include <malloc_quda.h>
+#include <quda_api.h>
 
 // In a typical application, quda.h is the only QUDA header required.
 #include <quda.h>
@@ -36,7 +39,17 @@ int blas_lu_inv_mat_size = 128;
 namespace quda
 {
   extern void setTransferGPU(bool);
-}
+
+  namespace blas_lapack
+  {
+    namespace generic
+    {
+      extern void set_zero_copy_gemm(bool);
+      extern long long stridedBatchGEMM(void *A_data, void *B_data, void *C_data, QudaBLASParam blas_param,
+                                        QudaFieldLocation location);
+    }
+  } // namespace blas_lapack
+} // namespace quda
 
 void display_test_info(QudaBLASParam &param)
 {
@@ -255,6 +268,212 @@ double gemm_test(test_t test_param)
   return deviation;
 }
 
+double gemm_host_test(test_t test_param)
+{
+  // Run the host GEMM with every combination of op(A), op(B) and data
+  // order, using non-square matrices with padded leading dimensions
+  auto native = native_blas_lapack;
+  auto order = blas_data_order;
+  auto trans_a = blas_gemm_trans_a;
+  auto trans_b = blas_gemm_trans_b;
+  auto mnk = blas_gemm_mnk;
+  auto leading_dims = blas_gemm_leading_dims;
+
+  native_blas_lapack = false;
+  blas_gemm_mnk = {24, 40, 16};
+  blas_gemm_leading_dims = {48, 48, 48};
+
+  double deviation = 0.0;
+  for (auto o : {QUDA_BLAS_DATAORDER_ROW, QUDA_BLAS_DATAORDER_COL}) {
+    for (auto a : {QUDA_BLAS_OP_N, QUDA_BLAS_OP_T, QUDA_BLAS_OP_C}) {
+      for (auto b : {QUDA_BLAS_OP_N, QUDA_BLAS_OP_T, QUDA_BLAS_OP_C}) {
+        blas_data_order = o;
+        blas_gemm_trans_a = a;
+        blas_gemm_trans_b = b;
+        deviation = std::max(deviation, gemm_test(test_param));
+      }
+    }
+  }
+
+  native_blas_lapack = native;
+  blas_data_order = order;
+  blas_gemm_trans_a = trans_a;
+  blas_gemm_trans_b = trans_b;
+  blas_gemm_mnk = mnk;
+  blas_gemm_leading_dims = leading_dims;
+
+  return deviation;
+}
+
+double gemm_host_benchmark(test_t test_param)
+{
+  // Time the zero-copy host GEMM against the copying implementation on
+  // many small batches, returning the maximum deviation between the
+  // two relative to the largest element of the result
+  QudaBLASParam blas_param = newQudaBLASParam();
+  blas_data_type = ::testing::get<1>(test_param);
+  blas_test_type = ::testing::get<0>(test_param);
+  setBLASParam(blas_param);
+
+  const int n = 16;
+  blas_param.m = blas_param.n = blas_param.k = n;
+  blas_param.lda = blas_param.ldb = blas_param.ldc = n;
+  blas_param.a_offset = blas_param.b_offset = blas_param.c_offset = 0;
+  blas_param.a_stride = blas_param.b_stride = blas_param.c_stride = 1;
+  blas_param.trans_a = QUDA_BLAS_OP_C;
+  blas_param.trans_b = QUDA_BLAS_OP_N;
+  blas_param.batch_count = 4096;
+
+  const bool is_complex = blas_data_type == QUDA_BLAS_DATATYPE_C || blas_data_type == QUDA_BLAS_DATATYPE_Z;
+  const bool is_double = blas_data_type == QUDA_BLAS_DATATYPE_D || blas_data_type == QUDA_BLAS_DATATYPE_Z;
+  const size_t data_out_size = is_double ? sizeof(double) : sizeof(float);
+  const uint64_t length = static_cast<uint64_t>(n) * n * blas_param.batch_count * (is_complex ? 2 : 1);
+  const uint64_t bytes = length * data_out_size;
+
+  void *ref = pinned_malloc(2 * length * sizeof(double));
+  void *arrayA = pinned_malloc(bytes);
+  void *arrayB = pinned_malloc(bytes);
+  void *arrayC = pinned_malloc(bytes);
+  void *arrayCcopy = pinned_malloc(bytes);
+
+  prepare_ref_array(ref, blas_param.batch_count, n * n, sizeof(double), blas_data_type);
+  copy_array(arrayA, ref, blas_param.batch_count, n * n, data_out_size, blas_data_type);
+  prepare_ref_array(ref, blas_param.batch_count, n * n, sizeof(double), blas_data_type);
+  copy_array(arrayB, ref, blas_param.batch_count, n * n, data_out_size, blas_data_type);
+  prepare_ref_array(ref, blas_param.batch_count, n * n, sizeof(double), blas_data_type);
+  copy_array(arrayC, ref, blas_param.batch_count, n * n, data_out_size, blas_data_type);
+  memcpy(arrayCcopy, arrayC, bytes);
+
+  quda::host_timer_t timer;
+  quda::blas_lapack::generic::set_zero_copy_gemm(false);
+  timer.start();
+  blasGEMMQuda(arrayA, arrayB, arrayC, QUDA_BOOLEAN_FALSE, &blas_param);
+  timer.stop();
+  double copy_time = timer.last();
+
+  quda::blas_lapack::generic::set_zero_copy_gemm(true);
+  timer.start();
+  blasGEMMQuda(arrayA, arrayB, arrayCcopy, QUDA_BOOLEAN_FALSE, &blas_param);
+  timer.stop();
+  double zero_copy_time = timer.last();
+
+  double max_dev = 0.0, max_ref = 0.0;
+  for (uint64_t i = 0; i < length; i++) {
+    double copy = is_double ? static_cast<double *>(arrayC)[i] : static_cast<float *>(arrayC)[i];
+    double zero_copy = is_double ? static_cast<double *>(arrayCcopy)[i] : static_cast<float *>(arrayCcopy)[i];
+    max_dev = std::max(max_dev, std::abs(zero_copy - copy));
+    max_ref = std::max(max_ref, std::abs(copy));
+  }
+
+  const double flops = (is_complex ? 8.0 : 2.0) * n * n * n * blas_param.batch_count;
+  printfQuda("Host GEMM %d x %dx%dx%d: copy %.3f s (%.2f Gflop/s), zero copy %.3f s (%.2f Gflop/s), speedup %.1fx\n",
+             blas_param.batch_count, n, n, n, copy_time, 1e-9 * flops / copy_time, zero_copy_time,
+             1e-9 * flops / zero_copy_time, copy_time / zero_copy_time);
+
+  host_free(ref);
+  host_free(arrayA);
+  host_free(arrayB);
+  host_free(arrayC);
+  host_free(arrayCcopy);
+
+  return max_dev / max_ref;
+}
+
+double gemm_device_test(test_t test_param)
+{
+  // Run the host GEMM on device arrays, which are staged through pinned
+  // host buffers, with non-square matrices, padded leading dimensions,
+  // offsets, strides and a batch count that is not a multiple of the
+  // largest stride.  The whole of C, including the data between the
+  // matrices, is compared against the host GEMM on host arrays, for both
+  // host implementations, returning the maximum deviation relative to
+  // the largest element of the result
+  QudaBLASParam blas_param = newQudaBLASParam();
+  blas_data_type = ::testing::get<1>(test_param);
+  blas_test_type = ::testing::get<0>(test_param);
+  setBLASParam(blas_param);
+
+  blas_param.m = 24;
+  blas_param.n = 40;
+  blas_param.k = 16;
+  blas_param.lda = blas_param.ldb = blas_param.ldc = 48;
+  blas_param.a_offset = 8;
+  blas_param.b_offset = 16;
+  blas_param.c_offset = 24;
+  blas_param.a_stride = 2;
+  blas_param.b_stride = 1;
+  blas_param.c_stride = 3;
+  blas_param.batch_count = 7;
+  blas_param.trans_a = QUDA_BLAS_OP_T;
+  blas_param.trans_b = QUDA_BLAS_OP_N;
+
+  const bool is_complex = blas_data_type == QUDA_BLAS_DATATYPE_C || blas_data_type == QUDA_BLAS_DATATYPE_Z;
+  const bool is_double = blas_data_type == QUDA_BLAS_DATATYPE_D || blas_data_type == QUDA_BLAS_DATATYPE_Z;
+  const size_t data_out_size = is_double ? sizeof(double) : sizeof(float);
+
+  // every stored matrix has at most 40 rows of 48 elements, and the largest stride is 3
+  const uint64_t length = (64 + static_cast<uint64_t>(blas_param.batch_count) * 3 * 48 * 40) * (is_complex ? 2 : 1);
+  const uint64_t bytes = length * data_out_size;
+
+  void *arrayA = pinned_malloc(bytes);
+  void *arrayB = pinned_malloc(bytes);
+  void *arrayC = pinned_malloc(bytes);
+  void *arrayCref = pinned_malloc(bytes);
+  void *arrayCout = pinned_malloc(bytes);
+  void *A_d = device_malloc(bytes);
+  void *B_d = device_malloc(bytes);
+  void *C_d = device_malloc(bytes);
+
+  std::mt19937 gen(1234);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  auto element = [&](void *array, uint64_t i) -> double {
+    return is_double ? static_cast<double *>(array)[i] : static_cast<float *>(array)[i];
+  };
+
+  double max_dev = 0.0, max_ref = 0.0;
+  for (auto order : {QUDA_BLAS_DATAORDER_ROW, QUDA_BLAS_DATAORDER_COL}) {
+    blas_param.data_order = order;
+    for (auto array : {arrayA, arrayB, arrayC}) {
+      for (uint64_t i = 0; i < length; i++) {
+        if (is_double)
+          static_cast<double *>(array)[i] = dist(gen);
+        else
+          static_cast<float *>(array)[i] = dist(gen);
+      }
+    }
+
+    memcpy(arrayCref, arrayC, bytes);
+    quda::blas_lapack::generic::set_zero_copy_gemm(true);
+    quda::blas_lapack::generic::stridedBatchGEMM(arrayA, arrayB, arrayCref, blas_param, QUDA_CPU_FIELD_LOCATION);
+
+    for (auto zero_copy : {true, false}) {
+      qudaMemcpy(A_d, arrayA, bytes, qudaMemcpyHostToDevice);
+      qudaMemcpy(B_d, arrayB, bytes, qudaMemcpyHostToDevice);
+      qudaMemcpy(C_d, arrayC, bytes, qudaMemcpyHostToDevice);
+      quda::blas_lapack::generic::set_zero_copy_gemm(zero_copy);
+      quda::blas_lapack::generic::stridedBatchGEMM(A_d, B_d, C_d, blas_param, QUDA_CUDA_FIELD_LOCATION);
+      qudaMemcpy(arrayCout, C_d, bytes, qudaMemcpyDeviceToHost);
+
+      for (uint64_t i = 0; i < length; i++) {
+        max_dev = std::max(max_dev, std::abs(element(arrayCout, i) - element(arrayCref, i)));
+        max_ref = std::max(max_ref, std::abs(element(arrayCref, i)));
+      }
+    }
+  }
+  quda::blas_lapack::generic::set_zero_copy_gemm(true);
+
+  host_free(arrayA);
+  host_free(arrayB);
+  host_free(arrayC);
+  host_free(arrayCref);
+  host_free(arrayCout);
+  device_free(A_d);
+  device_free(B_d);
+  device_free(C_d);
+
+  return max_dev / max_ref;
+}
+
 double lu_inv_test(test_t test_param)
 {
   QudaBLASParam blas_param = newQudaBLASParam();
@@ -317,6 +536,26 @@ double lu_inv_test(test_t test_param)
   return deviation;
 }
 
+double lu_inv_host_test(test_t test_param)
+{
+  // Run the host LU inversion with the fixed-size specializations
+  // (48, 64, 128) and a size that uses the dynamic fallback
+  auto native = native_blas_lapack;
+  auto mat_size = blas_lu_inv_mat_size;
+  native_blas_lapack = false;
+
+  double deviation = 0.0;
+  for (auto n : {48, 64, 128, 40}) {
+    blas_lu_inv_mat_size = n;
+    deviation = std::max(deviation, lu_inv_test(test_param));
+  }
+
+  native_blas_lapack = native;
+  blas_lu_inv_mat_size = mat_size;
+
+  return deviation;
+}
+
 struct blas_interface_test : quda_test {
 
   void add_command_line_group(std::shared_ptr<QUDAApp> app) const override
@@ -58,7 +58,23 @@ using ::testing::TestWithParam;
 using ::testing::Values;
 
 double gemm_test(test_t test_param);
+double gemm_host_test(test_t test_param);
+double gemm_host_benchmark(test_t test_param);
+double gemm_device_test(test_t test_param);
 double lu_inv_test(test_t test_param);
+double lu_inv_host_test(test_t test_param);
+
+double gemm_tolerance(QudaBLASDataType data_type)
+{
+  switch (data_type) {
+  case QUDA_BLAS_DATATYPE_S:
+  case QUDA_BLAS_DATATYPE_C: return 10 * std::numeric_limits<float>::epsilon();
+  case QUDA_BLAS_DATATYPE_D:
+  case QUDA_BLAS_DATATYPE_Z: return 10 * std::numeric_limits<double>::epsilon();
+  default: errorQuda("Unexpected BLAS data type %d", data_type);
+  }
+  return 0.0;
+}
 
 // Sets up the Google test
 TEST_P(BLASTest, verify)
@@ -102,6 +118,44 @@ TEST_P(BLASTest, verify)
   }
 }
 
+TEST_P(BLASTest, host_gemm)
+{
+  auto param = GetParam();
+  if (::testing::get<0>(param) != QUDA_BLAS_GEMM) GTEST_SKIP();
+
+  auto deviation = gemm_host_test(param);
+  EXPECT_LE(deviation, gemm_tolerance(::testing::get<1>(param))) << "Host and reference GEMM do not agree";
+}
+
+TEST_P(BLASTest, host_gemm_benchmark)
+{
+  auto param = GetParam();
+  if (::testing::get<0>(param) != QUDA_BLAS_GEMM) GTEST_SKIP();
+
+  auto deviation = gemm_host_benchmark(param);
+  EXPECT_LE(deviation, gemm_tolerance(::testing::get<1>(param))) << "Zero-copy and copying host GEMM do not agree";
+}
+
+TEST_P(BLASTest, host_gemm_device)
+{
+  auto param = GetParam();
+  if (::testing::get<0>(param) != QUDA_BLAS_GEMM) GTEST_SKIP();
+
+  auto deviation = gemm_device_test(param);
+  EXPECT_LE(deviation, gemm_tolerance(::testing::get<1>(param))) << "Host GEMM on device and host arrays do not agree";
+}
+
+TEST_P(BLASTest, host_lu_inv)
+{
+  auto param = GetParam();
+  if (::testing::get<0>(param) != QUDA_BLAS_LU_INV || skip_test(param)) GTEST_SKIP();
+
+  auto deviation = lu_inv_host_test(param);
+  auto tol = ::testing::get<1>(param) == QUDA_BLAS_DATATYPE_C ? 5000 * std::numeric_limits<float>::epsilon() :
+                                                                 5000 * std::numeric_limits<double>::epsilon();
+  EXPECT_LE(deviation, tol) << "Host and reference LU inversion do not agree";
+}
+
 // BLAS test type
 auto blas_test_type_value = Values(QUDA_BLAS_GEMM, QUDA_BLAS_LU_INV);
 
@@ -1,5 +1,6 @@
 #include <cstdio>
 #include <cstdlib>
+#include <thread>
 
 #include <quda_internal.h>
 #include <timer.h>
@@ -10,6 +11,7 @@
 #include <command_line_params.h>
 
 #include <tune_quda.h>
+#include <thread_pool.h>
 
 // include because of nasty globals used in the tests
 #include <dslash_reference.h>
@@ -1196,6 +1198,69 @@ TEST_P(BlasTest, benchmark)
   printfQuda("%-31s: Gflop/s = %6.1f, GB/s = %6.1f\n", kernel_map.at(kernel).c_str(), gflops, gbytes);
 }
 
+/**
+   Benchmark the host reductions executed on the host thread pool
+   against serial execution.  Since the host reduction tree is
+   independent of the number of threads, the results must agree
+   bitwise.
+*/
+TEST(HostReductionTest, benchmark)
+{
+  ColorSpinorParam param;
+  param.nColor = Ncolor;
+  param.nSpin = Nspin;
+  param.nDim = 4;
+  param.siteSubset = QUDA_FULL_SITE_SUBSET;
+  param.x[0] = xdim;
+  param.x[1] = ydim;
+  param.x[2] = zdim;
+  param.x[3] = tdim;
+  param.siteOrder = QUDA_EVEN_ODD_SITE_ORDER;
+  param.gammaBasis = QUDA_DEGRAND_ROSSI_GAMMA_BASIS;
+  param.setPrecision(QUDA_DOUBLE_PRECISION);
+  param.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+  param.create = QUDA_ZERO_FIELD_CREATE;
+  param.pc_type = QUDA_4D_PC;
+  param.location = QUDA_CPU_FIELD_LOCATION;
+
+  ColorSpinorField xH(param);
+  ColorSpinorField yH(param);
+  xH.Source(QUDA_RANDOM_SOURCE, 0, 0, 0);
+  yH.Source(QUDA_RANDOM_SOURCE, 0, 0, 0);
+
+  const int n_threads = thread_pool::get_num_threads();
+  const int n_threads_max = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+
+  auto run = [&](int threads, double &norm, Complex &dot) {
+    thread_pool::set_num_threads(threads);
+    norm = blas::norm2(xH); // warm up
+    host_timer_t timer;
+    timer.start();
+    for (int i = 0; i < niter; i++) {
+      norm = blas::norm2(xH);
+      dot = blas::cDotProduct(xH, yH);
+    }
+    timer.stop();
+    return timer.last();
+  };
+
+  double norm_serial, norm_parallel;
+  Complex dot_serial, dot_parallel;
+  double secs_serial = run(1, norm_serial, dot_serial);
+  double secs_parallel = run(n_threads_max, norm_parallel, dot_parallel);
+  thread_pool::set_num_threads(n_threads); // restore thread pool
+
+  double gbytes = 3.0 * niter * xH.Bytes() * 1e-9;
+  printfQuda("Host reductions: serial GB/s = %6.2f, %d threads GB/s = %6.2f, speedup = %5.2f\n",
+             gbytes / secs_serial, n_threads_max, gbytes / secs_parallel, secs_serial / secs_parallel);
+  RecordProperty("GBs_serial", std::to_string(gbytes / secs_serial));
+  RecordProperty("GBs_parallel", std::to_string(gbytes / secs_parallel));
+
+  EXPECT_EQ(norm_serial, norm_parallel) << "Host norm2 is not reproducible";
+  EXPECT_EQ(dot_serial.real(), dot_parallel.real()) << "Host cDotProduct is not reproducible";
+  EXPECT_EQ(dot_serial.imag(), dot_parallel.imag()) << "Host cDotProduct is not reproducible";
+}
+
 std::string getblasname(testing::TestParamInfo<::testing::tuple<int, int>> param)
 {
   prec_pair_t prec_pair = prec_idx_map(::testing::get<0>(param.param));
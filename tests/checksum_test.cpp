@@ -0,0 +1,90 @@
+#include <random>
+#include <quda.h>
+#include <gauge_field.h>
+#include <gauge_tools.h>
+#include <test.h>
+#include <host_utils.h>
+
+/*
+   Check that the block checksums localize a difference between two
+   gauge fields: a copy of a random host field has identical block
+   checksums, and corrupting a single link of the copy changes the
+   checksum of exactly the block that contains it.
+ */
+
+using namespace quda;
+
+class ChecksumTest : public ::testing::TestWithParam<lat_dim_t>
+{
+};
+
+TEST_P(ChecksumTest, localize)
+{
+  lat_dim_t x = {xdim, ydim, zdim, tdim};
+  GaugeFieldParam param(x, QUDA_DOUBLE_PRECISION, QUDA_RECONSTRUCT_NO, 0, QUDA_VECTOR_GEOMETRY,
+                        QUDA_GHOST_EXCHANGE_NO);
+  param.location = QUDA_CPU_FIELD_LOCATION;
+  param.order = QUDA_QDP_GAUGE_ORDER;
+  param.link_type = QUDA_GENERAL_LINKS;
+  param.create = QUDA_NULL_FIELD_CREATE;
+  GaugeField a(param);
+  GaugeField b(param);
+  gaugeNoise(a, 1234, QUDA_NOISE_GAUSS);
+  b.copy(a);
+
+  auto sum_a = BlockChecksum(a, GetParam());
+  EXPECT_EQ(sum_a.global(), Checksum(a));
+  EXPECT_EQ(printChecksumDiff(sum_a, BlockChecksum(b, GetParam())), 0ul);
+
+  std::mt19937 gen(5678 + comm_rank());
+  for (int trial = 0; trial < 4; trial++) {
+    lat_dim_t c;
+    for (int d = 0; d < 4; d++) c[d] = std::uniform_int_distribution<int>(0, x[d] - 1)(gen);
+    const int dim = std::uniform_int_distribution<int>(0, 3)(gen);
+
+    // QDP order is even-odd, with each link a 3x3 complex matrix
+    const size_t index = ((static_cast<size_t>(c[3]) * x[2] + c[2]) * x[1] + c[1]) * x[0] + c[0];
+    const int parity = (c[0] + c[1] + c[2] + c[3]) % 2;
+    const size_t site = parity * (b.Volume() / 2) + index / 2;
+    double *link = b.data<double *>(dim) + site * 18;
+    const double value = link[0];
+    link[0] += 1.0;
+
+    auto sum_b = BlockChecksum(b, GetParam());
+    auto blocks = sum_a.diff(sum_b);
+    ASSERT_EQ(blocks.size(), 1ul);
+
+    size_t expected = 0;
+    for (int d = 3; d >= 0; d--) expected = expected * sum_a.n_block[d] + c[d] / sum_a.block[d];
+    EXPECT_EQ(blocks[0], expected);
+    lat_dim_t o = sum_a.origin(blocks[0]);
+    for (int d = 0; d < 4; d++) {
+      EXPECT_LE(o[d], c[d]);
+      EXPECT_LT(c[d], o[d] + sum_a.block[d]);
+    }
+    EXPECT_EQ(printChecksumDiff(sum_a, sum_b), 1ul);
+
+    link[0] = value;
+  }
+
+  EXPECT_EQ(printChecksumDiff(sum_a, BlockChecksum(b, GetParam())), 0ul);
+}
+
+std::string getBlockName(testing::TestParamInfo<lat_dim_t> param)
+{
+  std::string name = "block";
+  for (int d = 0; d < 4; d++) name += "_" + std::to_string(param.param[d]);
+  return name;
+}
+
+// the default blocking, a blocking that truncates the last block in each dimension, and single sites
+INSTANTIATE_TEST_SUITE_P(Checksum, ChecksumTest,
+                         ::testing::Values(lat_dim_t {0, 0, 0, 0}, lat_dim_t {3, 5, 3, 5}, lat_dim_t {1, 1, 1, 1}),
+                         getBlockName);
+
+int main(int argc, char **argv)
+{
+  quda_test test("checksum_test", argc, argv);
+  test.init();
+  return test.execute();
+}
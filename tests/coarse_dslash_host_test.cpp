@@ -0,0 +1,196 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <quda.h>
+#include <color_spinor_field.h>
+#include <gauge_field.h>
+#include <multigrid.h>
+#include <test.h>
+
+/*
+   Check of the host coarse dslash against the device coarse dslash.
+   Random coarse link and clover fields, and random spinors, are
+   created on the host and copied to the device, and ApplyCoarse is
+   applied at both locations.  The operators checked are those used
+   by DiracCoarse and DiracCoarsePC: the full-parity operator with the
+   links Y, the single-parity hopping term with the preconditioned
+   links Yhat, and the single-parity dslash-xpay with distinct inputs,
+   each with and without dagger.
+ */
+
+using namespace quda;
+
+enum class coarse_op { full, yhat, xpay };
+
+// tuple types: operator, dagger
+using coarse_test_t = ::testing::tuple<coarse_op, bool>;
+
+class CoarseDslashHostTest : public ::testing::TestWithParam<coarse_test_t>
+{
+protected:
+  static constexpr int Nc = 24;
+  static constexpr QudaPrecision prec = QUDA_SINGLE_PRECISION;
+  const lat_dim_t x = {4, 4, 4, 4};
+  coarse_op op;
+  bool dagger;
+  std::mt19937 gen;
+
+  /**
+     @brief Fill a host buffer of floats with uniform random values
+  */
+  void fill(void *v, size_t bytes)
+  {
+    std::uniform_real_distribution<float> dist(-1.0, 1.0);
+    float *f = static_cast<float *>(v);
+    for (size_t i = 0; i < bytes / sizeof(float); i++) f[i] = dist(gen);
+  }
+
+  GaugeFieldParam gauge_param(QudaFieldLocation location, QudaFieldGeometry geometry) const
+  {
+    GaugeFieldParam param;
+    param.x = x;
+    param.location = location;
+    param.nColor = 2 * Nc;
+    param.reconstruct = QUDA_RECONSTRUCT_NO;
+    param.order = location == QUDA_CUDA_FIELD_LOCATION ? QUDA_FLOAT2_GAUGE_ORDER : QUDA_QDP_GAUGE_ORDER;
+    param.link_type = QUDA_COARSE_LINKS;
+    param.t_boundary = QUDA_PERIODIC_T;
+    param.create = QUDA_ZERO_FIELD_CREATE;
+    param.setPrecision(prec);
+    param.nDim = 4;
+    param.siteSubset = QUDA_FULL_SITE_SUBSET;
+    param.geometry = geometry;
+    if (geometry == QUDA_COARSE_GEOMETRY) {
+      param.ghostExchange = QUDA_GHOST_EXCHANGE_PAD;
+      param.nFace = 1;
+      int pad = std::max({(x[0] * x[1] * x[2]) / 2, (x[1] * x[2] * x[3]) / 2, (x[0] * x[2] * x[3]) / 2,
+                          (x[0] * x[1] * x[3]) / 2});
+      param.pad = location == QUDA_CUDA_FIELD_LOCATION ? 2 * pad : 0; // bi-directional ghost zone
+    } else {
+      param.ghostExchange = QUDA_GHOST_EXCHANGE_NO;
+      param.nFace = 0;
+    }
+    return param;
+  }
+
+  ColorSpinorParam spinor_param(QudaFieldLocation location, QudaSiteSubset subset) const
+  {
+    ColorSpinorParam param;
+    param.nColor = Nc;
+    param.nSpin = 2;
+    param.nDim = 4;
+    for (int d = 0; d < 4; d++) param.x[d] = x[d];
+    if (subset == QUDA_PARITY_SITE_SUBSET) param.x[0] /= 2;
+    param.siteSubset = subset;
+    param.pc_type = QUDA_4D_PC;
+    param.siteOrder = QUDA_EVEN_ODD_SITE_ORDER;
+    param.gammaBasis = QUDA_DEGRAND_ROSSI_GAMMA_BASIS;
+    param.location = location;
+    param.create = QUDA_ZERO_FIELD_CREATE;
+    if (location == QUDA_CUDA_FIELD_LOCATION) {
+      param.setPrecision(prec, prec, true);
+    } else {
+      param.setPrecision(prec);
+      param.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+    }
+    return param;
+  }
+
+  /**
+     @brief Create a random host link field and its device copy, with
+     the bidirectional ghosts exchanged at both locations as done by
+     DiracCoarse
+  */
+  void create_links(GaugeField &host, GaugeField &device, QudaFieldGeometry geometry)
+  {
+    host = GaugeField(gauge_param(QUDA_CPU_FIELD_LOCATION, geometry));
+    device = GaugeField(gauge_param(QUDA_CUDA_FIELD_LOCATION, geometry));
+    for (int d = 0; d < host.Geometry(); d++) fill(host.data(d), host.Bytes() / host.Geometry());
+    device.copy(host);
+    if (geometry == QUDA_COARSE_GEOMETRY) {
+      host.exchangeGhost(QUDA_LINK_BIDIRECTIONAL);
+      device.exchangeGhost(QUDA_LINK_BIDIRECTIONAL);
+    }
+  }
+
+public:
+  CoarseDslashHostTest() :
+    op(::testing::get<0>(GetParam())), dagger(::testing::get<1>(GetParam())), gen(1234 + comm_rank())
+  {
+  }
+};
+
+TEST_P(CoarseDslashHostTest, verify)
+{
+  if (!is_enabled_multigrid()) GTEST_SKIP();
+
+  GaugeField Y_h, Y_d, X_h, X_d;
+  create_links(Y_h, Y_d, QUDA_COARSE_GEOMETRY);
+  create_links(X_h, X_d, QUDA_SCALAR_GEOMETRY);
+
+  const QudaSiteSubset subset = op == coarse_op::full ? QUDA_FULL_SITE_SUBSET : QUDA_PARITY_SITE_SUBSET;
+  ColorSpinorField inA_h(spinor_param(QUDA_CPU_FIELD_LOCATION, subset));
+  ColorSpinorField inB_h(spinor_param(QUDA_CPU_FIELD_LOCATION, subset));
+  ColorSpinorField out_h(spinor_param(QUDA_CPU_FIELD_LOCATION, subset));
+  ColorSpinorField result(spinor_param(QUDA_CPU_FIELD_LOCATION, subset));
+  ColorSpinorField inA_d(spinor_param(QUDA_CUDA_FIELD_LOCATION, subset));
+  ColorSpinorField inB_d(spinor_param(QUDA_CUDA_FIELD_LOCATION, subset));
+  ColorSpinorField out_d(spinor_param(QUDA_CUDA_FIELD_LOCATION, subset));
+  fill(inA_h.data(), inA_h.Bytes());
+  fill(inB_h.data(), inB_h.Bytes());
+  inA_d = inA_h;
+  inB_d = inB_h;
+
+  const double kappa = 0.1;
+  switch (op) {
+  case coarse_op::full:
+    ApplyCoarse(out_h, inA_h, inA_h, Y_h, X_h, kappa, QUDA_INVALID_PARITY, true, true, dagger);
+    ApplyCoarse(out_d, inA_d, inA_d, Y_d, X_d, kappa, QUDA_INVALID_PARITY, true, true, dagger);
+    break;
+  case coarse_op::yhat: {
+    // the preconditioned links have the same layout as Y, so a second random link field stands in for them
+    GaugeField Yhat_h, Yhat_d;
+    create_links(Yhat_h, Yhat_d, QUDA_COARSE_GEOMETRY);
+    ApplyCoarse(out_h, inA_h, inA_h, Yhat_h, X_h, kappa, QUDA_EVEN_PARITY, true, false, dagger);
+    ApplyCoarse(out_d, inA_d, inA_d, Yhat_d, X_d, kappa, QUDA_EVEN_PARITY, true, false, dagger);
+    break;
+  }
+  case coarse_op::xpay:
+    ApplyCoarse(out_h, inA_h, inB_h, Y_h, X_h, kappa, QUDA_ODD_PARITY, true, true, dagger);
+    ApplyCoarse(out_d, inA_d, inB_d, Y_d, X_d, kappa, QUDA_ODD_PARITY, true, true, dagger);
+    break;
+  }
+  result = out_d;
+
+  double max_diff = 0.0, max_abs = 0.0;
+  const float *h = out_h.data<const float *>();
+  const float *d = result.data<const float *>();
+  for (size_t i = 0; i < out_h.Bytes() / sizeof(float); i++) {
+    max_diff = std::max(max_diff, std::abs(static_cast<double>(h[i]) - d[i]));
+    max_abs = std::max(max_abs, std::abs(static_cast<double>(d[i])));
+  }
+  comm_allreduce_max(max_diff);
+  comm_allreduce_max(max_abs);
+  EXPECT_GT(max_abs, 0.0);
+  EXPECT_LE(max_diff, 1e-5 * max_abs);
+}
+
+std::string getCoarseName(testing::TestParamInfo<coarse_test_t> param)
+{
+  const char *names[] = {"full", "yhat", "xpay"};
+  std::string name = names[static_cast<int>(::testing::get<0>(param.param))];
+  if (::testing::get<1>(param.param)) name += "_dagger";
+  return name;
+}
+
+INSTANTIATE_TEST_SUITE_P(CoarseDslash, CoarseDslashHostTest,
+                         ::testing::Combine(::testing::Values(coarse_op::full, coarse_op::yhat, coarse_op::xpay),
+                                            ::testing::Bool()),
+                         getCoarseName);
+
+int main(int argc, char **argv)
+{
+  quda_test test("coarse_dslash_host_test", argc, argv);
+  test.init();
+  return test.execute();
+}
@@ -78,6 +78,56 @@ TEST_F(DslashTest, verify)
   ASSERT_LE(deviation, tol) << "CPU and CUDA implementations do not agree";
 }
 
+TEST_F(DslashTest, host_reference)
+{
+  // compares the fast host Wilson dslash against the original reference implementation, and times both
+  if (dslash_type != QUDA_WILSON_DSLASH || dslash_test_wrapper.dtest_type != dslash_test_type::Dslash) GTEST_SKIP();
+
+  auto &spinor = dslash_test_wrapper.spinor;
+  auto &spinorRef = dslash_test_wrapper.spinorRef;
+  auto &spinorTmp = dslash_test_wrapper.spinorTmp;
+  auto &gauge_param = dslash_test_wrapper.gauge_param;
+  auto &inv_param = dslash_test_wrapper.inv_param;
+  const int parity = dslash_test_wrapper.parity;
+
+  host_timer_t timer;
+  timer.start();
+  wil_dslash_naive(spinorTmp.data(), dslash_test_wrapper.hostGauge, spinor.data(), parity, inv_param.dagger,
+                   inv_param.cpu_prec, gauge_param);
+  timer.stop();
+  double naive_time = timer.last();
+
+  timer.start();
+  for (int i = 0; i < niter; i++)
+    wil_dslash(spinorRef.data(), dslash_test_wrapper.hostGauge, spinor.data(), parity, inv_param.dagger,
+               inv_param.cpu_prec, gauge_param);
+  timer.stop();
+  double fast_time = timer.last() / niter;
+
+  // maximum deviation relative to the largest element of the reference
+  const size_t length = static_cast<size_t>(Vh) * spinor_site_size;
+  double max_dev = 0.0, max_ref = 0.0;
+  for (size_t i = 0; i < length; i++) {
+    double ref = inv_param.cpu_prec == QUDA_DOUBLE_PRECISION ? static_cast<double *>(spinorTmp.data())[i] :
+                                                               static_cast<float *>(spinorTmp.data())[i];
+    double fast = inv_param.cpu_prec == QUDA_DOUBLE_PRECISION ? static_cast<double *>(spinorRef.data())[i] :
+                                                                static_cast<float *>(spinorRef.data())[i];
+    max_dev = std::max(max_dev, std::abs(fast - ref));
+    max_ref = std::max(max_ref, std::abs(ref));
+  }
+  comm_allreduce_max(max_dev);
+  comm_allreduce_max(max_ref);
+  comm_allreduce_max(naive_time);
+  comm_allreduce_max(fast_time);
+
+  const double flops = 1320.0 * Vh * comm_size();
+  printfQuda("Host Wilson dslash: reference %.3f s (%.2f Gflop/s), fast %.3f s (%.2f Gflop/s), speedup %.1fx\n",
+             naive_time, 1e-9 * flops / naive_time, fast_time, 1e-9 * flops / fast_time, naive_time / fast_time);
+
+  double tol = getTolerance(inv_param.cpu_prec);
+  ASSERT_LE(max_dev, tol * max_ref) << "Fast and reference host Wilson dslash do not agree";
+}
+
 int main(int argc, char **argv)
 {
   // initalize google test, includes command line options
@@ -0,0 +1,104 @@
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+#include <eigensolve_quda.h>
+#include <eigen_helper.h>
+#include <test.h>
+
+/*
+   Check of the divide-and-conquer arrow-matrix eigensolver used by
+   TRLM against the dense Eigen solver.  The eigenvalues must agree,
+   and the eigenvectors must be orthonormal and have small residuals,
+   for random arrow matrices and for matrices with repeated diagonal
+   elements and zero couplings that exercise the deflation, as well as
+   for the smallest matrices.
+ */
+
+using namespace quda;
+
+// tuple types: dimension, arrow position, degenerate
+using arrow_test_t = ::testing::tuple<int, int, bool>;
+
+class ArrowEigensolveTest : public ::testing::TestWithParam<arrow_test_t>
+{
+protected:
+  int n;
+  int arrow_pos;
+  bool degenerate;
+
+public:
+  ArrowEigensolveTest() :
+    n(::testing::get<0>(GetParam())),
+    arrow_pos(::testing::get<1>(GetParam())),
+    degenerate(::testing::get<2>(GetParam()))
+  {
+  }
+};
+
+TEST_P(ArrowEigensolveTest, verify)
+{
+  if (arrow_pos >= n) GTEST_SKIP();
+
+  std::mt19937 gen(1234 + 100 * n + arrow_pos);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  std::vector<double> a(n), b(std::max(n - 1, 0));
+  for (auto &ai : a) ai = dist(gen);
+  for (auto &bi : b) bi = dist(gen);
+
+  if (degenerate) {
+    // the diagonal block takes only two distinct values, and every third coupling vanishes
+    for (int i = 0; i < arrow_pos; i++) a[i] = i % 2 ? 0.5 : -0.25;
+    for (int i = arrow_pos + 1; i < n; i++) a[i] = 0.5;
+    for (int i = 0; i < n - 1; i += 3) b[i] = 0.0;
+  }
+
+  MatrixXd A = MatrixXd::Zero(n, n);
+  for (int i = 0; i < n; i++) A(i, i) = a[i];
+  for (int i = 0; i < n - 1; i++) {
+    int j = i < arrow_pos ? arrow_pos : i + 1;
+    A(i, j) = b[i];
+    A(j, i) = b[i];
+  }
+
+  SelfAdjointEigenSolver<MatrixXd> dense(A);
+  const VectorXd &ref = dense.eigenvalues();
+
+  std::vector<double> evals(n);
+  MatrixXd V(n, n);
+  arrowEigensolve(a.data(), b.data(), n, arrow_pos, evals.data(), V.data());
+
+  const double norm = std::max(A.norm(), 1.0);
+  const double tol = 64 * n * std::numeric_limits<double>::epsilon() * norm;
+
+  Map<VectorXd> lambda(evals.data(), n);
+  EXPECT_TRUE(std::is_sorted(evals.begin(), evals.end()));
+  EXPECT_LE((lambda - ref).cwiseAbs().maxCoeff(), tol);
+  EXPECT_LE((V.transpose() * V - MatrixXd::Identity(n, n)).cwiseAbs().maxCoeff(), tol);
+  EXPECT_LE((A * V - V * lambda.asDiagonal()).cwiseAbs().maxCoeff(), tol);
+}
+
+std::string getArrowName(testing::TestParamInfo<arrow_test_t> param)
+{
+  std::string name = "n" + std::to_string(::testing::get<0>(param.param));
+  name += "_arrow" + std::to_string(::testing::get<1>(param.param));
+  if (::testing::get<2>(param.param)) name += "_degenerate";
+  return name;
+}
+
+INSTANTIATE_TEST_SUITE_P(Small, ArrowEigensolveTest,
+                         ::testing::Combine(::testing::Values(1, 2, 3), ::testing::Values(0, 1, 2), ::testing::Bool()),
+                         getArrowName);
+
+// sizes either side of the leaf size at which tridiagonal blocks are solved directly
+INSTANTIATE_TEST_SUITE_P(Large, ArrowEigensolveTest,
+                         ::testing::Combine(::testing::Values(31, 64, 200), ::testing::Values(0, 1, 20, 30),
+                                            ::testing::Bool()),
+                         getArrowName);
+
+int main(int argc, char **argv)
+{
+  quda_test test("eig_arrow_test", argc, argv);
+  test.init();
+  return test.execute();
+}
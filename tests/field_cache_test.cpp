@@ -0,0 +1,249 @@
+#include <thread>
+#include <vector>
+#include <quda.h>
+#include <color_spinor_field.h>
+#include <field_cache.h>
+#include <test.h>
+#include <host_utils.h>
+
+/*
+   Check of the FieldTmp cache: the memory budget is respected, the
+   least recently used fields are evicted first, a request can be
+   satisfied by aliasing a larger cached field, the statistics account
+   for every request and every byte held, and the cache remains
+   consistent under concurrent use from multiple threads, including
+   when a thread exits and its front cache is moved to the shared
+   cache.
+ */
+
+using namespace quda;
+
+class FieldCacheTest : public ::testing::Test
+{
+protected:
+  size_t budget;
+
+  /**
+     @brief Create a device spinor field whose volume is proportional
+     to the given time extent, so that fields with distinct extents
+     have distinct keys and sizes
+   */
+  ColorSpinorField field(int t) const
+  {
+    QudaGaugeParam gauge_param = newQudaGaugeParam();
+    QudaInvertParam inv_param = newQudaInvertParam();
+    setWilsonGaugeParam(gauge_param);
+    setInvertParam(inv_param);
+
+    ColorSpinorParam param;
+    constructWilsonTestSpinorParam(&param, &inv_param, &gauge_param);
+    for (int d = 0; d < 3; d++) param.x[d] = 4;
+    param.x[3] = t;
+    param.setPrecision(QUDA_SINGLE_PRECISION, QUDA_SINGLE_PRECISION, true);
+    param.location = QUDA_CUDA_FIELD_LOCATION;
+    param.create = QUDA_NULL_FIELD_CREATE;
+    return ColorSpinorField(param);
+  }
+
+  /**
+     @brief Request a temporary matching a field and return it to the cache
+  */
+  static void cycle(const ColorSpinorField &a) { auto tmp = getFieldTmp(a); }
+
+public:
+  void SetUp() override
+  {
+    budget = FieldTmp<ColorSpinorField>::get_budget();
+    FieldTmp<ColorSpinorField>::destroy();
+  }
+
+  void TearDown() override
+  {
+    FieldTmp<ColorSpinorField>::destroy();
+    FieldTmp<ColorSpinorField>::set_budget(budget);
+    FieldTmp<ColorSpinorField>::set_reuse_larger(0.0);
+  }
+};
+
+TEST_F(FieldCacheTest, budget)
+{
+  auto a = field(4);
+  auto b = field(8);
+  auto c = field(12);
+  auto large = field(32);
+  FieldTmp<ColorSpinorField>::set_budget(a.Bytes() + c.Bytes());
+
+  auto before = FieldTmp<ColorSpinorField>::get_stats();
+  cycle(a);
+  cycle(b);
+  cycle(c); // holding all three would exceed the budget
+  auto stats = FieldTmp<ColorSpinorField>::get_stats();
+  EXPECT_LE(stats.bytes_held, a.Bytes() + c.Bytes());
+  EXPECT_GT(stats.evictions, before.evictions);
+
+  // a field larger than the budget is not cached
+  cycle(large);
+  auto after = FieldTmp<ColorSpinorField>::get_stats();
+  EXPECT_EQ(after.evictions, stats.evictions + 1);
+  EXPECT_EQ(after.fields_held, stats.fields_held);
+  EXPECT_EQ(after.bytes_held, stats.bytes_held);
+
+  // lowering the budget evicts immediately
+  FieldTmp<ColorSpinorField>::set_budget(0);
+  EXPECT_EQ(FieldTmp<ColorSpinorField>::get_stats().bytes_held, 0ul);
+  EXPECT_EQ(FieldTmp<ColorSpinorField>::get_stats().fields_held, 0ul);
+}
+
+TEST_F(FieldCacheTest, lru)
+{
+  auto a = field(4);
+  auto b = field(8);
+  auto c = field(12);
+  FieldTmp<ColorSpinorField>::set_budget(b.Bytes() + c.Bytes());
+
+  cycle(a);
+  cycle(b);
+  cycle(a); // a is now more recently used than b
+  cycle(c); // evicts b, the least recently used
+
+  auto before = FieldTmp<ColorSpinorField>::get_stats();
+  cycle(a);
+  cycle(c);
+  auto after = FieldTmp<ColorSpinorField>::get_stats();
+  EXPECT_EQ(after.hits, before.hits + 2);
+  EXPECT_EQ(after.misses, before.misses);
+
+  cycle(b);
+  EXPECT_EQ(FieldTmp<ColorSpinorField>::get_stats().misses, after.misses + 1);
+}
+
+TEST_F(FieldCacheTest, reuse_larger)
+{
+  auto small = field(4);
+  auto large = field(8);
+  auto tiny = field(1);
+  FieldTmp<ColorSpinorField>::set_reuse_larger(4.0);
+
+  // larger fields are only reused from the shared cache, which the front cache of an exiting thread is moved to
+  std::thread([&]() { cycle(large); }).join();
+  auto before = FieldTmp<ColorSpinorField>::get_stats();
+  EXPECT_EQ(before.fields_held, 1ul);
+  EXPECT_EQ(before.bytes_held, large.Bytes());
+
+  {
+    auto tmp = getFieldTmp(small);
+    ColorSpinorField &f = tmp;
+    EXPECT_EQ(f.VolString(), small.VolString());
+    EXPECT_EQ(f.Bytes(), small.Bytes());
+    auto stats = FieldTmp<ColorSpinorField>::get_stats();
+    EXPECT_EQ(stats.larger_hits, before.larger_hits + 1);
+    EXPECT_EQ(stats.fields_held, 0ul);
+  }
+
+  // the larger field is returned to the cache under its own key
+  auto after = FieldTmp<ColorSpinorField>::get_stats();
+  EXPECT_EQ(after.fields_held, 1ul);
+  EXPECT_EQ(after.bytes_held, large.Bytes());
+  cycle(large);
+  EXPECT_EQ(FieldTmp<ColorSpinorField>::get_stats().hits, after.hits + 1);
+
+  // a field more than the factor larger is not reused
+  std::thread([&]() { cycle(large); }).join();
+  auto stats = FieldTmp<ColorSpinorField>::get_stats();
+  cycle(tiny);
+  EXPECT_EQ(FieldTmp<ColorSpinorField>::get_stats().misses, stats.misses + 1);
+  EXPECT_EQ(FieldTmp<ColorSpinorField>::get_stats().larger_hits, stats.larger_hits);
+}
+
+TEST_F(FieldCacheTest, stats)
+{
+  auto a = field(4);
+  auto b = field(8);
+
+  auto before = FieldTmp<ColorSpinorField>::get_stats();
+  EXPECT_EQ(before.fields_held, 0ul);
+  EXPECT_EQ(before.bytes_held, 0ul);
+
+  {
+    auto tmp_a = getFieldTmp(a);
+    auto tmp_b = getFieldTmp(b);
+    auto tmp_a2 = getFieldTmp(a);
+  }
+  auto stats = FieldTmp<ColorSpinorField>::get_stats();
+  EXPECT_EQ(stats.misses, before.misses + 3);
+  EXPECT_EQ(stats.fields_held, 3ul);
+  EXPECT_EQ(stats.bytes_held, 2 * a.Bytes() + b.Bytes());
+  EXPECT_GE(stats.peak_bytes_held, stats.bytes_held);
+
+  {
+    auto tmp_a = getFieldTmp(a);
+    auto tmp_a2 = getFieldTmp(a);
+    EXPECT_EQ(FieldTmp<ColorSpinorField>::get_stats().bytes_held, b.Bytes());
+  }
+  auto after = FieldTmp<ColorSpinorField>::get_stats();
+  EXPECT_EQ(after.hits, stats.hits + 2);
+  EXPECT_EQ(after.misses, stats.misses);
+  EXPECT_EQ(after.bytes_held, stats.bytes_held);
+
+  // the cumulative counters survive destroy, the holdings do not
+  FieldTmp<ColorSpinorField>::destroy();
+  auto destroyed = FieldTmp<ColorSpinorField>::get_stats();
+  EXPECT_EQ(destroyed.hits, after.hits);
+  EXPECT_EQ(destroyed.fields_held, 0ul);
+  EXPECT_EQ(destroyed.bytes_held, 0ul);
+}
+
+TEST_F(FieldCacheTest, concurrent)
+{
+  constexpr int n_thread = 8;
+  constexpr int n_iter = 200;
+  std::vector<ColorSpinorField> fields;
+  for (int t : {2, 4, 6}) fields.push_back(field(t));
+
+  // Populate the cache with enough fields of each key that the threads never miss, even with the front caches of
+  // the other threads full, so that no allocation is made by the threads: only the cache itself is under test.
+  constexpr int n_cached = 8 * n_thread;
+  {
+    std::vector<FieldTmp<ColorSpinorField>> tmp;
+    for (auto &f : fields)
+      for (int i = 0; i < n_cached; i++) tmp.push_back(getFieldTmp(f));
+  }
+  auto before = FieldTmp<ColorSpinorField>::get_stats();
+  size_t bytes = 0;
+  for (auto &f : fields) bytes += n_cached * f.Bytes();
+  EXPECT_EQ(before.fields_held, fields.size() * n_cached);
+  EXPECT_EQ(before.bytes_held, bytes);
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < n_thread; i++) {
+    threads.emplace_back([&, i]() {
+      for (int j = 0; j < n_iter; j++) {
+        auto tmp = getFieldTmp(fields[(i + j) % fields.size()]);
+        if (j % 3 == 0) cycle(fields[j % fields.size()]);
+      }
+    });
+  }
+  for (auto &thread : threads) thread.join();
+
+  // every request is accounted for exactly once, and every field has been returned
+  auto after = FieldTmp<ColorSpinorField>::get_stats();
+  EXPECT_EQ(after.hits - before.hits, static_cast<size_t>(n_thread * (n_iter + (n_iter + 2) / 3)));
+  EXPECT_EQ(after.misses, before.misses);
+  EXPECT_EQ(after.fields_held, before.fields_held);
+  EXPECT_EQ(after.bytes_held, before.bytes_held);
+
+  // the front caches of the exited threads have been moved to the shared cache, so evicting everything accounts
+  // for every field exactly
+  FieldTmp<ColorSpinorField>::set_budget(0);
+  auto evicted = FieldTmp<ColorSpinorField>::get_stats();
+  EXPECT_EQ(evicted.evictions - after.evictions, after.fields_held);
+  EXPECT_EQ(evicted.fields_held, 0ul);
+  EXPECT_EQ(evicted.bytes_held, 0ul);
+}
+
+int main(int argc, char **argv)
+{
+  quda_test test("field_cache_test", argc, argv);
+  test.init();
+  return test.execute();
+}
@@ -0,0 +1,178 @@
+#include <cstring>
+#include <random>
+#include <vector>
+#include <gauge_field.h>
+#include <timer.h>
+#include <test.h>
+
+/*
+   Check and benchmark of the host gauge reorder engine.  For each
+   pair of supported host orders, and each combination of double and
+   single precision, a random field is reordered with both the generic
+   CopyGauge host path and the dedicated reorder engine.  The results
+   must be bitwise identical, and the bandwidth of each path is
+   reported.
+ */
+
+using namespace quda;
+
+using reorder_test_t = ::testing::tuple<QudaGaugeFieldOrder, QudaGaugeFieldOrder, QudaPrecision, QudaPrecision>;
+
+/**
+   Host gauge field in a given order.  MILC_SITE fields can only be
+   references, so these are backed by a site-struct buffer with
+   padding either side of the links.
+ */
+struct HostGauge {
+  std::vector<char> site_buffer;
+  GaugeField u;
+
+  HostGauge(QudaGaugeFieldOrder order, QudaPrecision precision)
+  {
+    lat_dim_t x = {xdim, ydim, zdim, tdim};
+    GaugeFieldParam param(x, precision, QUDA_RECONSTRUCT_NO, 0, QUDA_VECTOR_GEOMETRY, QUDA_GHOST_EXCHANGE_NO);
+    param.location = QUDA_CPU_FIELD_LOCATION;
+    param.order = order;
+    param.link_type = QUDA_SU3_LINKS;
+    param.t_boundary = QUDA_PERIODIC_T;
+    param.create = QUDA_ZERO_FIELD_CREATE;
+
+    if (order == QUDA_MILC_SITE_GAUGE_ORDER) {
+      param.site_offset = 16;
+      param.site_size = 4 * 18 * precision + 32;
+      site_buffer.assign(static_cast<size_t>(xdim) * ydim * zdim * tdim * param.site_size, 0);
+      param.gauge = site_buffer.data();
+      param.create = QUDA_REFERENCE_FIELD_CREATE;
+    }
+
+    u = GaugeField(param);
+  }
+
+  /**
+     @brief Apply f(pointer, bytes) to each allocation of the field
+   */
+  template <typename F> void for_each_buffer(F &&f) const
+  {
+    if (u.Order() == QUDA_QDP_GAUGE_ORDER) {
+      for (int d = 0; d < u.Geometry(); d++) f(u.data<char *>(d), u.Bytes() / u.Geometry());
+    } else {
+      f(u.data<char *>(), u.Bytes());
+    }
+  }
+
+  void randomize(int seed)
+  {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    for_each_buffer([&](char *p, size_t bytes) {
+      if (u.Precision() == QUDA_DOUBLE_PRECISION) {
+        for (size_t i = 0; i < bytes / sizeof(double); i++) reinterpret_cast<double *>(p)[i] = dist(rng);
+      } else {
+        for (size_t i = 0; i < bytes / sizeof(float); i++) reinterpret_cast<float *>(p)[i] = dist(rng);
+      }
+    });
+  }
+
+  bool operator==(const HostGauge &other) const
+  {
+    std::vector<std::pair<char *, size_t>> a, b;
+    for_each_buffer([&](char *p, size_t bytes) { a.push_back({p, bytes}); });
+    other.for_each_buffer([&](char *p, size_t bytes) { b.push_back({p, bytes}); });
+    if (a.size() != b.size()) return false;
+    for (auto i = 0u; i < a.size(); i++)
+      if (a[i].second != b[i].second || memcmp(a[i].first, b[i].first, a[i].second)) return false;
+    return true;
+  }
+};
+
+class GaugeReorderTest : public ::testing::TestWithParam<reorder_test_t>
+{
+protected:
+  reorder_test_t param;
+
+public:
+  GaugeReorderTest() : param(GetParam()) { }
+};
+
+TEST_P(GaugeReorderTest, verify)
+{
+  auto out_order = ::testing::get<0>(param);
+  auto in_order = ::testing::get<1>(param);
+  auto out_prec = ::testing::get<2>(param);
+  auto in_prec = ::testing::get<3>(param);
+
+  HostGauge in(in_order, in_prec);
+  HostGauge out_generic(out_order, out_prec);
+  HostGauge out_reorder(out_order, out_prec);
+  in.randomize(comm_rank() + 1);
+
+  // bytes read and written per reorder
+  const double bytes = 4.0 * in.u.Volume() * 18 * (in_prec + out_prec);
+  const int n_iter = std::max(niter, 1);
+  host_timer_t timer;
+
+  timer.start();
+  for (int i = 0; i < n_iter; i++) copyGenericGauge(out_generic.u, in.u, QUDA_CPU_FIELD_LOCATION);
+  timer.stop();
+  const double generic_time = timer.last() / n_iter;
+
+  timer.start();
+  for (int i = 0; i < n_iter; i++) ASSERT_TRUE(reorderGaugeHost(out_reorder.u, in.u));
+  timer.stop();
+  const double reorder_time = timer.last() / n_iter;
+
+  printfQuda("order %d (prec %d) -> order %d (prec %d): CopyGauge %.3f GB/s, reorder engine %.3f GB/s (%.2fx)\n",
+             in_order, in_prec, out_order, out_prec, 1e-9 * bytes / generic_time, 1e-9 * bytes / reorder_time,
+             generic_time / reorder_time);
+  RecordProperty("CopyGauge_GBs", std::to_string(1e-9 * bytes / generic_time));
+  RecordProperty("reorder_GBs", std::to_string(1e-9 * bytes / reorder_time));
+
+  EXPECT_TRUE(out_reorder == out_generic);
+}
+
+std::vector<QudaGaugeFieldOrder> host_orders()
+{
+  std::vector<QudaGaugeFieldOrder> orders = {QUDA_QDP_GAUGE_ORDER, QUDA_MILC_GAUGE_ORDER, QUDA_MILC_SITE_GAUGE_ORDER};
+#ifdef BUILD_BQCD_INTERFACE
+  orders.push_back(QUDA_BQCD_GAUGE_ORDER);
+#endif
+#ifdef BUILD_TIFR_INTERFACE
+  orders.push_back(QUDA_TIFR_GAUGE_ORDER);
+  orders.push_back(QUDA_TIFR_PADDED_GAUGE_ORDER);
+#endif
+  return orders;
+}
+
+std::string getReorderName(testing::TestParamInfo<reorder_test_t> param)
+{
+  auto order_str = [](QudaGaugeFieldOrder order) {
+    switch (order) {
+    case QUDA_QDP_GAUGE_ORDER: return "qdp";
+    case QUDA_MILC_GAUGE_ORDER: return "milc";
+    case QUDA_MILC_SITE_GAUGE_ORDER: return "milc_site";
+    case QUDA_BQCD_GAUGE_ORDER: return "bqcd";
+    case QUDA_TIFR_GAUGE_ORDER: return "tifr";
+    case QUDA_TIFR_PADDED_GAUGE_ORDER: return "tifr_padded";
+    default: return "unknown";
+    }
+  };
+  auto prec_str = [](QudaPrecision prec) { return prec == QUDA_DOUBLE_PRECISION ? "d" : "s"; };
+
+  std::string name;
+  name += std::string(order_str(::testing::get<1>(param.param))) + "_" + prec_str(::testing::get<3>(param.param));
+  name += std::string("_to_") + order_str(::testing::get<0>(param.param)) + "_" + prec_str(::testing::get<2>(param.param));
+  return name;
+}
+
+INSTANTIATE_TEST_SUITE_P(HostOrders, GaugeReorderTest,
+                         ::testing::Combine(::testing::ValuesIn(host_orders()), ::testing::ValuesIn(host_orders()),
+                                            ::testing::Values(QUDA_DOUBLE_PRECISION, QUDA_SINGLE_PRECISION),
+                                            ::testing::Values(QUDA_DOUBLE_PRECISION, QUDA_SINGLE_PRECISION)),
+                         getReorderName);
+
+int main(int argc, char **argv)
+{
+  quda_test test("gauge_reorder_test", argc, argv);
+  test.init();
+  return test.execute();
+}
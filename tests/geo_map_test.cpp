@@ -0,0 +1,104 @@
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include <quda.h>
+#include <color_spinor_field.h>
+#include <thread_pool.h>
+#include <transfer.h>
+#include <test.h>
+
+/*
+   Check of the parallel construction of the transfer geometry maps
+   against the serial construction it replaced: the fine-to-coarse map
+   is computed site by site, and the coarse-to-fine map by sorting the
+   (coarse, fine) index pairs.  Both maps must match exactly, for a
+   range of geometries and block sizes and for thread counts that
+   split the fine sites into one or several chunks.
+ */
+
+using namespace quda;
+
+struct geo_t {
+  lat_dim_t x;
+  lat_dim_t block;
+};
+
+// tuple types: geometry, number of threads
+using geo_map_test_t = ::testing::tuple<geo_t, int>;
+
+class GeoMapTest : public ::testing::TestWithParam<geo_map_test_t>
+{
+protected:
+  int n_threads;
+
+public:
+  void SetUp() override { n_threads = thread_pool::get_num_threads(); }
+  void TearDown() override { thread_pool::set_num_threads(n_threads); }
+};
+
+TEST_P(GeoMapTest, verify)
+{
+  const geo_t geo = ::testing::get<0>(GetParam());
+  thread_pool::set_num_threads(::testing::get<1>(GetParam()));
+
+  ColorSpinorParam param;
+  param.nColor = 3;
+  param.nSpin = 4;
+  param.nDim = 4;
+  for (int d = 0; d < 4; d++) param.x[d] = geo.x[d];
+  param.siteSubset = QUDA_FULL_SITE_SUBSET;
+  param.pc_type = QUDA_4D_PC;
+  param.siteOrder = QUDA_EVEN_ODD_SITE_ORDER;
+  param.gammaBasis = QUDA_DEGRAND_ROSSI_GAMMA_BASIS;
+  param.location = QUDA_CPU_FIELD_LOCATION;
+  param.create = QUDA_NULL_FIELD_CREATE;
+  param.setPrecision(QUDA_SINGLE_PRECISION);
+  param.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+  ColorSpinorField fine(param);
+  ColorSpinorField coarse = fine.create_coarse(geo.block.data, 2, 24);
+
+  const size_t volume = fine.Volume();
+  std::vector<int> fine_to_coarse(volume), coarse_to_fine(volume);
+  computeGeoMap(fine_to_coarse.data(), coarse_to_fine.data(), fine, coarse, geo.block.data);
+
+  std::vector<std::pair<int, int>> geo_sort(volume);
+  for (size_t i = 0; i < volume; i++) {
+    int x[QUDA_MAX_DIM];
+    fine.LatticeIndex(x, i);
+    for (int d = 0; d < fine.Ndim(); d++) x[d] /= geo.block[d];
+    int k;
+    coarse.OffsetIndex(k, x);
+    EXPECT_EQ(fine_to_coarse[i], k);
+    geo_sort[i] = {k, static_cast<int>(i)};
+  }
+  std::sort(geo_sort.begin(), geo_sort.end());
+
+  for (size_t i = 0; i < volume; i++) EXPECT_EQ(coarse_to_fine[i], geo_sort[i].second);
+}
+
+std::string getGeoMapName(testing::TestParamInfo<geo_map_test_t> param)
+{
+  const geo_t geo = ::testing::get<0>(param.param);
+  std::string name = std::to_string(geo.x[0]);
+  for (int d = 1; d < 4; d++) name += "x" + std::to_string(geo.x[d]);
+  name += "_block" + std::to_string(geo.block[0]);
+  for (int d = 1; d < 4; d++) name += "x" + std::to_string(geo.block[d]);
+  name += "_threads" + std::to_string(::testing::get<1>(param.param));
+  return name;
+}
+
+// volumes below and above the minimum chunk of fine sites per thread, with uniform and anisotropic blocks
+INSTANTIATE_TEST_SUITE_P(GeoMap, GeoMapTest,
+                         ::testing::Combine(::testing::Values(geo_t {{4, 4, 4, 4}, {2, 2, 2, 2}},
+                                                              geo_t {{12, 8, 16, 24}, {2, 4, 4, 2}},
+                                                              geo_t {{16, 16, 16, 32}, {4, 4, 4, 4}},
+                                                              geo_t {{16, 16, 16, 32}, {2, 2, 4, 8}}),
+                                            ::testing::Values(1, 3, 8)),
+                         getGeoMapName);
+
+int main(int argc, char **argv)
+{
+  quda_test test("geo_map_test", argc, argv);
+  test.init();
+  return test.execute();
+}
@@ -0,0 +1,177 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <quda.h>
+#include <color_spinor_field.h>
+#include <gauge_field.h>
+#include <gauge_tools.h>
+#include <instantiate.h>
+#include <random_quda.h>
+#include <test.h>
+#include <host_utils.h>
+
+/*
+   Check of the host noise generation.  Spinor and gauge noise is
+   generated on host fields, with the RNG states regenerated on the
+   host, and on device fields with the same seed, and the results are
+   compared.  Uniform noise must be bitwise identical, while Gaussian
+   noise may differ by a few ulp due to the host and device
+   transcendental functions.  Several fields are generated from each
+   RNG, to check the streams continue identically, including after
+   noise on a single parity, which draws from only half the states.
+ */
+
+using namespace quda;
+
+using noise_test_t = ::testing::tuple<QudaPrecision, QudaNoiseType>;
+
+class HostNoiseTest : public ::testing::TestWithParam<noise_test_t>
+{
+protected:
+  QudaPrecision prec;
+  QudaNoiseType type;
+
+public:
+  HostNoiseTest() : prec(::testing::get<0>(GetParam())), type(::testing::get<1>(GetParam())) { }
+
+  /**
+     @brief Return the maximum difference between two host buffers,
+     relative to the maximum magnitude in the first
+   */
+  double max_deviation(const void *a, const void *b, size_t bytes) const
+  {
+    double max_diff = 0.0, max_abs = 0.0;
+    auto accumulate = [&](auto *x, auto *y) {
+      for (size_t i = 0; i < bytes / sizeof(*x); i++) {
+        max_diff = std::max(max_diff, std::abs(static_cast<double>(x[i]) - y[i]));
+        max_abs = std::max(max_abs, std::abs(static_cast<double>(x[i])));
+      }
+    };
+    if (prec == QUDA_DOUBLE_PRECISION)
+      accumulate(static_cast<const double *>(a), static_cast<const double *>(b));
+    else
+      accumulate(static_cast<const float *>(a), static_cast<const float *>(b));
+    return max_abs > 0.0 ? max_diff / max_abs : max_diff;
+  }
+
+  void compare(const void *a, const void *b, size_t bytes) const
+  {
+    if (type == QUDA_NOISE_UNIFORM) {
+      EXPECT_EQ(memcmp(a, b, bytes), 0);
+    } else {
+      const double tol = 8 * (prec == QUDA_DOUBLE_PRECISION ? std::numeric_limits<double>::epsilon() :
+                                                              std::numeric_limits<float>::epsilon());
+      EXPECT_LE(max_deviation(a, b, bytes), tol);
+    }
+  }
+};
+
+TEST_P(HostNoiseTest, spinor)
+{
+  if (!is_enabled_spin(4)) GTEST_SKIP();
+
+  QudaGaugeParam gauge_param = newQudaGaugeParam();
+  QudaInvertParam inv_param = newQudaInvertParam();
+  setWilsonGaugeParam(gauge_param);
+  setInvertParam(inv_param);
+  inv_param.cpu_prec = prec;
+
+  ColorSpinorParam param;
+  constructWilsonTestSpinorParam(&param, &inv_param, &gauge_param);
+  param.create = QUDA_ZERO_FIELD_CREATE;
+  ColorSpinorField host(param);
+  ColorSpinorField result(param);
+
+  param.setPrecision(prec, prec, true);
+  param.location = QUDA_CUDA_FIELD_LOCATION;
+  ColorSpinorField device(param);
+
+  RNG host_rng(host, 1234);
+  RNG device_rng(device, 1234);
+  for (int i = 0; i < 3; i++) {
+    spinorNoise(host, host_rng, type);
+    spinorNoise(device, device_rng, type);
+    result = device;
+    compare(host.data(), result.data(), host.Bytes());
+  }
+}
+
+TEST_P(HostNoiseTest, spinor_parity)
+{
+  if (!is_enabled_spin(4)) GTEST_SKIP();
+
+  QudaGaugeParam gauge_param = newQudaGaugeParam();
+  QudaInvertParam inv_param = newQudaInvertParam();
+  setWilsonGaugeParam(gauge_param);
+  setInvertParam(inv_param);
+  inv_param.cpu_prec = prec;
+
+  ColorSpinorParam param;
+  constructWilsonTestSpinorParam(&param, &inv_param, &gauge_param);
+  param.create = QUDA_ZERO_FIELD_CREATE;
+  ColorSpinorField host(param);
+  ColorSpinorField result(param);
+
+  param.setPrecision(prec, prec, true);
+  param.location = QUDA_CUDA_FIELD_LOCATION;
+  ColorSpinorField device(param);
+
+  // noise on one parity advances only the states of that parity, so the full-field draw that
+  // follows must continue each state from where it was left
+  RNG host_rng(host, 1234);
+  RNG device_rng(device, 1234);
+  spinorNoise(host.Even(), host_rng, type);
+  spinorNoise(device.Even(), device_rng, type);
+  result = device;
+  compare(host.data(), result.data(), host.Bytes());
+
+  spinorNoise(host, host_rng, type);
+  spinorNoise(device, device_rng, type);
+  result = device;
+  compare(host.data(), result.data(), host.Bytes());
+}
+
+TEST_P(HostNoiseTest, gauge)
+{
+  lat_dim_t x = {xdim, ydim, zdim, tdim};
+  GaugeFieldParam param(x, prec, QUDA_RECONSTRUCT_NO, 0, QUDA_VECTOR_GEOMETRY, QUDA_GHOST_EXCHANGE_NO);
+  param.location = QUDA_CPU_FIELD_LOCATION;
+  param.order = QUDA_QDP_GAUGE_ORDER;
+  param.link_type = QUDA_GENERAL_LINKS;
+  param.create = QUDA_ZERO_FIELD_CREATE;
+  GaugeField host(param);
+  GaugeField result(param);
+
+  param.location = QUDA_CUDA_FIELD_LOCATION;
+  param.setPrecision(prec, true);
+  GaugeField device(param);
+
+  RNG host_rng(host, 1234);
+  RNG device_rng(device, 1234);
+  for (int i = 0; i < 3; i++) {
+    gaugeNoise(host, host_rng, type);
+    gaugeNoise(device, device_rng, type);
+    result.copy(device);
+    for (int d = 0; d < host.Geometry(); d++) compare(host.data(d), result.data(d), host.Bytes() / host.Geometry());
+  }
+}
+
+std::string getNoiseName(testing::TestParamInfo<noise_test_t> param)
+{
+  std::string name = ::testing::get<0>(param.param) == QUDA_DOUBLE_PRECISION ? "double" : "single";
+  name += ::testing::get<1>(param.param) == QUDA_NOISE_GAUSS ? "_gauss" : "_uniform";
+  return name;
+}
+
+INSTANTIATE_TEST_SUITE_P(HostNoise, HostNoiseTest,
+                         ::testing::Combine(::testing::Values(QUDA_DOUBLE_PRECISION, QUDA_SINGLE_PRECISION),
+                                            ::testing::Values(QUDA_NOISE_UNIFORM, QUDA_NOISE_GAUSS)),
+                         getNoiseName);
+
+int main(int argc, char **argv)
+{
+  quda_test test("host_noise_test", argc, argv);
+  test.init();
+  return test.execute();
+}
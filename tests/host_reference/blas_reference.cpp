@@ -199,9 +199,13 @@ double blasGEMMEigenVerify(void *A_data, void *B_data, void *C_data_copy, void *
   double max_relative_deviation = 0.0;
   for (int batch = 0; batch < batches; batch += max_stride) {
 
-    // Populate Eigen objects
-    fillEigenArray(A, A_ptr, m, k, lda, a_offset);
-    fillEigenArray(B, B_ptr, k, n, ldb, b_offset);
+    // Populate Eigen objects, where A and B are stored transposed if op(A) and op(B) are transposes
+    bool trans_a = blas_param->trans_a != QUDA_BLAS_OP_N;
+    bool trans_b = blas_param->trans_b != QUDA_BLAS_OP_N;
+    A.resize(trans_a ? k : m, trans_a ? m : k);
+    B.resize(trans_b ? n : k, trans_b ? k : n);
+    fillEigenArray(A, A_ptr, A.rows(), A.cols(), lda, a_offset);
+    fillEigenArray(B, B_ptr, B.rows(), B.cols(), ldb, b_offset);
     fillEigenArray(C_eigen, Ccopy_ptr, m, n, ldc, c_offset);
     fillEigenArray(C_dev, C_ptr, m, n, ldc, c_offset);
 
@@ -2,6 +2,8 @@
 #include <stdlib.h>
 #include <math.h>
 #include <string.h>
+#include <algorithm>
+#include <vector>
 
 #include <host_utils.h>
 #include <quda_internal.h>
@@ -125,8 +127,229 @@ void staggeredDslashReference(real_t *res, real_t **fatlink, real_t **longlink,
   } // 4-d volume
 }
 
-void stag_dslash(ColorSpinorField &out, const GaugeField &fat_link, const GaugeField &long_link,
-                 const ColorSpinorField &in, int oddBit, int daggerBit, QudaDslashType dslash_type)
+
+//
+// Fast host staggered dslash
+//
+// The one-hop and three-hop neighbor indices are precomputed once per
+// parity, lattice geometry and ghost depth.  Sites are processed in
+// blocks of staggered_block_size, with the gathered neighbor vectors
+// and links of a block stored in structure-of-arrays order, so that
+// the complex SU(3) matrix-vector products vectorize over the sites of
+// the block.
+//
+
+namespace
+{
+
+  /**
+     Neighbor table for the sites of one parity, with entry
+     16 * i + 8 * (hop == 3) + dir holding the checkerboard index of
+     the neighbor at distance hop in direction dir (ordered +x, -x, +y,
+     ..., -t) of site i.  Neighbors that lie in a ghost zone are
+     encoded as -(ghost offset + 1), where the ghost offset is that of
+     the spinor ghost zone with depth nFace.
+   */
+  struct StaggeredNeighborTable {
+    int dims[4] = {};
+    int partitioned[4] = {};
+    int nFace = 0;
+    std::vector<int> index;
+
+    bool matches(const int partitioned_[4], int nFace_) const
+    {
+      if (index.size() != 16 * static_cast<size_t>(Vh) || nFace != nFace_) return false;
+      for (int d = 0; d < 4; d++)
+        if (dims[d] != Z[d] || partitioned[d] != partitioned_[d]) return false;
+      return true;
+    }
+  };
+
+  const std::vector<int> &staggeredNeighbors(int oddBit, int nFace)
+  {
+    static StaggeredNeighborTable table[2];
+
+    int partitioned[4] = {};
+#ifdef MULTI_GPU
+    for (int d = 0; d < 4; d++) partitioned[d] = quda::comm_dim_partitioned(d);
+#endif
+
+    StaggeredNeighborTable &t = table[oddBit];
+    if (t.matches(partitioned, nFace)) return t.index;
+
+    for (int d = 0; d < 4; d++) {
+      t.dims[d] = Z[d];
+      t.partitioned[d] = partitioned[d];
+    }
+    t.nFace = nFace;
+    t.index.resize(16 * static_cast<size_t>(Vh));
+
+#pragma omp parallel for
+    for (int i = 0; i < Vh; i++) {
+      int Y = fullLatticeIndex(i, oddBit);
+      int x[4] = {Y % Z[0], (Y / Z[0]) % Z[1], (Y / (Z[1] * Z[0])) % Z[2], Y / (Z[2] * Z[1] * Z[0])};
+
+      for (int hop = 1; hop <= 3; hop += 2) {
+        for (int dir = 0; dir < 8; dir++) {
+          int d = dir / 2;
+          int y[4] = {x[0], x[1], x[2], x[3]};
+          y[d] += (dir % 2 == 0) ? hop : -hop;
+          int &entry = t.index[16 * i + 8 * (hop / 3) + dir];
+
+          if ((y[d] < 0 || y[d] >= Z[d]) && partitioned[d]) {
+            // index of the site within the face orthogonal to d, and the depth into the ghost zone
+            int face = 0;
+            for (int e = 3; e >= 0; e--)
+              if (e != d) face = face * Z[e] + x[e];
+            int depth = y[d] < 0 ? y[d] + nFace : y[d] - Z[d];
+            entry = -((depth * faceVolume[d] + face) / 2 + 1);
+          } else {
+            y[d] = (y[d] + Z[d]) % Z[d];
+            entry = (((y[3] * Z[2] + y[2]) * Z[1] + y[1]) * Z[0] + y[0]) / 2;
+          }
+        }
+      }
+    }
+
+    return t.index;
+  }
+
+  /** number of sites processed together by the fast dslash */
+  constexpr int staggered_block_size = 8;
+
+  /**
+     @brief Accumulate sign * U v (forward) or sign * U^dagger v
+     (backward) for each site of a block
+  */
+  template <bool forward, typename real_t, int W>
+  inline void su3MulBlock(real_t acc[3][2][W], const real_t U[3][3][2][W], const real_t v[3][2][W], real_t sign)
+  {
+    for (int r = 0; r < 3; r++) {
+#pragma omp simd
+      for (int w = 0; w < W; w++) {
+        real_t re = 0, im = 0;
+        for (int c = 0; c < 3; c++) {
+          if constexpr (forward) {
+            re += U[r][c][0][w] * v[c][0][w] - U[r][c][1][w] * v[c][1][w];
+            im += U[r][c][0][w] * v[c][1][w] + U[r][c][1][w] * v[c][0][w];
+          } else {
+            re += U[c][r][0][w] * v[c][0][w] + U[c][r][1][w] * v[c][1][w];
+            im += U[c][r][0][w] * v[c][1][w] - U[c][r][1][w] * v[c][0][w];
+          }
+        }
+        acc[r][0][w] += sign * re;
+        acc[r][1][w] += sign * im;
+      }
+    }
+  }
+
+} // namespace
+
+/**
+ * @brief Fast host routine to apply the even-odd or odd-even component of a staggered-type dslash,
+ *        optionally fused with an xpay: res = a * x + D in, with D negated if daggerBit is set
+ *
+ * @param x Optional host spinor to accumulate, nullptr to apply the dslash only
+ * @param a Scale factor of x
+ *
+ * The other parameters are as per staggeredDslashReference
+ */
+template <typename real_t>
+void staggeredDslashFast(real_t *res, real_t **fatlink, real_t **longlink, real_t **ghostFatlink,
+                         real_t **ghostLonglink, const real_t *spinorField, real_t **fwd_nbr_spinor,
+                         real_t **back_nbr_spinor, int oddBit, int daggerBit, QudaDslashType dslash_type,
+                         const real_t *x = nullptr, real_t a = 0.0)
+{
+  constexpr int W = staggered_block_size;
+  const bool asqtad = dslash_type == QUDA_ASQTAD_DSLASH;
+  const int nFace = asqtad ? 3 : 1;
+  const std::vector<int> &nbr = staggeredNeighbors(oddBit, nFace);
+  const int n_block = (Vh + W - 1) / W;
+  const real_t back_sign = dslash_type == QUDA_LAPLACE_DSLASH ? 1.0 : -1.0;
+  const real_t dagger_sign = daggerBit ? -1.0 : 1.0;
+
+#pragma omp parallel for schedule(static)
+  for (int b = 0; b < n_block; b++) {
+    const int i0 = b * W;
+    const int n = std::min(W, Vh - i0);
+
+    // lanes beyond the end of the lattice duplicate the last site and are not stored
+    int site[W];
+    for (int w = 0; w < W; w++) site[w] = i0 + std::min(w, n - 1);
+
+    alignas(64) real_t acc[3][2][W] = {};
+    alignas(64) real_t v[3][2][W];
+    alignas(64) real_t U[3][3][2][W];
+
+    for (int hop = 1; hop <= (asqtad ? 3 : 1); hop += 2) {
+      real_t **link = hop == 1 ? fatlink : longlink;
+      real_t **ghost_link = hop == 1 ? ghostFatlink : ghostLonglink;
+
+      for (int dir = 0; dir < 8; dir++) {
+        const int d = dir / 2;
+        const bool forward = (dir % 2 == 0);
+
+        for (int w = 0; w < W; w++) {
+          const int i = site[w];
+          const int j = nbr[16 * i + 8 * (hop / 3) + dir];
+          const real_t *psi;
+          const real_t *U_ptr;
+
+          if (forward) {
+            U_ptr = link[d] + (oddBit * Vh + i) * gauge_site_size;
+          } else if (j >= 0) {
+            U_ptr = link[d] + ((1 - oddBit) * Vh + j) * gauge_site_size;
+          } else {
+            // the link ghost zone has depth hop rather than nFace
+            const int offset = -j - 1 - (nFace - hop) * (faceVolume[d] / 2);
+            U_ptr = ghost_link[d] + ((oddBit ? 0 : hop * (faceVolume[d] / 2)) + offset) * gauge_site_size;
+          }
+
+          if (j >= 0) {
+            psi = spinorField + j * stag_spinor_site_size;
+          } else {
+            psi = (forward ? fwd_nbr_spinor[d] : back_nbr_spinor[d]) + (-j - 1) * stag_spinor_site_size;
+          }
+
+          for (int c = 0; c < 3; c++) {
+            v[c][0][w] = psi[c * 2 + 0];
+            v[c][1][w] = psi[c * 2 + 1];
+          }
+          for (int r = 0; r < 3; r++)
+            for (int c = 0; c < 3; c++) {
+              U[r][c][0][w] = U_ptr[r * 6 + c * 2 + 0];
+              U[r][c][1][w] = U_ptr[r * 6 + c * 2 + 1];
+            }
+        }
+
+        if (forward)
+          su3MulBlock<true>(acc, U, v, real_t(1.0));
+        else
+          su3MulBlock<false>(acc, U, v, hop == 1 ? back_sign : real_t(-1.0));
+      }
+    }
+
+    for (int w = 0; w < n; w++) {
+      const size_t offset = (i0 + w) * stag_spinor_site_size;
+      for (int c = 0; c < 3; c++) {
+        for (int z = 0; z < 2; z++) {
+          real_t value = dagger_sign * acc[c][z][w];
+          if (x) value += a * x[offset + 2 * c + z];
+          res[offset + 2 * c + z] = value;
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief Apply the even-odd or odd-even component of a staggered-type dslash with either the fast or the
+ *        original reference implementation.  If x is set, the fast implementation instead applies
+ *        out = a * x + D in, with D negated if daggerBit is set.
+ */
+static void stagDslash(ColorSpinorField &out, const GaugeField &fat_link, const GaugeField &long_link,
+                       const ColorSpinorField &in, int oddBit, int daggerBit, QudaDslashType dslash_type, bool naive,
+                       const ColorSpinorField *x = nullptr, double a = 0.0)
 {
   // assert sPrecision and gPrecision must be the same
   if (in.Precision() != fat_link.Precision()) {
@@ -156,21 +379,51 @@ void stag_dslash(ColorSpinorField &out, const GaugeField &fat_link, const GaugeF
   void *ghost_longlink[] = {long_link.Ghost()[0].data(), long_link.Ghost()[1].data(), long_link.Ghost()[2].data(),
                             long_link.Ghost()[3].data()};
 
-  if (in.Precision() == QUDA_DOUBLE_PRECISION) {
-    staggeredDslashReference(static_cast<double *>(out.data()), reinterpret_cast<double **>(qdp_fatlink),
-                             reinterpret_cast<double **>(qdp_longlink), reinterpret_cast<double **>(ghost_fatlink),
-                             reinterpret_cast<double **>(ghost_longlink), static_cast<double *>(in.data()),
-                             reinterpret_cast<double **>(in.fwdGhostFaceBuffer),
-                             reinterpret_cast<double **>(in.backGhostFaceBuffer), oddBit, daggerBit, dslash_type);
-  } else if (in.Precision() == QUDA_SINGLE_PRECISION) {
-    staggeredDslashReference(static_cast<float *>(out.data()), reinterpret_cast<float **>(qdp_fatlink),
-                             reinterpret_cast<float **>(qdp_longlink), reinterpret_cast<float **>(ghost_fatlink),
-                             reinterpret_cast<float **>(ghost_longlink), static_cast<float *>(in.data()),
-                             reinterpret_cast<float **>(in.fwdGhostFaceBuffer),
-                             reinterpret_cast<float **>(in.backGhostFaceBuffer), oddBit, daggerBit, dslash_type);
+  if (naive) {
+    if (in.Precision() == QUDA_DOUBLE_PRECISION) {
+      staggeredDslashReference(static_cast<double *>(out.data()), reinterpret_cast<double **>(qdp_fatlink),
+                               reinterpret_cast<double **>(qdp_longlink), reinterpret_cast<double **>(ghost_fatlink),
+                               reinterpret_cast<double **>(ghost_longlink), static_cast<double *>(in.data()),
+                               reinterpret_cast<double **>(in.fwdGhostFaceBuffer),
+                               reinterpret_cast<double **>(in.backGhostFaceBuffer), oddBit, daggerBit, dslash_type);
+    } else if (in.Precision() == QUDA_SINGLE_PRECISION) {
+      staggeredDslashReference(static_cast<float *>(out.data()), reinterpret_cast<float **>(qdp_fatlink),
+                               reinterpret_cast<float **>(qdp_longlink), reinterpret_cast<float **>(ghost_fatlink),
+                               reinterpret_cast<float **>(ghost_longlink), static_cast<float *>(in.data()),
+                               reinterpret_cast<float **>(in.fwdGhostFaceBuffer),
+                               reinterpret_cast<float **>(in.backGhostFaceBuffer), oddBit, daggerBit, dslash_type);
+    }
+  } else {
+    if (in.Precision() == QUDA_DOUBLE_PRECISION) {
+      staggeredDslashFast(static_cast<double *>(out.data()), reinterpret_cast<double **>(qdp_fatlink),
+                          reinterpret_cast<double **>(qdp_longlink), reinterpret_cast<double **>(ghost_fatlink),
+                          reinterpret_cast<double **>(ghost_longlink), static_cast<const double *>(in.data()),
+                          reinterpret_cast<double **>(in.fwdGhostFaceBuffer),
+                          reinterpret_cast<double **>(in.backGhostFaceBuffer), oddBit, daggerBit, dslash_type,
+                          x ? static_cast<const double *>(x->data()) : nullptr, a);
+    } else if (in.Precision() == QUDA_SINGLE_PRECISION) {
+      staggeredDslashFast(static_cast<float *>(out.data()), reinterpret_cast<float **>(qdp_fatlink),
+                          reinterpret_cast<float **>(qdp_longlink), reinterpret_cast<float **>(ghost_fatlink),
+                          reinterpret_cast<float **>(ghost_longlink), static_cast<const float *>(in.data()),
+                          reinterpret_cast<float **>(in.fwdGhostFaceBuffer),
+                          reinterpret_cast<float **>(in.backGhostFaceBuffer), oddBit, daggerBit, dslash_type,
+                          x ? static_cast<const float *>(x->data()) : nullptr, static_cast<float>(a));
+    }
   }
 }
 
+void stag_dslash(ColorSpinorField &out, const GaugeField &fat_link, const GaugeField &long_link,
+                 const ColorSpinorField &in, int oddBit, int daggerBit, QudaDslashType dslash_type)
+{
+  stagDslash(out, fat_link, long_link, in, oddBit, daggerBit, dslash_type, false);
+}
+
+void stag_dslash_naive(ColorSpinorField &out, const GaugeField &fat_link, const GaugeField &long_link,
+                       const ColorSpinorField &in, int oddBit, int daggerBit, QudaDslashType dslash_type)
+{
+  stagDslash(out, fat_link, long_link, in, oddBit, daggerBit, dslash_type, true);
+}
+
 void stag_mat(ColorSpinorField &out, const GaugeField &fat_link, const GaugeField &long_link,
               const ColorSpinorField &in, double mass, int daggerBit, QudaDslashType dslash_type)
 {
@@ -238,13 +491,41 @@ void stag_matpc(ColorSpinorField &out, const GaugeField &fat_link, const GaugeFi
     errorQuda("full parity not supported in function");
   }
 
+  // The intermediate spinor must be halo exchanged before the second dslash, so it is kept, but the second dslash
+  // is fused with the axmy: out = 4 m^2 in - D tmp, where the dagger bit gives the minus sign
+  quda::ColorSpinorParam csParam(in);
+  quda::ColorSpinorField tmp(csParam);
+
+  stagDslash(tmp, fat_link, long_link, in, otherparity, 0, dslash_type, false);
+  stagDslash(out, fat_link, long_link, tmp, parity, 1, dslash_type, false, &in, mass * mass * 4);
+}
+
+void stag_matpc_naive(ColorSpinorField &out, const GaugeField &fat_link, const GaugeField &long_link,
+                const ColorSpinorField &in, double mass, int, QudaParity parity, QudaDslashType dslash_type)
+{
+  // assert sPrecision and gPrecision must be the same
+  if (in.Precision() != fat_link.Precision()) { errorQuda("The spinor precision and gauge precison are not the same"); }
+
+  // assert we have single-parity spinors
+  if (out.SiteSubset() != QUDA_PARITY_SITE_SUBSET || in.SiteSubset() != QUDA_PARITY_SITE_SUBSET)
+    errorQuda("Unexpected site subsets for stag_matpc, out %d in %d", out.SiteSubset(), in.SiteSubset());
+
+  QudaParity otherparity = QUDA_INVALID_PARITY;
+  if (parity == QUDA_EVEN_PARITY) {
+    otherparity = QUDA_ODD_PARITY;
+  } else if (parity == QUDA_ODD_PARITY) {
+    otherparity = QUDA_EVEN_PARITY;
+  } else {
+    errorQuda("full parity not supported in function");
+  }
+
   // Create temporary spinors
   quda::ColorSpinorParam csParam(in);
   quda::ColorSpinorField tmp(csParam);
 
   // dagger bit does not matter
-  stag_dslash(tmp, fat_link, long_link, in, otherparity, 0, dslash_type);
-  stag_dslash(out, fat_link, long_link, tmp, parity, 0, dslash_type);
+  stag_dslash_naive(tmp, fat_link, long_link, in, otherparity, 0, dslash_type);
+  stag_dslash_naive(out, fat_link, long_link, tmp, parity, 0, dslash_type);
 
   double msq_x4 = mass * mass * 4;
   if (in.Precision() == QUDA_DOUBLE_PRECISION) {
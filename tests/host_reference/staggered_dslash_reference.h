@@ -46,6 +46,15 @@ void staggeredDslashReference(real_t *res, real_t **fatlink, real_t **longlink,
 void stag_dslash(ColorSpinorField &out, const GaugeField &fat_link, const GaugeField &long_link,
                  const ColorSpinorField &in, int oddBit, int daggerBit, QudaDslashType dslash_type);
 
+/**
+ * @brief Apply even-odd or odd-even component of a staggered-type dslash using the original site-by-site
+ *        implementation, retained to validate the fast implementation used by stag_dslash
+ *
+ * The parameters are as per stag_dslash
+ */
+void stag_dslash_naive(ColorSpinorField &out, const GaugeField &fat_link, const GaugeField &long_link,
+                       const ColorSpinorField &in, int oddBit, int daggerBit, QudaDslashType dslash_type);
+
 /**
  * @brief Apply the full parity staggered-type dslash
  *
@@ -75,7 +84,8 @@ void stag_matdag_mat(ColorSpinorField &out, const GaugeField &fat_link, const Ga
                      const ColorSpinorField &in, double mass, int daggerBit, QudaDslashType dslash_type);
 
 /**
- * @brief Apply the even-even or odd-odd preconditioned staggered dslash
+ * @brief Apply the even-even or odd-odd preconditioned staggered dslash, with the second dslash fused
+ *        with the mass term
  *
  * @param out Host output rhs
  * @param fat_link Fat links for an asqtad dslash, or the gauge links for a staggered or Laplace dslash
@@ -88,3 +98,13 @@ void stag_matdag_mat(ColorSpinorField &out, const GaugeField &fat_link, const Ga
  */
 void stag_matpc(ColorSpinorField &out, const GaugeField &fat_link, const GaugeField &long_link,
                 const ColorSpinorField &in, double mass, int dagger_bit, QudaParity parity, QudaDslashType dslash_type);
+
+/**
+ * @brief Apply the even-even or odd-odd preconditioned staggered dslash using the original implementation,
+ *        retained to validate stag_matpc
+ *
+ * The parameters are as per stag_matpc
+ */
+void stag_matpc_naive(ColorSpinorField &out, const GaugeField &fat_link, const GaugeField &long_link,
+                      const ColorSpinorField &in, double mass, int dagger_bit, QudaParity parity,
+                      QudaDslashType dslash_type);
@@ -1,6 +1,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
+#include <algorithm>
+#include <array>
+#include <vector>
 
 #include <util_quda.h>
 
@@ -124,19 +127,281 @@ void dslashReference(sFloat *res, gFloat **gaugeFull, gFloat **ghostGauge, sFloa
 
 #endif
 
+
+//
+// Fast host Wilson dslash
+//
+// The neighbor spinor in each direction is spin projected to a
+// two-component half spinor, only the two half-spinor components are
+// multiplied by the link, and the lower two components of the result
+// are reconstructed from the upper two.  Sites are processed in blocks
+// of wilson_block_size, with the gathered half spinors, links and
+// accumulators of a block stored in structure-of-arrays order so that
+// the innermost loops over the sites of the block vectorize.  The
+// neighbor indices are precomputed once per parity and lattice
+// geometry.
+//
+
+namespace
+{
+
+  /**
+     Half-spinor form of the projector with index p, derived from the
+     projector table: the upper components of the projected spinor are
+     h_k = psi_k + proj[k] * psi_{col[k]} for k = 0, 1, and its lower
+     components are recon[s] * h_{row[s]} for s = 2, 3.
+   */
+  struct HalfProjector {
+    int col[2];
+    double proj[2][2];
+    int row[2];
+    double recon[2][2];
+  };
+
+  const std::array<HalfProjector, 8> &halfProjectors()
+  {
+    static const std::array<HalfProjector, 8> half_projector = [] {
+      std::array<HalfProjector, 8> hp = {};
+      for (int p = 0; p < 8; p++) {
+        for (int k = 0; k < 2; k++) {
+          for (int t = 2; t < 4; t++) {
+            if (projector[p][k][t][0] != 0.0 || projector[p][k][t][1] != 0.0) {
+              hp[p].col[k] = t;
+              hp[p].proj[k][0] = projector[p][k][t][0];
+              hp[p].proj[k][1] = projector[p][k][t][1];
+            }
+          }
+        }
+        for (int s = 0; s < 2; s++) {
+          for (int m = 0; m < 2; m++) {
+            if (projector[p][s + 2][m][0] != 0.0 || projector[p][s + 2][m][1] != 0.0) {
+              hp[p].row[s] = m;
+              hp[p].recon[s][0] = projector[p][s + 2][m][0];
+              hp[p].recon[s][1] = projector[p][s + 2][m][1];
+            }
+          }
+        }
+      }
+      return hp;
+    }();
+    return half_projector;
+  }
+
+  /**
+     Nearest-neighbor table for the sites of one parity, with entry
+     8 * i + dir holding the checkerboard index of the neighbor of site
+     i in direction dir (ordered +x, -x, +y, ..., -t) in the opposite
+     parity.  Neighbors that lie in a ghost zone are encoded as
+     -(face index + 1).  The table is rebuilt only when the lattice
+     dimensions or partitioning change.
+   */
+  struct WilsonNeighborTable {
+    int dims[4] = {};
+    int partitioned[4] = {};
+    std::vector<int> index;
+
+    bool matches(const int partitioned_[4]) const
+    {
+      if (index.size() != 8 * static_cast<size_t>(Vh)) return false;
+      for (int d = 0; d < 4; d++)
+        if (dims[d] != Z[d] || partitioned[d] != partitioned_[d]) return false;
+      return true;
+    }
+  };
+
+  const std::vector<int> &wilsonNeighbors(int oddBit)
+  {
+    static WilsonNeighborTable table[2];
+
+    int partitioned[4] = {};
+#ifdef MULTI_GPU
+    for (int d = 0; d < 4; d++) partitioned[d] = quda::comm_dim_partitioned(d);
+#endif
+
+    WilsonNeighborTable &t = table[oddBit];
+    if (t.matches(partitioned)) return t.index;
+
+    for (int d = 0; d < 4; d++) {
+      t.dims[d] = Z[d];
+      t.partitioned[d] = partitioned[d];
+    }
+    t.index.resize(8 * static_cast<size_t>(Vh));
+
+#pragma omp parallel for
+    for (int i = 0; i < Vh; i++) {
+      int Y = fullLatticeIndex(i, oddBit);
+      int x[4] = {Y % Z[0], (Y / Z[0]) % Z[1], (Y / (Z[1] * Z[0])) % Z[2], Y / (Z[2] * Z[1] * Z[0])};
+
+      for (int dir = 0; dir < 8; dir++) {
+        int d = dir / 2;
+        int y[4] = {x[0], x[1], x[2], x[3]};
+        y[d] += (dir % 2 == 0) ? 1 : -1;
+
+        if ((y[d] < 0 || y[d] >= Z[d]) && partitioned[d]) {
+          // index of the site within the face orthogonal to d, as used by the ghost zones
+          int face = 0;
+          for (int e = 3; e >= 0; e--)
+            if (e != d) face = face * Z[e] + x[e];
+          t.index[8 * i + dir] = -(face / 2 + 1);
+        } else {
+          y[d] = (y[d] + Z[d]) % Z[d];
+          t.index[8 * i + dir] = (((y[3] * Z[2] + y[2]) * Z[1] + y[1]) * Z[0] + y[0]) / 2;
+        }
+      }
+    }
+
+    return t.index;
+  }
+
+  /** number of sites processed together by the fast dslash */
+  constexpr int wilson_block_size = 8;
+
+} // namespace
+
+template <typename sFloat, typename gFloat>
+void dslashReferenceFast(sFloat *res, gFloat **gaugeFull, gFloat **ghostGauge, const sFloat *spinorField,
+                         sFloat **fwdSpinor, sFloat **backSpinor, int oddBit, int daggerBit)
+{
+  constexpr int W = wilson_block_size;
+  const std::vector<int> &nbr = wilsonNeighbors(oddBit);
+  const auto &half_projector = halfProjectors();
+  const int n_block = (Vh + W - 1) / W;
+
+#pragma omp parallel for schedule(static)
+  for (int b = 0; b < n_block; b++) {
+    const int i0 = b * W;
+    const int n = std::min(W, Vh - i0);
+
+    // lanes beyond the end of the lattice duplicate the last site and are not stored
+    int site[W];
+    for (int w = 0; w < W; w++) site[w] = i0 + std::min(w, n - 1);
+
+    alignas(64) sFloat acc[4][3][2][W] = {};
+    alignas(64) sFloat h[2][3][2][W];
+    alignas(64) sFloat g[2][3][2][W];
+    alignas(64) gFloat U[3][3][2][W];
+
+    for (int dir = 0; dir < 8; dir++) {
+      const int d = dir / 2;
+      const bool forward = (dir % 2 == 0);
+      const HalfProjector &hp = half_projector[2 * d + (dir + daggerBit) % 2];
+
+      // gather and spin project the neighbors, and gather the links
+      for (int w = 0; w < W; w++) {
+        const int i = site[w];
+        const int j = nbr[8 * i + dir];
+        const sFloat *psi;
+        const gFloat *link;
+
+        if (j >= 0) {
+          psi = spinorField + j * spinor_site_size;
+          link = forward ? gaugeFull[d] + (oddBit * Vh + i) * gauge_site_size :
+                           gaugeFull[d] + ((1 - oddBit) * Vh + j) * gauge_site_size;
+        } else {
+          const int face = -j - 1;
+          psi = (forward ? fwdSpinor[d] : backSpinor[d]) + face * spinor_site_size;
+          link = forward ? gaugeFull[d] + (oddBit * Vh + i) * gauge_site_size :
+                           ghostGauge[d] + ((oddBit ? 0 : faceVolume[d] / 2) + face) * gauge_site_size;
+        }
+
+        for (int k = 0; k < 2; k++) {
+          const sFloat a_re = hp.proj[k][0];
+          const sFloat a_im = hp.proj[k][1];
+          for (int c = 0; c < 3; c++) {
+            const sFloat x_re = psi[hp.col[k] * 6 + c * 2 + 0];
+            const sFloat x_im = psi[hp.col[k] * 6 + c * 2 + 1];
+            h[k][c][0][w] = psi[k * 6 + c * 2 + 0] + a_re * x_re - a_im * x_im;
+            h[k][c][1][w] = psi[k * 6 + c * 2 + 1] + a_re * x_im + a_im * x_re;
+          }
+        }
+
+        for (int r = 0; r < 3; r++)
+          for (int c = 0; c < 3; c++) {
+            U[r][c][0][w] = link[r * 6 + c * 2 + 0];
+            U[r][c][1][w] = link[r * 6 + c * 2 + 1];
+          }
+      }
+
+      // multiply the half spinors by the link (forward) or its conjugate transpose (backward)
+      if (forward) {
+        for (int k = 0; k < 2; k++)
+          for (int r = 0; r < 3; r++) {
+#pragma omp simd
+            for (int w = 0; w < W; w++) {
+              sFloat re = 0, im = 0;
+              for (int c = 0; c < 3; c++) {
+                re += U[r][c][0][w] * h[k][c][0][w] - U[r][c][1][w] * h[k][c][1][w];
+                im += U[r][c][0][w] * h[k][c][1][w] + U[r][c][1][w] * h[k][c][0][w];
+              }
+              g[k][r][0][w] = re;
+              g[k][r][1][w] = im;
+            }
+          }
+      } else {
+        for (int k = 0; k < 2; k++)
+          for (int r = 0; r < 3; r++) {
+#pragma omp simd
+            for (int w = 0; w < W; w++) {
+              sFloat re = 0, im = 0;
+              for (int c = 0; c < 3; c++) {
+                re += U[c][r][0][w] * h[k][c][0][w] + U[c][r][1][w] * h[k][c][1][w];
+                im += U[c][r][0][w] * h[k][c][1][w] - U[c][r][1][w] * h[k][c][0][w];
+              }
+              g[k][r][0][w] = re;
+              g[k][r][1][w] = im;
+            }
+          }
+      }
+
+      // accumulate the upper components and reconstruct the lower ones
+      for (int s = 0; s < 4; s++) {
+        const int k = s < 2 ? s : hp.row[s - 2];
+        const sFloat a_re = s < 2 ? 1.0 : hp.recon[s - 2][0];
+        const sFloat a_im = s < 2 ? 0.0 : hp.recon[s - 2][1];
+        for (int c = 0; c < 3; c++) {
+#pragma omp simd
+          for (int w = 0; w < W; w++) {
+            acc[s][c][0][w] += a_re * g[k][c][0][w] - a_im * g[k][c][1][w];
+            acc[s][c][1][w] += a_re * g[k][c][1][w] + a_im * g[k][c][0][w];
+          }
+        }
+      }
+    }
+
+    for (int w = 0; w < n; w++) {
+      sFloat *out = res + (i0 + w) * spinor_site_size;
+      for (int s = 0; s < 4; s++)
+        for (int c = 0; c < 3; c++) {
+          out[s * 6 + c * 2 + 0] = acc[s][c][0][w];
+          out[s * 6 + c * 2 + 1] = acc[s][c][1][w];
+        }
+    }
+  }
+}
+
 #ifndef MULTI_GPU
 // this actually applies the preconditioned dslash, e.g., D_ee^{-1} D_eo or D_oo^{-1} D_oe
-void wil_dslash(void *out, void **gauge, void *in, int oddBit, int daggerBit, QudaPrecision precision, QudaGaugeParam &)
+static void wilsonDslash(void *out, void **gauge, void *in, int oddBit, int daggerBit, QudaPrecision precision,
+                         QudaGaugeParam &, bool naive)
 #else
-void wil_dslash(void *out, void **gauge, void *in, int oddBit, int daggerBit, QudaPrecision precision,
-                QudaGaugeParam &gauge_param)
+static void wilsonDslash(void *out, void **gauge, void *in, int oddBit, int daggerBit, QudaPrecision precision,
+                         QudaGaugeParam &gauge_param, bool naive)
 #endif
 {
 #ifndef MULTI_GPU
-  if (precision == QUDA_DOUBLE_PRECISION)
-    dslashReference((double *)out, (double **)gauge, (double *)in, oddBit, daggerBit);
-  else
-    dslashReference((float *)out, (float **)gauge, (float *)in, oddBit, daggerBit);
+  if (naive) {
+    if (precision == QUDA_DOUBLE_PRECISION)
+      dslashReference((double *)out, (double **)gauge, (double *)in, oddBit, daggerBit);
+    else
+      dslashReference((float *)out, (float **)gauge, (float *)in, oddBit, daggerBit);
+  } else {
+    if (precision == QUDA_DOUBLE_PRECISION)
+      dslashReferenceFast((double *)out, (double **)gauge, (double **)nullptr, (double *)in, (double **)nullptr,
+                          (double **)nullptr, oddBit, daggerBit);
+    else
+      dslashReferenceFast((float *)out, (float **)gauge, (float **)nullptr, (float *)in, (float **)nullptr,
+                          (float **)nullptr, oddBit, daggerBit);
+  }
 #else
 
   GaugeFieldParam gauge_field_param(gauge_param, gauge);
@@ -181,17 +446,39 @@ void wil_dslash(void *out, void **gauge, void *in, int oddBit, int daggerBit, Qu
   void **fwd_nbr_spinor = inField.fwdGhostFaceBuffer;
   void **back_nbr_spinor = inField.backGhostFaceBuffer;
 
-  if (precision == QUDA_DOUBLE_PRECISION) {
-    dslashReference((double *)out, (double **)gauge, (double **)ghostGauge, (double *)in, (double **)fwd_nbr_spinor,
-                    (double **)back_nbr_spinor, oddBit, daggerBit);
+  if (naive) {
+    if (precision == QUDA_DOUBLE_PRECISION) {
+      dslashReference((double *)out, (double **)gauge, (double **)ghostGauge, (double *)in, (double **)fwd_nbr_spinor,
+                      (double **)back_nbr_spinor, oddBit, daggerBit);
+    } else {
+      dslashReference((float *)out, (float **)gauge, (float **)ghostGauge, (float *)in, (float **)fwd_nbr_spinor,
+                      (float **)back_nbr_spinor, oddBit, daggerBit);
+    }
   } else {
-    dslashReference((float *)out, (float **)gauge, (float **)ghostGauge, (float *)in, (float **)fwd_nbr_spinor,
-                    (float **)back_nbr_spinor, oddBit, daggerBit);
+    if (precision == QUDA_DOUBLE_PRECISION) {
+      dslashReferenceFast((double *)out, (double **)gauge, (double **)ghostGauge, (double *)in,
+                          (double **)fwd_nbr_spinor, (double **)back_nbr_spinor, oddBit, daggerBit);
+    } else {
+      dslashReferenceFast((float *)out, (float **)gauge, (float **)ghostGauge, (float *)in, (float **)fwd_nbr_spinor,
+                          (float **)back_nbr_spinor, oddBit, daggerBit);
+    }
   }
 
 #endif
 }
 
+void wil_dslash(void *out, void **gauge, void *in, int oddBit, int daggerBit, QudaPrecision precision,
+                QudaGaugeParam &gauge_param)
+{
+  wilsonDslash(out, gauge, in, oddBit, daggerBit, precision, gauge_param, false);
+}
+
+void wil_dslash_naive(void *out, void **gauge, void *in, int oddBit, int daggerBit, QudaPrecision precision,
+                      QudaGaugeParam &gauge_param)
+{
+  wilsonDslash(out, gauge, in, oddBit, daggerBit, precision, gauge_param, true);
+}
+
 // applies b*(1 + i*a*gamma_5)
 template <typename sFloat>
 void twistGamma5(sFloat *out, sFloat *in, const int dagger, const sFloat kappa, const sFloat mu,
@@ -8,9 +8,14 @@
 extern "C" {
 #endif
 
+// wil_dslash uses the fast half-spinor implementation, while wil_dslash_naive uses the original
+// site-by-site implementation, which is retained to validate it
 void wil_dslash(void *res, void **gauge, void *spinorField, int oddBit, int daggerBit, QudaPrecision precision,
                 QudaGaugeParam &param);
 
+void wil_dslash_naive(void *res, void **gauge, void *spinorField, int oddBit, int daggerBit, QudaPrecision precision,
+                      QudaGaugeParam &param);
+
 void wil_mat(void *out, void **gauge, void *in, double kappa, int daggerBit, QudaPrecision precision,
              QudaGaugeParam &param);
 
@@ -54,6 +54,8 @@ bool skip_test(test_t param)
   if ((inverter_type == QUDA_CG3_INVERTER || inverter_type == QUDA_CG3NE_INVERTER || inverter_type == QUDA_CG3NR_INVERTER)
       && prec_sloppy < QUDA_DOUBLE_PRECISION)
     return true;
+  // pipelined CG has additional recurrences that lose accuracy in low precision
+  if (inverter_type == QUDA_PIPE_CG_INVERTER && prec_sloppy < QUDA_SINGLE_PRECISION) return true;
   // split-grid doesn't support multishift at present
   if (use_split_grid && multishift > 1) return true;
 
@@ -86,6 +88,38 @@ TEST_P(InvertTest, verify)
   }
 }
 
+// Pipelined CG rearranges the recurrences of CG, so on the same system it must reach the tolerance in about the
+// same number of iterations.  This runs on every rank the test is launched with, so it also checks that the
+// non-blocking reductions of the pipelined solver are complete and consistent across ranks.
+TEST(PipeCGTest, compare_cg)
+{
+  test_t param {QUDA_CG_INVERTER,
+                QUDA_MATPCDAG_MATPC_SOLUTION,
+                QUDA_NORMOP_PC_SOLVE,
+                prec,
+                1,
+                1,
+                schwarz_t {QUDA_INVALID_SCHWARZ, QUDA_INVALID_INVERTER, QUDA_INVALID_PRECISION},
+                QUDA_L2_RELATIVE_RESIDUAL};
+  if (skip_test(param) || prec < QUDA_SINGLE_PRECISION || inv_multigrid || inv_deflate) GTEST_SKIP();
+
+  inv_param.tol = tol;
+  inv_param.tol_hq = 0.0;
+
+  auto res_cg = solve(param);
+  const int iter_cg = inv_param.iter;
+
+  ::testing::get<0>(param) = QUDA_PIPE_CG_INVERTER;
+  auto res_pipe = solve(param);
+  const int iter_pipe = inv_param.iter;
+
+  printfQuda("CG: %d iterations, PipeCG: %d iterations on %d ranks\n", iter_cg, iter_pipe,
+             static_cast<int>(quda::comm_size()));
+  for (auto rsd : res_cg) EXPECT_LE(rsd[0], tol);
+  for (auto rsd : res_pipe) EXPECT_LE(rsd[0], tol);
+  EXPECT_LE(std::abs(iter_pipe - iter_cg), 0.1 * iter_cg + 5);
+}
+
 std::string gettestname(::testing::TestParamInfo<test_t> param)
 {
   std::string name;
@@ -111,8 +145,8 @@ std::string gettestname(::testing::TestParamInfo<test_t> param)
 
 using ::testing::Combine;
 using ::testing::Values;
-auto normal_solvers
-  = Values(QUDA_CG_INVERTER, QUDA_CA_CG_INVERTER, QUDA_CG3_INVERTER, QUDA_PCG_INVERTER, QUDA_SD_INVERTER);
+auto normal_solvers = Values(QUDA_CG_INVERTER, QUDA_CA_CG_INVERTER, QUDA_CG3_INVERTER, QUDA_PCG_INVERTER,
+                             QUDA_SD_INVERTER, QUDA_PIPE_CG_INVERTER);
 
 auto direct_solvers = Values(QUDA_CGNE_INVERTER, QUDA_CGNR_INVERTER, QUDA_CA_CGNE_INVERTER, QUDA_CA_CGNR_INVERTER,
                              QUDA_CG3NE_INVERTER, QUDA_CG3NR_INVERTER, QUDA_GCR_INVERTER, QUDA_CA_GCR_INVERTER,
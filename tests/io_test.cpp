@@ -1,5 +1,7 @@
 #include <cstdio>
+#include <cstdlib>
 #include <limits>
+#include <string>
 
 #include <instantiate.h>
 #include <color_spinor_field.h>
@@ -167,6 +169,94 @@ TEST_P(ColorSpinorIOTest, verify)
   }
 }
 
+using chunk_test_t = ::testing::tuple<QudaSiteSubset, bool, QudaFieldLocation, bool>;
+
+class ChunkedIOTest : public ::testing::TestWithParam<chunk_test_t>
+{
+protected:
+  QudaSiteSubset site_subset;
+  bool inflate;
+  QudaFieldLocation location;
+  bool chunked_write;
+  std::string chunk_env; /** value of QUDA_VECTOR_IO_CHUNK before the test */
+  bool chunk_env_set;
+
+  /**
+     @brief Set QUDA_VECTOR_IO_CHUNK, which is read when a VectorIO is constructed
+     @param[in] chunk Number of vectors per record, or zero to unset
+  */
+  void set_chunk(int chunk)
+  {
+    if (chunk > 0)
+      setenv("QUDA_VECTOR_IO_CHUNK", std::to_string(chunk).c_str(), 1);
+    else
+      unsetenv("QUDA_VECTOR_IO_CHUNK");
+  }
+
+public:
+  ChunkedIOTest() :
+    site_subset(::testing::get<0>(GetParam())),
+    inflate(::testing::get<1>(GetParam())),
+    location(::testing::get<2>(GetParam())),
+    chunked_write(::testing::get<3>(GetParam()))
+  {
+    char *env = getenv("QUDA_VECTOR_IO_CHUNK");
+    chunk_env_set = env != nullptr;
+    if (env) chunk_env = env;
+  }
+
+  ~ChunkedIOTest()
+  {
+    if (chunk_env_set)
+      setenv("QUDA_VECTOR_IO_CHUNK", chunk_env.c_str(), 1);
+    else
+      unsetenv("QUDA_VECTOR_IO_CHUNK");
+  }
+};
+
+// test that vectors saved either as a single record or in chunks are read back identically by the chunked loader,
+// with a chunk size that does not divide the number of vectors
+TEST_P(ChunkedIOTest, verify)
+{
+  using namespace quda;
+  if (!is_enabled(QUDA_SINGLE_PRECISION) || !is_enabled_spin(4)) GTEST_SKIP();
+  if (site_subset == QUDA_FULL_SITE_SUBSET && inflate) GTEST_SKIP(); // inflation only applies to parity fields
+
+  QudaGaugeParam gauge_param = newQudaGaugeParam();
+  QudaInvertParam inv_param = newQudaInvertParam();
+  ColorSpinorParam param;
+  setWilsonGaugeParam(gauge_param);
+  setInvertParam(inv_param);
+  constructWilsonTestSpinorParam(&param, &inv_param, &gauge_param);
+  param.siteSubset = site_subset;
+  param.suggested_parity = QUDA_EVEN_PARITY;
+  param.setPrecision(QUDA_SINGLE_PRECISION, QUDA_SINGLE_PRECISION, true);
+  param.location = location;
+  if (location == QUDA_CPU_FIELD_LOCATION) param.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+  param.create = QUDA_NULL_FIELD_CREATE;
+
+  constexpr int n_vector = 5;
+  constexpr int chunk = 2;
+  std::vector<ColorSpinorField> v(n_vector, param);
+  std::vector<ColorSpinorField> u(n_vector, param);
+
+  RNG rng(v[0], 1234);
+  for (auto &vi : v) spinorNoise(vi, rng, QUDA_NOISE_GAUSS);
+  for (auto &ui : u) blas::zero(ui);
+
+  auto file = "dummy_chunked.cs";
+
+  set_chunk(chunked_write ? chunk : 0);
+  VectorIO(file, inflate).save({v.begin(), v.end()});
+
+  set_chunk(chunk);
+  VectorIO(file, inflate).load(u);
+
+  for (auto i = 0u; i < v.size(); i++) EXPECT_EQ(blas::max_deviation(u[i], v[i])[0], 0.0);
+
+  if (::quda::comm_rank() == 0 && remove(file) != 0) errorQuda("Error deleting file");
+}
+
 int main(int argc, char **argv)
 {
   quda_test test("IO Test", argc, argv);
@@ -215,3 +305,16 @@ INSTANTIATE_TEST_SUITE_P(Parity, ColorSpinorIOTest,
                            name += ::testing::get<6>(param.param) == QUDA_CUDA_FIELD_LOCATION ? "_device" : "_host";
                            return name;
                          });
+
+// chunked colorspinor IO test, reading both chunked and single-record files
+INSTANTIATE_TEST_SUITE_P(Chunked, ChunkedIOTest,
+                         Combine(Values(QUDA_FULL_SITE_SUBSET, QUDA_PARITY_SITE_SUBSET), Values(false, true),
+                                 Values(QUDA_CUDA_FIELD_LOCATION, QUDA_CPU_FIELD_LOCATION), Values(true, false)),
+                         [](testing::TestParamInfo<chunk_test_t> param) {
+                           std::string name;
+                           name += ::testing::get<0>(param.param) == QUDA_FULL_SITE_SUBSET ? "full" : "parity";
+                           if (::testing::get<1>(param.param)) name += std::string("_inflate");
+                           name += ::testing::get<2>(param.param) == QUDA_CUDA_FIELD_LOCATION ? "_device" : "_host";
+                           name += ::testing::get<3>(param.param) ? "_chunked_write" : "_legacy_write";
+                           return name;
+                         });
@@ -0,0 +1,152 @@
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <quda.h>
+#include <malloc_quda.h>
+#include <memory_profile.h>
+#include <size_class_pool.h>
+#include <test.h>
+
+/*
+   Check of the attribution of the memory profile for allocations
+   served by the device and pinned memory pools.  A block allocated at
+   one call site, returned to the pool and then reused by a second
+   call site must be attributed to each site in turn, and to the
+   cached pseudo-site of its type while it is held by the pool, as
+   recorded in the profile written by memory_profile::dump.
+ */
+
+using namespace quda;
+
+static void *device_site_a(size_t bytes) { return pool_device_malloc(bytes); }
+static void *device_site_b(size_t bytes) { return pool_device_malloc(bytes); }
+static void *pinned_site_a(size_t bytes) { return pool_pinned_malloc(bytes); }
+static void *pinned_site_b(size_t bytes) { return pool_pinned_malloc(bytes); }
+
+/**
+   @brief Per-site statistics parsed from the dumped profile
+*/
+struct site_stats {
+  bool found = false;
+  size_t live = 0;
+  size_t peak_live = 0;
+  size_t allocs = 0;
+};
+
+/**
+   @brief Return the value of a numeric field of a site record
+*/
+static size_t field(const std::string &record, const std::string &key)
+{
+  auto pos = record.find("\"" + key + "\":");
+  return pos == std::string::npos ? 0 : std::stoul(record.substr(pos + key.size() + 3));
+}
+
+/**
+   @brief Dump the profile and return the statistics of a site
+   @param[in] type The allocation type
+   @param[in] func The function of the site
+*/
+static site_stats dump_site(const std::string &type, const std::string &func)
+{
+  memory_profile::dump();
+  char *path = getenv("QUDA_RESOURCE_PATH");
+  std::ifstream file(std::string(path ? path : ".") + "/memory_profile_rank" + std::to_string(comm_rank_global())
+                     + ".json");
+
+  // each site is on its own line, ahead of the peaks
+  site_stats stats;
+  std::string record;
+  while (std::getline(file, record) && record.find("\"peaks\"") == std::string::npos) {
+    if (record.find("{\"type\":\"" + type + "\",\"func\":\"" + func + "\"") != 0) continue;
+    stats = {true, field(record, "live"), field(record, "peak_live"), field(record, "allocs")};
+    break;
+  }
+  return stats;
+}
+
+/**
+   @brief Allocate a block from the first site, return it to the pool,
+   reallocate it from the second site, and check the attribution at
+   each step
+   @param[in] type The allocation type
+   @param[in] func_a The function of the first site
+   @param[in] malloc_a The first site
+   @param[in] func_b The function of the second site
+   @param[in] malloc_b The second site
+   @param[in] free The pool free function
+   @param[in] bytes The size of the request
+   @param[in] block_bytes The size of the block the pool serves
+*/
+template <typename M, typename F>
+static void check_attribution(const std::string &type, const std::string &func_a, M malloc_a,
+                              const std::string &func_b, M malloc_b, F free, size_t bytes, size_t block_bytes)
+{
+  void *a = malloc_a(bytes);
+  auto site_a = dump_site(type, func_a);
+  ASSERT_TRUE(site_a.found);
+  EXPECT_EQ(site_a.live, block_bytes);
+  EXPECT_EQ(site_a.allocs, 1ul);
+  auto cached = dump_site(type, "(pool cached)");
+  const size_t cached_live = cached.live;
+
+  free(a);
+  EXPECT_EQ(dump_site(type, func_a).live, 0ul);
+  EXPECT_EQ(dump_site(type, "(pool cached)").live, cached_live + block_bytes);
+
+  // the second site reuses the cached block
+  void *b = malloc_b(bytes);
+  EXPECT_EQ(b, a);
+  site_a = dump_site(type, func_a);
+  EXPECT_EQ(site_a.live, 0ul);
+  EXPECT_EQ(site_a.peak_live, block_bytes);
+  auto site_b = dump_site(type, func_b);
+  ASSERT_TRUE(site_b.found);
+  EXPECT_EQ(site_b.live, block_bytes);
+  EXPECT_EQ(site_b.allocs, 1ul);
+  EXPECT_EQ(dump_site(type, "(pool cached)").live, cached_live);
+
+  free(b);
+  EXPECT_EQ(dump_site(type, func_b).live, 0ul);
+}
+
+TEST(memory_profile, device_pool)
+{
+  char *enable_device_pool = getenv("QUDA_ENABLE_DEVICE_MEMORY_POOL");
+  if (!memory_profile::enabled() || (enable_device_pool && strcmp(enable_device_pool, "0") == 0)) GTEST_SKIP();
+
+  // flush the cache so that no larger cached block is served to the first site
+  pool::flush_device();
+  const size_t bytes = 3 << 20;
+  check_attribution(
+    "Device", "device_site_a", device_site_a, "device_site_b", device_site_b,
+    [](void *ptr) { pool_device_free(ptr); }, bytes, bytes);
+
+  pool::flush_device();
+  EXPECT_EQ(dump_site("Device", "(pool cached)").live, 0ul);
+}
+
+TEST(memory_profile, pinned_pool)
+{
+  if (!memory_profile::enabled() || !use_pinned_pool()) GTEST_SKIP();
+
+  pool::flush_pinned();
+  const size_t bytes = 3 << 20;
+  check_attribution(
+    "Pinned", "pinned_site_a", pinned_site_a, "pinned_site_b", pinned_site_b,
+    [](void *ptr) { pool_pinned_free(ptr); }, bytes, pinned_pool().class_bytes(bytes));
+
+  pool::flush_pinned();
+  EXPECT_EQ(dump_site("Pinned", "(pool cached)").live, 0ul);
+}
+
+int main(int argc, char **argv)
+{
+  // profiling must be enabled before the first tracked allocation
+  setenv("QUDA_ENABLE_MEMORY_PROFILE", "1", 0);
+  quda_test test("memory_profile_test", argc, argv);
+  test.init();
+  return test.execute();
+}
@@ -0,0 +1,184 @@
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+#include <comm_quda.h>
+#include <reproducible_sum.h>
+#include <timer.h>
+#include <test.h>
+
+/*
+   Check and benchmark of the reproducible multi-process reduction.
+   The superaccumulator is checked against exactly known sums, and the
+   deterministic comm_allreduce_sum is checked to be bitwise identical
+   when the partials are assigned to ranks in a different order, and to
+   equal the correctly rounded sum of all the partials.  The
+   non-blocking reductions are checked against the blocking ones.  The
+   latency of the reproducible reduction is reported alongside that of
+   the regular reduction.
+ */
+
+using namespace quda;
+
+static double exact_sum(const std::vector<double> &v)
+{
+  std::vector<int64_t> acc(reproducible::n_limb, 0);
+  for (auto x : v) reproducible::accumulate(acc.data(), x);
+  return reproducible::round(acc.data());
+}
+
+/**
+   @brief Return the partials of each rank, with a wide range of
+   magnitudes so that the floating-point sum depends on the order
+ */
+static std::vector<std::vector<double>> partials(size_t size)
+{
+  std::mt19937 rng(1234); // identical on every rank
+  std::uniform_real_distribution<double> mantissa(-1.0, 1.0);
+  std::uniform_int_distribution<int> exponent(-40, 40);
+  std::vector<std::vector<double>> v(comm_size(), std::vector<double>(size));
+  for (auto &rank : v)
+    for (auto &x : rank) x = std::ldexp(mantissa(rng), exponent(rng));
+  return v;
+}
+
+TEST(reproducible_sum, exact)
+{
+  EXPECT_EQ(exact_sum({1e100, 1.0, -1e100}), 1.0);
+  EXPECT_EQ(exact_sum({-3.5, 1.25}), -2.25);
+  EXPECT_EQ(exact_sum({0x1p-1074, 0x1p-1074}), 0x1p-1073);
+  EXPECT_EQ(exact_sum({1.0, 0x1p-53}), 1.0);                      // tie rounds to even
+  EXPECT_EQ(exact_sum({1.0, 0x1p-53, 0x1p-1074}), 1.0 + 0x1p-52); // above the tie rounds up
+  constexpr double inf = std::numeric_limits<double>::infinity();
+  EXPECT_EQ(exact_sum({1e308, 1e308}), inf);
+  EXPECT_TRUE(std::isnan(exact_sum({inf, -inf})));
+
+  std::mt19937 rng(5678);
+  std::uniform_int_distribution<long long> integer(-1000000, 1000000);
+  for (int i = 0; i < 1000; i++) {
+    std::vector<double> v(10);
+    long long sum = 0;
+    for (auto &x : v) {
+      long long k = integer(rng);
+      sum += k;
+      x = std::ldexp(static_cast<double>(k), -40);
+    }
+    EXPECT_EQ(exact_sum(v), std::ldexp(static_cast<double>(sum), -40));
+  }
+}
+
+/**
+   @brief Fixture that restores the deterministic-reduce mode, which
+   the tests set, on teardown so that later tests see the mode the
+   process was started with
+ */
+template <typename Base> class DeterministicReduceTest : public Base
+{
+  bool deterministic = false;
+
+public:
+  void SetUp() override { deterministic = comm_deterministic_reduce(); }
+  void TearDown() override { comm_set_deterministic_reduce(deterministic); }
+};
+
+class ReproducibleReduceTest : public DeterministicReduceTest<::testing::Test>
+{
+};
+
+TEST_F(ReproducibleReduceTest, rank_order)
+{
+  const size_t size = 64;
+  auto v = partials(size);
+  const int rank = comm_rank();
+  const int n_rank = comm_size();
+
+  comm_set_deterministic_reduce(true);
+
+  std::vector<double> sum = v[rank];
+  comm_allreduce_sum(sum);
+
+  // assign each rank the partials of its neighbour
+  std::vector<double> sum_shifted = v[(rank + 1) % n_rank];
+  comm_allreduce_sum(sum_shifted);
+
+  for (size_t i = 0; i < size; i++) {
+    std::vector<double> column(n_rank);
+    for (int r = 0; r < n_rank; r++) column[r] = v[n_rank - 1 - r][i];
+    EXPECT_EQ(sum[i], sum_shifted[i]);
+    EXPECT_EQ(sum[i], exact_sum(column));
+  }
+}
+
+TEST_F(ReproducibleReduceTest, nonblocking)
+{
+  const size_t size = 64;
+  auto v = partials(size);
+
+  for (int deterministic = 0; deterministic < 2; deterministic++) {
+    comm_set_deterministic_reduce(deterministic);
+
+    std::vector<double> sum = v[comm_rank()];
+    comm_allreduce_sum(sum);
+
+    std::vector<double> isum = v[comm_rank()];
+    ReduceHandle *rh = comm_iallreduce_sum_array(isum.data(), isum.size());
+    comm_iallreduce_wait(rh);
+    EXPECT_EQ(rh, nullptr);
+
+    // the deterministic reduction must match bitwise, the regular one to rounding
+    for (size_t i = 0; i < size; i++) {
+      if (deterministic)
+        EXPECT_EQ(isum[i], sum[i]);
+      else
+        EXPECT_NEAR(isum[i], sum[i], 1e-12 * std::abs(sum[i]));
+    }
+  }
+
+  std::vector<double> max = v[comm_rank()];
+  comm_allreduce_max(max);
+  std::vector<double> imax = v[comm_rank()];
+  ReduceHandle *rh = comm_iallreduce_max_array(imax.data(), imax.size());
+  comm_iallreduce_wait(rh);
+  for (size_t i = 0; i < size; i++) EXPECT_EQ(imax[i], max[i]);
+}
+
+class ReproducibleReduceBenchmark : public DeterministicReduceTest<::testing::TestWithParam<size_t>>
+{
+};
+
+TEST_P(ReproducibleReduceBenchmark, latency)
+{
+  const size_t size = GetParam();
+  auto v = partials(size);
+  const int n_iter = std::max(niter, 1) * 100;
+  host_timer_t timer;
+
+  double time[2];
+  for (int deterministic = 0; deterministic < 2; deterministic++) {
+    comm_set_deterministic_reduce(deterministic);
+    std::vector<double> sum = v[comm_rank()];
+    comm_allreduce_sum(sum); // warm up
+    comm_barrier();
+    timer.start();
+    for (int i = 0; i < n_iter; i++) {
+      sum = v[comm_rank()];
+      comm_allreduce_sum(sum);
+    }
+    timer.stop();
+    time[deterministic] = timer.last() / n_iter;
+  }
+
+  printfQuda("%lu elements on %lu ranks: regular %.3f us, reproducible %.3f us (%.2fx)\n", size, comm_size(),
+             1e6 * time[0], 1e6 * time[1], time[1] / time[0]);
+  RecordProperty("regular_us", std::to_string(1e6 * time[0]));
+  RecordProperty("reproducible_us", std::to_string(1e6 * time[1]));
+}
+
+INSTANTIATE_TEST_SUITE_P(Sizes, ReproducibleReduceBenchmark, ::testing::Values(1, 16, 256));
+
+int main(int argc, char **argv)
+{
+  quda_test test("reproducible_reduce_test", argc, argv);
+  test.init();
+  return test.execute();
+}
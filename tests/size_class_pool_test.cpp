@@ -0,0 +1,200 @@
+#include <cstdlib>
+#include <cstring>
+#include <set>
+#include <size_class_pool.h>
+#include <malloc_quda.h>
+#include <test.h>
+
+/*
+   Check of the size-class pool allocator used for the host and pinned
+   memory pools: requests are rounded up to size classes, with one or
+   several classes per octave, released blocks are reused by requests
+   of the same or the next smaller class, the cache is held within its
+   budget, a failed backing allocation trims the cache and is retried,
+   and trimming returns the largest cached blocks to the backing
+   allocator first.
+ */
+
+using namespace quda;
+
+class SizeClassPoolTest : public ::testing::Test
+{
+protected:
+  std::set<void *> freed;
+  SizeClassPool pool;
+  SizeClassPool fine_pool;
+  const SizeClassPool::alloc_t backing = [](size_t bytes) { return malloc(bytes); };
+
+  SizeClassPool::free_t backing_free()
+  {
+    return [this](void *ptr) {
+      freed.insert(ptr);
+      free(ptr);
+    };
+  }
+
+public:
+  SizeClassPoolTest() : pool("Test", 4096, 1, backing_free()), fine_pool("Fine", 4096, 4, backing_free()) { }
+
+  ~SizeClassPoolTest()
+  {
+    pool.trim();
+    fine_pool.trim();
+  }
+};
+
+TEST_F(SizeClassPoolTest, size_class)
+{
+  EXPECT_EQ(pool.class_bytes(1), 4096ul);
+  EXPECT_EQ(pool.class_bytes(4096), 4096ul);
+  EXPECT_EQ(pool.class_bytes(4097), 8192ul);
+  EXPECT_EQ(pool.class_bytes((1ul << 30) + 1), 1ul << 31);
+
+  // four classes per octave
+  EXPECT_EQ(fine_pool.class_bytes(1), 4096ul);
+  EXPECT_EQ(fine_pool.class_bytes(4097), 5120ul);
+  EXPECT_EQ(fine_pool.class_bytes(6000), 6144ul);
+  EXPECT_EQ(fine_pool.class_bytes(7169), 8192ul);
+  EXPECT_EQ(fine_pool.class_bytes((1ul << 30) + 1), (1ul << 30) + (1ul << 28));
+  EXPECT_EQ(fine_pool.class_bytes(3ul << 29), 3ul << 29);
+  for (size_t bytes = 4096; bytes < (1ul << 24); bytes = bytes * 9 / 8 + 1) {
+    EXPECT_GE(fine_pool.class_bytes(bytes), bytes);
+    EXPECT_LT(fine_pool.class_bytes(bytes), bytes + bytes / 4);
+  }
+}
+
+TEST_F(SizeClassPoolTest, reuse)
+{
+  void *a = pool.allocate(5000, backing);
+  void *b = pool.allocate(6000, backing);
+  EXPECT_NE(a, b);
+  EXPECT_TRUE(pool.release(a));
+  EXPECT_EQ(pool.allocate(8000, backing), a); // same size class
+  EXPECT_TRUE(pool.release(a));
+  EXPECT_TRUE(pool.release(b));
+  EXPECT_FALSE(pool.release(&freed)); // not allocated from the pool
+
+  auto stats = pool.stats();
+  EXPECT_EQ(stats.hits + stats.remote_hits, 1ul);
+  EXPECT_EQ(stats.misses, 2ul);
+  EXPECT_EQ(stats.cached_blocks, 2ul);
+  EXPECT_EQ(stats.cached_bytes, 2 * 8192ul);
+  EXPECT_EQ(stats.active_bytes, 0ul);
+  EXPECT_EQ(stats.total_requested_bytes, 5000ul + 6000ul + 8000ul);
+  EXPECT_TRUE(freed.empty());
+}
+
+TEST_F(SizeClassPoolTest, larger_class)
+{
+  void *a = fine_pool.allocate(6144, backing);
+  fine_pool.release(a);
+
+  // a request of the next smaller class reuses the cached block, which keeps its class
+  EXPECT_EQ(fine_pool.allocate(5000, backing), a);
+  EXPECT_EQ(fine_pool.stats().larger_hits, 1ul);
+  EXPECT_EQ(fine_pool.stats().active_bytes, 6144ul);
+  fine_pool.release(a);
+  EXPECT_EQ(fine_pool.stats().cached_bytes, 6144ul);
+
+  // but a request two classes smaller does not, and a miss leaves the cache untouched
+  void *b = fine_pool.allocate(4096, backing);
+  EXPECT_NE(b, a);
+  EXPECT_EQ(fine_pool.stats().misses, 2ul);
+  EXPECT_EQ(fine_pool.stats().cached_blocks, 1ul);
+  EXPECT_TRUE(freed.empty());
+  fine_pool.release(b);
+}
+
+TEST_F(SizeClassPoolTest, budget)
+{
+  void *small = pool.allocate(4096, backing);
+  void *medium = pool.allocate(65536, backing);
+  void *large = pool.allocate(1 << 20, backing);
+  pool.set_budget(65536 + 4096);
+
+  // releasing beyond the budget trims the largest cached blocks
+  pool.release(small);
+  pool.release(medium);
+  EXPECT_TRUE(freed.empty());
+  pool.release(large);
+  EXPECT_EQ(freed.count(large), 1ul);
+  EXPECT_EQ(pool.stats().cached_bytes, 65536ul + 4096ul);
+
+  // lowering the budget trims immediately
+  pool.set_budget(4096);
+  EXPECT_EQ(freed.count(medium), 1ul);
+  EXPECT_EQ(pool.stats().cached_bytes, 4096ul);
+  EXPECT_EQ(pool.get_budget(), 4096ul);
+}
+
+TEST_F(SizeClassPoolTest, trim)
+{
+  void *small = pool.allocate(4096, backing);
+  void *medium = pool.allocate(65536, backing);
+  pool.release(small);
+  pool.release(medium);
+
+  // a miss does not release any cached block
+  void *large = pool.allocate(1 << 20, backing);
+  EXPECT_TRUE(freed.empty());
+  pool.release(large);
+
+  // trimming releases the largest blocks first
+  EXPECT_EQ(pool.trim(1), 1ul << 20);
+  EXPECT_EQ(freed.count(large), 1ul);
+  EXPECT_EQ(pool.trim(), 65536ul + 4096ul);
+  EXPECT_EQ(freed.count(medium), 1ul);
+  EXPECT_EQ(freed.count(small), 1ul);
+
+  auto stats = pool.stats();
+  EXPECT_EQ(stats.cached_blocks, 0ul);
+  EXPECT_EQ(stats.cached_bytes, 0ul);
+  EXPECT_EQ(stats.peak_cached_bytes, (1ul << 20) + 65536ul + 4096ul);
+}
+
+TEST_F(SizeClassPoolTest, backing_failure)
+{
+  void *a = pool.allocate(4096, backing);
+  pool.release(a);
+
+  // a backing allocation that fails while blocks are cached trims the cache and is retried
+  int n_call = 0;
+  auto failing = [&](size_t bytes) { return n_call++ == 0 ? nullptr : malloc(bytes); };
+  void *b = pool.allocate(1 << 20, failing);
+  EXPECT_NE(b, nullptr);
+  EXPECT_EQ(n_call, 2);
+  EXPECT_EQ(freed.count(a), 1ul);
+  pool.release(b);
+
+  // with nothing left to trim the failure is returned
+  pool.trim();
+  n_call = 0;
+  auto failed = [&](size_t) -> void * {
+    n_call++;
+    return nullptr;
+  };
+  EXPECT_EQ(pool.allocate(1 << 20, failed), nullptr);
+  EXPECT_EQ(n_call, 1);
+}
+
+TEST(host_memory_pool, safe_malloc)
+{
+  char *enable_host_pool = getenv("QUDA_ENABLE_HOST_MEMORY_POOL");
+  if (enable_host_pool && strcmp(enable_host_pool, "0") == 0) GTEST_SKIP();
+
+  // large host allocations are served from the host pool and reused once freed
+  const size_t bytes = 3 << 20;
+  void *a = safe_malloc(bytes);
+  host_free(a);
+  void *b = safe_malloc(bytes);
+  EXPECT_EQ(a, b);
+  host_free(b);
+  pool::flush_host();
+}
+
+int main(int argc, char **argv)
+{
+  quda_test test("size_class_pool_test", argc, argv);
+  test.init();
+  return test.execute();
+}
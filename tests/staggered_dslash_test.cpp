@@ -59,6 +59,47 @@ TEST_F(StaggeredDslashTest, verify)
   ASSERT_LE(deviation, tol) << "reference and QUDA implementations do not agree";
 }
 
+TEST_F(StaggeredDslashTest, host_reference)
+{
+  // compares the fast host staggered operator against the original reference implementation, and times both
+  if (dtest_type != dslash_test_type::Dslash && dtest_type != dslash_test_type::MatPC) GTEST_SKIP();
+
+  auto &spinor = dslash_test_wrapper.spinor;
+  auto &fat = dslash_test_wrapper.cpuFat;
+  auto &lng = dslash_test_wrapper.cpuLong;
+  const QudaParity parity = dslash_test_wrapper.parity;
+  ColorSpinorField ref {ColorSpinorParam(spinor)};
+  ColorSpinorField fast {ColorSpinorParam(spinor)};
+
+  auto apply = [&](ColorSpinorField &out, bool naive) {
+    if (dtest_type == dslash_test_type::Dslash)
+      naive ? stag_dslash_naive(out, fat, lng, spinor, parity, dagger, dslash_type) :
+              stag_dslash(out, fat, lng, spinor, parity, dagger, dslash_type);
+    else
+      naive ? stag_matpc_naive(out, fat, lng, spinor, mass, 0, parity, dslash_type) :
+              stag_matpc(out, fat, lng, spinor, mass, 0, parity, dslash_type);
+  };
+
+  host_timer_t timer;
+  timer.start();
+  apply(ref, true);
+  timer.stop();
+  double naive_time = timer.last();
+
+  timer.start();
+  for (int i = 0; i < niter; i++) apply(fast, false);
+  timer.stop();
+  double fast_time = timer.last() / niter;
+
+  comm_allreduce_max(naive_time);
+  comm_allreduce_max(fast_time);
+  printfQuda("Host %s %s: reference %.3f s, fast %.3f s, speedup %.1fx\n", get_dslash_str(dslash_type),
+             get_string(dtest_type_map, dtest_type).c_str(), naive_time, fast_time, naive_time / fast_time);
+
+  double deviation = pow(10, -(double)(ColorSpinorField::Compare(ref, fast)));
+  ASSERT_LE(deviation, getTolerance(spinor.Precision())) << "Fast and reference host staggered operators do not agree";
+}
+
 int main(int argc, char **argv)
 {
   // initalize google test
@@ -1,7 +1,11 @@
 #include <chrono>
 #include <thread>
 #include <atomic>
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
 #include <tune_quda.h>
+#include <timer.h>
 #include <test.h>
 
 /*
@@ -68,8 +72,219 @@ TEST_P(TuneRankTest, verify)
 
 INSTANTIATE_TEST_SUITE_P(TuneTest, TuneRankTest, ::testing::Values(0, 1, 2, 3));
 
+/*
+   Microbenchmark of the cached path of tuneLaunch.  We measure the
+   number of launches per second of an already tuned kernel, where
+   the key is constructed and looked up on each launch.
+ */
+struct TuneLaunchBenchmark : public Tunable {
+  TuneLaunchBenchmark()
+  {
+    strcpy(vol, "1x1x1x1");
+    strcpy(aux, "default");
+  }
+
+  bool advanceTuneParam(TuneParam &) const override { return false; }
+  TuneKey tuneKey() const override { return TuneKey(vol, typeid(*this).name(), aux); }
+  void apply(const qudaStream_t &) override { tuneLaunch(*this, getTuning(), QUDA_SILENT); }
+};
+
+TEST(TuneLaunchTest, benchmark)
+{
+  constexpr int n_launch = 1000000;
+  TuneLaunchBenchmark tunable;
+  tunable.apply(device::get_default_stream()); // ensure the kernel is tuned
+
+  host_timer_t timer;
+  timer.start();
+  for (int i = 0; i < n_launch; i++) tunable.apply(device::get_default_stream());
+  timer.stop();
+
+  double rate = n_launch / timer.last();
+  printfQuda("tuneLaunch: %.3e launches / second\n", rate);
+  RecordProperty("launch_rate", std::to_string(rate));
+}
+
+/*
+   Check that converting a text tunecache to the binary format and
+   back again is lossless.  The header timestamp is excluded from the
+   comparison.
+ */
+TEST(TuneCacheTest, convert)
+{
+  if (comm_rank() != 0) return;
+
+  const std::string in_path = "tune_test_cache_in.tsv";
+  const std::string ref_path = "tune_test_cache_ref.tsv";
+  const std::string bin_path = "tune_test_cache.bin";
+  const std::string out_path = "tune_test_cache_out.tsv";
+
+  {
+    std::ofstream in(in_path);
+    in << "tunecache\tver\tgitver\thash\t# Last updated Thu Jan  1 00:00:00 2026\n\n";
+    in << "volume\tname\taux\tblock.x\tblock.y\tblock.z\tgrid.x\tgrid.y\tgrid.z\tshared_bytes\taux.x\taux.y\taux.z\taux."
+          "w\ttime\tcomment\n";
+    in << "16x16x16x16\tN4quda6KernelE\tvol=65536,prec=4\t128\t1\t1\t512\t1\t1\t0\t1\t2\t3\t4\t1e-05\t# 1.2 Gflop/s\n";
+    in << "8x8x8x8\tN4quda5OtherE\tvol=4096\t64\t2\t1\t64\t4\t1\t1024\t-1\t0\t0\t0\t2.5e-06\t# 0.5 Gflop/s\n";
+  }
+
+  // normalize the formatting of the input before the round trip
+  convertTuneCache(in_path, ref_path);
+  convertTuneCache(ref_path, bin_path);
+  convertTuneCache(bin_path, out_path);
+
+  auto read = [](const std::string &path, std::string &header) {
+    std::ifstream file(path);
+    getline(file, header);
+    std::stringstream body;
+    body << file.rdbuf();
+    header = header.substr(0, header.find("\t#"));
+    return body.str();
+  };
+
+  std::string ref_header, out_header;
+  std::string ref_body = read(ref_path, ref_header);
+  std::string out_body = read(out_path, out_header);
+
+  EXPECT_EQ(ref_header, "tunecache\tver\tgitver\thash");
+  EXPECT_EQ(out_header, ref_header);
+  EXPECT_NE(ref_body.find("N4quda5OtherE"), std::string::npos);
+  EXPECT_EQ(out_body, ref_body);
+
+  for (auto &path : {in_path, ref_path, bin_path, out_path}) remove(path.c_str());
+}
+
+/*
+   Kernel that does nothing, with a distinct key for each index, used
+   to add entries to the tunecache.  Tuning runs on the last rank, so
+   that with more than one rank the entries reach process 0 through
+   the broadcast of the tunecache.
+ */
+struct TuneCacheEntry : public Tunable {
+  TuneCacheEntry(int i)
+  {
+    strcpy(vol, "1x1x1x1");
+    strcpy(aux, ("entry=" + std::to_string(i)).c_str());
+  }
+
+  bool advanceTuneParam(TuneParam &) const override { return false; }
+  TuneKey tuneKey() const override { return TuneKey(vol, typeid(*this).name(), aux); }
+  int32_t getTuneRank() const override { return comm_size() - 1; }
+  void apply(const qudaStream_t &) override { tuneLaunch(*this, getTuning(), QUDA_SILENT); }
+};
+
+static const std::string resource_path = "tune_test_resource";
+static const std::string binary_cache_path = resource_path + "/tunecache.bin";
+
+static void tuneEntry(int i) { TuneCacheEntry(i).apply(device::get_default_stream()); }
+
+static size_t fileSize(const std::string &path)
+{
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  return file ? static_cast<size_t>(file.tellg()) : 0;
+}
+
+static bool skipBinaryTuneCache()
+{
+  char *binary = getenv("QUDA_TUNE_CACHE_BINARY");
+  return getTuning() == QUDA_TUNE_NO || (binary && strcmp(binary, "0") == 0);
+}
+
+/*
+   Check that saving the binary tunecache appends exactly the entries
+   tuned since the last save, and nothing when no entry was tuned.
+ */
+TEST(TuneCacheTest, append)
+{
+  if (skipBinaryTuneCache()) GTEST_SKIP();
+
+  tuneEntry(0);
+  saveTuneCache();
+  const size_t size0 = fileSize(binary_cache_path);
+
+  tuneEntry(1);
+  saveTuneCache();
+  const size_t size1 = fileSize(binary_cache_path);
+
+  tuneEntry(2);
+  tuneEntry(3);
+  saveTuneCache();
+  const size_t size2 = fileSize(binary_cache_path);
+
+  saveTuneCache();
+  const size_t size3 = fileSize(binary_cache_path);
+
+  if (comm_rank() != 0) return;
+
+  const size_t record = size1 - size0;
+  EXPECT_GT(size1, size0);
+  EXPECT_EQ(size2 - size1, 2 * record);
+  EXPECT_EQ(size3, size2);
+
+  const std::string text_path = "tune_test_append.tsv";
+  convertTuneCache(binary_cache_path, text_path);
+  std::stringstream body;
+  body << std::ifstream(text_path).rdbuf();
+  for (int i = 0; i < 4; i++) EXPECT_NE(body.str().find("entry=" + std::to_string(i) + "\t"), std::string::npos);
+  remove(text_path.c_str());
+}
+
+/*
+   Check that saving the binary tunecache compacts the file when it
+   holds more than twice as many records as the tunecache has entries,
+   here by duplicating the last record, and that the compacted file
+   holds every entry exactly once.
+ */
+TEST(TuneCacheTest, compact)
+{
+  if (skipBinaryTuneCache()) GTEST_SKIP();
+
+  tuneEntry(100);
+  saveTuneCache();
+  const size_t size0 = fileSize(binary_cache_path);
+
+  tuneEntry(101);
+  saveTuneCache();
+  const size_t size1 = fileSize(binary_cache_path);
+  const size_t record = size1 - size0;
+  ASSERT_GT(record, 0ul);
+
+  if (comm_rank() == 0) {
+    // the file holds fewer than size1 / record records, so this many copies exceed the compaction ratio
+    std::string last(record, '\0');
+    std::ifstream in(binary_cache_path, std::ios::binary);
+    in.seekg(size1 - record);
+    in.read(&last[0], record);
+    in.close();
+    std::ofstream out(binary_cache_path, std::ios::binary | std::ios::app);
+    for (size_t i = 0; i < size1 / record + 2; i++) out << last;
+  }
+
+  tuneEntry(102);
+  saveTuneCache();
+  const size_t size2 = fileSize(binary_cache_path);
+
+  if (comm_rank() != 0) return;
+
+  EXPECT_EQ(size2, size1 + record);
+
+  const std::string text_path = "tune_test_compact.tsv";
+  convertTuneCache(binary_cache_path, text_path);
+  std::stringstream body;
+  body << std::ifstream(text_path).rdbuf();
+  for (int i = 100; i < 103; i++) EXPECT_NE(body.str().find("entry=" + std::to_string(i) + "\t"), std::string::npos);
+  remove(text_path.c_str());
+}
+
 int main(int argc, char **argv)
 {
+  // the tunecache tests save the binary tunecache, so use a scratch resource path that starts empty
+  mkdir(resource_path.c_str(), 0755);
+  remove(binary_cache_path.c_str());
+  remove((resource_path + "/tunecache.tsv").c_str());
+  setenv("QUDA_RESOURCE_PATH", resource_path.c_str(), 1);
+  setenv("QUDA_TUNE_CACHE_BINARY", "1", 0);
+
   quda_test test("tune_rank_test", argc, argv);
   test.init();
   return test.execute();
@@ -341,7 +341,8 @@ bool is_hermitian_solver(QudaInverterType type)
 {
   switch (type) {
   case QUDA_CG_INVERTER:
-  case QUDA_CA_CG_INVERTER: return true;
+  case QUDA_CA_CG_INVERTER:
+  case QUDA_PIPE_CG_INVERTER: return true;
   default: return false;
   }
 }
@@ -298,6 +298,7 @@ const char *get_solver_str(QudaInverterType type)
   case QUDA_CA_CGNE_INVERTER: ret = "ca_cgne"; break;
   case QUDA_CA_CGNR_INVERTER: ret = "ca_cgnr"; break;
   case QUDA_CA_GCR_INVERTER: ret = "ca_gcr"; break;
+  case QUDA_PIPE_CG_INVERTER: ret = "pipe_cg"; break;
   default:
     ret = "unknown";
     errorQuda("Error: invalid solver type %d\n", type);